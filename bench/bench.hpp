@@ -0,0 +1,51 @@
+// ======================= bench.hpp =======================
+// 简易基准框架：每个 bench/*.cpp 用 BENCH(name) 注册一个用例，
+// mq_bench 不带参数运行全部，带参数只运行名字匹配的用例。
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace hz_mq::bench {
+
+using bench_fn = std::function<void()>;
+
+inline std::map<std::string, bench_fn>& registry()
+{
+    static std::map<std::string, bench_fn> r;
+    return r;
+}
+
+struct registrar {
+    registrar(const std::string& name, bench_fn fn) { registry().emplace(name, std::move(fn)); }
+};
+
+// 以纳秒计时
+template <typename F>
+inline double time_ns(F&& f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// 环境变量 MQ_BENCH_MAX 可调小规模上限（默认按用例自身设定）
+inline size_t max_scale(size_t fallback)
+{
+    const char* v = std::getenv("MQ_BENCH_MAX");
+    return v ? std::strtoull(v, nullptr, 10) : fallback;
+}
+
+}
+
+#define BENCH_CAT_(a, b) a##b
+#define BENCH_CAT(a, b)  BENCH_CAT_(a, b)
+#define BENCH(name)                                                              \
+    static void BENCH_CAT(bench_, name)();                                       \
+    static ::hz_mq::bench::registrar BENCH_CAT(bench_reg_, name)(#name,          \
+                                                   &BENCH_CAT(bench_, name));    \
+    static void BENCH_CAT(bench_, name)()
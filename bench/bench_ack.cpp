@@ -0,0 +1,100 @@
+// ======================= bench_ack.cpp =======================
+// 按 id 确认（queue_message::remove）的单次开销随队列深度的变化（1k ~ 10M 条积压）。
+//   random : 从前半段随机挑 id 确认，每次都落在冷的槽位 / 索引节点上
+//   seq    : 从中间开始按入队顺序确认连续的一段，槽位访问是顺序的（索引桶仍随机）
+//   miss   : 同样大小（上限 1 GiB）内存上做依赖的随机指针追逐，单次访存延迟，作缓存对照
+//   rss    : 建好队列后的常驻内存，对照 L2 / LLC 大小看工作集何时放不进缓存
+// 扫描式实现每档深度会涨 10 倍；按索引确认时的增长应与 miss 列同步，来自缓存 / TLB 缺失。
+// 默认跑到 10M（约需 4 GiB 内存），MQ_BENCH_MAX 可调小。
+#include "bench.hpp"
+#include "../src/server/queue_message.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace hz_mq;
+
+static double rss_mib()
+{
+    long pages = 0, resident = 0;
+    if (FILE* f = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        std::fclose(f);
+    }
+    return static_cast<double>(resident) * static_cast<double>(::sysconf(_SC_PAGESIZE)) / (1 << 20);
+}
+
+// bytes 大小的缓冲里按随机顺序串起所有缓存行（单个环），返回每跳的平均纳秒
+static double chase_ns(size_t bytes)
+{
+    constexpr size_t LINE = 64 / sizeof(uint64_t);
+    size_t lines = std::max<size_t>(bytes / 64, 2);
+    std::vector<uint32_t> order(lines);
+    std::iota(order.begin(), order.end(), 0u);
+    std::shuffle(order.begin() + 1, order.end(), std::mt19937_64(lines));
+
+    std::vector<uint64_t> buf(lines * LINE);
+    for (size_t i = 0; i < lines; ++i) buf[order[i] * LINE] = order[(i + 1) % lines] * LINE;
+
+    const size_t hops = 1u << 20;
+    volatile uint64_t sink;
+    uint64_t p = 0;
+    double ns = bench::time_ns([&] {
+        for (size_t i = 0; i < hops; ++i) p = buf[p];
+    });
+    sink = p;
+    (void)sink;
+    return ns / static_cast<double>(hops);
+}
+
+BENCH(ack_by_id)
+{
+    const size_t max_depth = bench::max_scale(10000000);
+    const size_t acks      = 10000;
+
+    long l2 = ::sysconf(_SC_LEVEL2_CACHE_SIZE), llc = ::sysconf(_SC_LEVEL3_CACHE_SIZE);
+    std::printf("L2: %.1f MiB  LLC: %.0f MiB\n", static_cast<double>(std::max(l2, 0L)) / (1 << 20),
+                static_cast<double>(std::max(llc, 0L)) / (1 << 20));
+    std::printf("%12s %8s %14s %14s %10s %10s\n", "depth", "acks", "random ns/ack", "seq ns/ack",
+                "miss ns", "rss MiB");
+    const size_t bytes_per_msg = 320;                 // 实测 1M 条积压常驻约 300 MiB
+    for (size_t depth = 1000; depth <= max_depth; depth *= 10) {
+        // 先测访存延迟再建队列，两者不同时占内存
+        double miss = chase_ns(std::min(depth * bytes_per_msg, size_t{1} << 30));
+
+        queue_message qm("./bench_data", "ack");      // 非持久化：不落盘
+        auto id_of = [](size_t i) { return "m" + std::to_string(i); };
+
+        BasicProperties bp;
+        for (size_t i = 0; i < depth; ++i) {
+            bp.set_id(id_of(i));
+            qm.insert(&bp, "x", false);
+        }
+        double rss = rss_mib();
+        size_t n   = std::min(acks, depth / 4);
+
+        // 要确认的 id 先生成好，计时只含 remove：中间一段按入队顺序，
+        // 另从前半段随机挑选 n 个不重复位置，覆盖队首到中间
+        std::vector<std::string> seq_ids, rnd_ids;
+        for (size_t i = 0; i < n; ++i) seq_ids.push_back(id_of(depth / 2 + i));
+        std::vector<uint32_t> pos(depth / 2);
+        for (size_t i = 0; i < pos.size(); ++i) pos[i] = static_cast<uint32_t>(i);
+        std::mt19937_64 rng(depth);
+        std::shuffle(pos.begin(), pos.end(), rng);
+        for (size_t i = 0; i < n; ++i) rnd_ids.push_back(id_of(pos[i]));
+
+        double seq = bench::time_ns([&] {
+            for (const auto& id : seq_ids) qm.remove(id);
+        });
+        double rnd = bench::time_ns([&] {
+            for (const auto& id : rnd_ids) qm.remove(id);
+        });
+
+        std::printf("%12zu %8zu %14.1f %14.1f %10.1f %10.0f\n", depth, n,
+                    rnd / static_cast<double>(n), seq / static_cast<double>(n), miss, rss);
+    }
+}
@@ -0,0 +1,150 @@
+// ======================= bench_alloc.cpp =======================
+// 投递热路径每条消息的堆分配次数（替换全局 operator new 计数，只统计被测区间）。
+//   deliver heap  : basic_get 返回 message_ptr（make_shared<Message> + 属性交换），之后确认
+//   deliver arena : basic_get 填进栈上初始块 Arena 里的 Message（channel::deliver 的做法）
+//   consume ...   : 自动确认路径，同上两种
+//   frame heap    : 投递帧头部是普通的栈对象，properties 子消息与字段各自堆分配
+//   frame arena   : 头部分配在栈上初始块的 Arena 里（channel::consume_cb 的做法）
+// 帧都编码进新建的 Buffer，与 consume_cb 一致；Buffer 自身的分配两种方式相同。
+#include "bench.hpp"
+#include "../src/server/virtual_host.hpp"
+#include "../src/server/consume_frame.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <new>
+
+#include <google/protobuf/arena.h>
+#include <muduo/net/Buffer.h>
+
+// 下面的 operator new / delete 都走 malloc / free，内联后 gcc 误报不匹配
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+using namespace hz_mq;
+
+static bool   g_counting = false;
+static size_t g_allocs   = 0;
+
+void* operator new(size_t n)
+{
+    if (g_counting) ++g_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t n) { return ::operator new(n); }
+void  operator delete(void* p) noexcept { std::free(p); }
+void  operator delete[](void* p) noexcept { std::free(p); }
+void  operator delete(void* p, size_t) noexcept { std::free(p); }
+void  operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+// 每次调用 f 的平均分配次数
+template <typename F>
+static double allocs_per_op(size_t ops, F&& f)
+{
+    g_allocs   = 0;
+    g_counting = true;
+    for (size_t i = 0; i < ops; ++i) f();
+    g_counting = false;
+    return static_cast<double>(g_allocs) / static_cast<double>(ops);
+}
+
+static constexpr size_t ARENA_BYTES = 1024;
+
+static google::protobuf::ArenaOptions stack_arena(char* block, size_t size)
+{
+    google::protobuf::ArenaOptions opts;
+    opts.initial_block      = block;
+    opts.initial_block_size = size;
+    return opts;
+}
+
+// 与 channel::consume_cb 相同的头部字段
+static void fill_head(basicConsumeResponse* head, const BasicProperties& bp, uint64_t tag)
+{
+    static const std::string cid = "bench-channel-0001", consumer = "bench-consumer-0001";
+    head->set_cid(cid);
+    head->set_consumer_tag(consumer);
+    head->set_delivery_tag(tag);
+    auto* props = head->mutable_properties();
+    props->set_id(bp.id());
+    props->set_delivery_mode(bp.delivery_mode());
+    props->set_routing_key(bp.routing_key());
+    props->set_content_encoding(ContentEncoding::IDENTITY);
+}
+
+BENCH(alloc_counts)
+{
+    const size_t ops      = bench::max_scale(20000);
+    const std::string dir = "./bench_data";
+    const std::string body(512, 'a');
+
+    std::filesystem::remove_all(dir);
+    auto vh = std::make_shared<virtual_host>("bench", dir, dir + "/meta.db");
+    vh->declare_queue("alloc", false, false, false, {});
+    auto fill = [&] {
+        for (size_t i = 0; i < ops; ++i) {
+            BasicProperties bp;                        // 不带 id：由队列生成，与线上默认一致
+            bp.set_routing_key("alloc");
+            vh->basic_publish("alloc", &bp, body);
+        }
+    };
+
+    std::printf("%16s %14s\n", "path", "allocs/msg");
+
+    fill();
+    double d_heap = allocs_per_op(ops, [&] {
+        uint64_t inflight = 0;
+        auto m = vh->basic_get("alloc", inflight);
+        vh->basic_ack_inflight("alloc", inflight);
+    });
+    std::printf("%16s %14.2f\n", "deliver heap", d_heap);
+
+    fill();
+    double d_arena = allocs_per_op(ops, [&] {
+        alignas(8) char block[ARENA_BYTES];
+        google::protobuf::Arena arena(stack_arena(block, sizeof block));
+        auto* m = google::protobuf::Arena::CreateMessage<Message>(&arena);
+        uint64_t inflight = 0;
+        vh->basic_get("alloc", inflight, *m);
+        vh->basic_ack_inflight("alloc", inflight);
+    });
+    std::printf("%16s %14.2f\n", "deliver arena", d_arena);
+
+    fill();
+    double c_heap = allocs_per_op(ops, [&] { auto m = vh->basic_consume("alloc"); });
+    std::printf("%16s %14.2f\n", "consume heap", c_heap);
+
+    fill();
+    double c_arena = allocs_per_op(ops, [&] {
+        alignas(8) char block[ARENA_BYTES];
+        google::protobuf::Arena arena(stack_arena(block, sizeof block));
+        auto* m = google::protobuf::Arena::CreateMessage<Message>(&arena);
+        vh->basic_consume("alloc", *m);
+    });
+    std::printf("%16s %14.2f\n", "consume arena", c_arena);
+
+    BasicProperties bp;
+    bp.set_id("2f1c8a4e-7b3d-4e90-a6c1-5d2b9f0e8a17");
+    bp.set_routing_key("alloc");
+    uint64_t tag = 0;
+    double f_heap = allocs_per_op(ops, [&] {
+        basicConsumeResponse head;
+        fill_head(&head, bp, ++tag);
+        auto buf = std::make_shared<muduo::net::Buffer>();
+        encode_consume_frame(buf.get(), head, body.data(), body.size());
+    });
+    std::printf("%16s %14.2f\n", "frame heap", f_heap);
+
+    double f_arena = allocs_per_op(ops, [&] {
+        alignas(8) char block[ARENA_BYTES];
+        google::protobuf::Arena arena(stack_arena(block, sizeof block));
+        auto* head = google::protobuf::Arena::CreateMessage<basicConsumeResponse>(&arena);
+        fill_head(head, bp, ++tag);
+        auto buf = std::make_shared<muduo::net::Buffer>();
+        encode_consume_frame(buf.get(), *head, body.data(), body.size());
+    });
+    std::printf("%16s %14.2f\n", "frame arena", f_arena);
+
+    std::filesystem::remove_all(dir);
+}
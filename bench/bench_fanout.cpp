@@ -0,0 +1,66 @@
+// ======================= bench_fanout.cpp =======================
+// 扇出发布的开销：64 KB 消息发到绑定了 N 个队列的 fanout 交换机，积压 msgs 条不消费。
+//   shared : publish_ex，多个目标队列共享一份消息体
+//   copy   : 逐队列 basic_publish，每个队列各拷贝一份（共享之前的做法）
+// 报告每条消息的发布耗时与积压期间常驻内存（RSS）的增量。
+#include "bench.hpp"
+#include "../src/server/virtual_host.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <malloc.h>
+#include <unistd.h>
+
+using namespace hz_mq;
+
+static double rss_mb()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return static_cast<double>(resident) * static_cast<double>(::sysconf(_SC_PAGESIZE)) / (1 << 20);
+}
+
+BENCH(fanout_publish)
+{
+    const size_t max_queues = bench::max_scale(200);
+    const size_t msgs       = 50;
+    const std::string dir   = "./bench_data";
+    const std::string body(64 * 1024, 'f');
+
+    std::printf("%8s %8s %16s %12s\n", "queues", "mode", "publish us/msg", "RSS +MB");
+    for (size_t queues = 1; queues <= max_queues; queues = queues < 10 ? 10 : queues * 20) {
+        for (const char* mode : {"shared", "copy"}) {
+            bool shared = std::string(mode) == "shared";
+            std::filesystem::remove_all(dir);
+            auto vh = std::make_shared<virtual_host>("bench", dir, dir + "/meta.db");
+            vh->declare_exchange("fan", ExchangeType::FANOUT, false, false, {});
+            std::vector<std::string> names;
+            for (size_t q = 0; q < queues; ++q) {
+                names.push_back("fq" + std::to_string(q));
+                vh->declare_queue(names.back(), false, false, false, {});
+                vh->bind("fan", names.back(), "");
+            }
+
+            ::malloc_trim(0);                          // 上一轮释放的内存还给系统，RSS 增量才可比
+            double before = rss_mb();
+            double ns = bench::time_ns([&] {
+                for (size_t i = 0; i < msgs; ++i) {
+                    if (shared) {
+                        vh->publish_ex("fan", "", nullptr, body);
+                        continue;
+                    }
+                    for (const auto& q : names) {
+                        BasicProperties bp;
+                        vh->basic_publish(q, &bp, body);
+                    }
+                }
+            });
+            double grown = rss_mb() - before;
+            std::printf("%8zu %8s %16.1f %12.1f\n", queues, mode,
+                        ns / 1000.0 / static_cast<double>(msgs), grown);
+        }
+    }
+    std::filesystem::remove_all(dir);
+}
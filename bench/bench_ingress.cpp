@@ -0,0 +1,109 @@
+// ======================= bench_ingress.cpp =======================
+// 多个生产者、一个消费者同时进行时的入队吞吐（1 / 4 / 16 / 64 个生产者线程，总条数固定）：
+//   ingress_primitive : mpsc_ring<uint64_t> 对照 std::mutex 保护的 std::deque<uint64_t>，只测容器本身
+//   ingress_queue     : queue_message 开启 x-ingress-ring 对照原来的加锁入队（64 B 非持久化消息），
+//                       消费线程不停 pop_front，计到最后一条出队为止
+// 环满时生产者 yield 重试；机器核数少于线程数时吞吐主要反映调度开销。
+#include "bench.hpp"
+#include "../src/server/mpsc_ring.hpp"
+#include "../src/server/queue_message.hpp"
+
+#include <atomic>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace hz_mq;
+
+static const size_t PRODUCER_COUNTS[] = {1, 4, 16, 64};
+
+// producers 个线程各调用 push(i) per 次，消费线程调用 pop() 直到取回全部，返回耗时
+template <typename Push, typename Pop>
+static double run_mpsc(size_t producers, size_t per, Push push, Pop pop)
+{
+    return bench::time_ns([&] {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < producers; ++t) {
+            workers.emplace_back([&] {
+                for (size_t i = 0; i < per; ++i) push(i);
+            });
+        }
+        size_t got = 0;
+        while (got < producers * per) {
+            size_t n = pop();
+            if (!n) std::this_thread::yield();
+            got += n;
+        }
+        for (auto& w : workers) w.join();
+    });
+}
+
+BENCH(ingress_primitive)
+{
+    const size_t total = bench::max_scale(1u << 22);
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%10s %12s %14s\n", "producers", "mode", "Mops/s");
+    for (size_t producers : PRODUCER_COUNTS) {
+        const size_t per = total / producers;
+
+        mpsc_ring<uint64_t> ring(4096);
+        uint64_t sink = 0;
+        double ns = run_mpsc(producers, per,
+            [&](size_t i) {
+                while (!ring.try_push([&](uint64_t& v) { v = i; })) std::this_thread::yield();
+            },
+            [&] { return ring.drain([&](uint64_t& v) { sink += v; }); });
+        std::printf("%10zu %12s %14.2f\n", producers, "mpsc_ring",
+                    static_cast<double>(per * producers) / ns * 1000.0);
+
+        std::mutex           mtx;
+        std::deque<uint64_t> dq;
+        ns = run_mpsc(producers, per,
+            [&](size_t i) {
+                std::lock_guard<std::mutex> lock(mtx);
+                dq.push_back(i);
+            },
+            [&] {
+                std::lock_guard<std::mutex> lock(mtx);   // 与 drain 对等：一次取走当前全部
+                size_t n = dq.size();
+                for (uint64_t v : dq) sink += v;
+                dq.clear();
+                return n;
+            });
+        std::printf("%10zu %12s %14.2f\n", producers, "mutex+deque",
+                    static_cast<double>(per * producers) / ns * 1000.0);
+        if (sink == 1) std::printf(" ");                 // 防止求和被优化掉
+    }
+}
+
+BENCH(ingress_queue)
+{
+    const size_t total    = bench::max_scale(1u << 20);
+    const std::string dir = "./bench_data";
+    const std::string body(64, 'i');
+
+    std::printf("%10s %12s %14s\n", "producers", "mode", "Mmsg/s");
+    for (size_t producers : PRODUCER_COUNTS) {
+        const size_t per = total / producers;
+        for (const char* mode : {"ingress", "locked"}) {
+            std::filesystem::remove_all(dir);
+            queue_message::args qargs;
+            if (std::string(mode) == "ingress") qargs[INGRESS_RING_ARG] = "4096";
+            queue_message qm(dir, "iq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, qargs);
+
+            Message out;
+            double ns = run_mpsc(producers, per,
+                [&](size_t) {
+                    BasicProperties bp;
+                    qm.insert(&bp, body, false);
+                },
+                [&] { return qm.pop_front(out) ? size_t{1} : size_t{0}; });
+            std::printf("%10zu %12s %14.2f\n", producers, mode,
+                        static_cast<double>(per * producers) / ns * 1000.0);
+        }
+    }
+    std::filesystem::remove_all(dir);
+}
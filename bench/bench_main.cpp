@@ -0,0 +1,14 @@
+// ======================= bench_main.cpp =======================
+#include "bench.hpp"
+
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    for (const auto& [name, fn] : hz_mq::bench::registry()) {
+        if (argc > 1 && std::strstr(name.c_str(), argv[1]) == nullptr) continue;
+        std::printf("==== %s ====\n", name.c_str());
+        fn();
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+// ======================= bench_parallel.cpp =======================
+// 多线程同时发布（非持久化，64 B 消息体）的总吞吐：
+//   distinct : 每个线程发往自己的队列——只共享拓扑读锁，应随线程数近似线性增长
+//   shared   : 所有线程发往同一个队列——受该队列的锁限制，作为对照
+// 每个线程发 msgs 条后再逐条取回，只计发布阶段。加速比以单线程为基准；
+// 机器核数少于线程数时加速比自然封顶在核数。
+#include "bench.hpp"
+#include "../src/server/virtual_host.hpp"
+
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace hz_mq;
+
+BENCH(parallel_publish)
+{
+    const size_t max_threads = bench::max_scale(8);
+    const size_t msgs        = 200000;
+    const std::string dir    = "./bench_data";
+    const std::string body(64, 'p');
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %8s %14s %10s\n", "threads", "mode", "Mmsg/s total", "speedup");
+    for (const char* mode : {"distinct", "shared"}) {
+        bool   distinct = std::string(mode) == "distinct";
+        double base     = 0;
+        for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+            std::filesystem::remove_all(dir);
+            auto vh = std::make_shared<virtual_host>("bench", dir, dir + "/meta.db");
+            for (size_t t = 0; t < threads; ++t)
+                vh->declare_queue("pq" + std::to_string(t), false, false, false, {});
+
+            double ns = bench::time_ns([&] {
+                std::vector<std::thread> workers;
+                for (size_t t = 0; t < threads; ++t) {
+                    workers.emplace_back([&, t] {
+                        const std::string q = "pq" + std::to_string(distinct ? t : 0);
+                        for (size_t i = 0; i < msgs; ++i) {
+                            BasicProperties bp;
+                            vh->basic_publish(q, &bp, body);
+                        }
+                    });
+                }
+                for (auto& w : workers) w.join();
+            });
+            for (size_t t = 0; t < threads; ++t)
+                while (vh->basic_consume("pq" + std::to_string(t))) {}
+
+            double rate = static_cast<double>(msgs * threads) / ns * 1000.0;   // 百万条 / 秒
+            if (threads == 1) base = rate;
+            std::printf("%8zu %8s %14.2f %9.2fx\n", threads, mode, rate, rate / base);
+        }
+    }
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,140 @@
+// ======================= bench_queue.cpp =======================
+// 内存队列（非持久化）每条消息的入队 / 出队开销。
+//   fill      : 空队列连续入队 depth 条
+//   drain     : 再逐条 pop_front 取空
+//   steady    : 保持 depth 条积压，一进一出（槽位复用后的稳态）
+// 每个深度重复 5 轮取最小值，减小分配器预热与机器抖动的影响。
+// priority_ops 比较普通 FIFO 与 x-max-priority 队列在同样积压下的一进一出开销。
+// overflow_ops 比较不设上限、设了上限但未触发、以及 drop-head 每条都挤出一条时的入队开销。
+#include "bench.hpp"
+#include "../src/server/queue_message.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace hz_mq;
+
+BENCH(queue_ops)
+{
+    const size_t max_depth = bench::max_scale(1000000);
+    const size_t steady    = 200000;
+    const std::string body(64, 'q');
+    const int         rounds = 5;
+
+    std::printf("%12s %14s %14s %14s\n", "depth", "fill ns/msg", "drain ns/msg", "steady ns/op");
+    for (size_t depth = 1000; depth <= max_depth; depth *= 10) {
+        queue_message qm("./bench_data", "ring");      // 非持久化：不落盘
+        BasicProperties bp;                            // 不带 id：由队列生成，与线上默认一致
+        bp.set_routing_key("ring");
+        auto fill_queue = [&] {
+            for (size_t i = 0; i < depth; ++i) qm.insert(&bp, body, false);
+        };
+
+        double fill = 1e300, drain = 1e300, ops = 1e300;
+        for (int r = 0; r < rounds; ++r) {
+            fill  = std::min(fill, bench::time_ns(fill_queue));
+            drain = std::min(drain, bench::time_ns([&] {
+                for (size_t i = 0; i < depth; ++i) qm.pop_front();
+            }));
+        }
+
+        fill_queue();
+        for (int r = 0; r < rounds; ++r) {
+            ops = std::min(ops, bench::time_ns([&] {
+                for (size_t i = 0; i < steady; ++i) {
+                    qm.insert(&bp, body, false);
+                    qm.pop_front();
+                }
+            }));
+        }
+
+        auto d = static_cast<double>(depth);
+        std::printf("%12zu %14.1f %14.1f %14.1f\n", depth, fill / d, drain / d,
+                    ops / static_cast<double>(steady));
+    }
+}
+
+// 稳态一进一出：fifo 为普通队列；prio-1 为 x-max-priority=10 但消息都不带优先级；
+// prio-10 / prio-255 的优先级在 0..max 间均匀随机
+BENCH(priority_ops)
+{
+    const size_t max_depth = bench::max_scale(100000);
+    const size_t ops       = 200000;
+    const std::string body(64, 'q');
+    const int         rounds = 5;
+
+    struct variant { const char* name; const char* max_priority; uint32_t spread; };
+    const variant variants[] = {
+        {"fifo", nullptr, 1}, {"prio-1", "10", 1}, {"prio-10", "10", 11}, {"prio-255", "255", 256},
+    };
+
+    std::printf("%12s %10s %14s\n", "depth", "queue", "steady ns/op");
+    for (size_t depth = 1000; depth <= max_depth; depth *= 10) {
+        for (const auto& v : variants) {
+            queue_message::args qargs;
+            if (v.max_priority) qargs[MAX_PRIORITY_ARG] = v.max_priority;
+            queue_message qm("./bench_data", "prio", nullptr,
+                             segment_log::DEFAULT_SEGMENT_BYTES, qargs);
+
+            std::mt19937 rng(42);
+            std::vector<BasicProperties> props(1024);     // 预先生成，计时里不含随机数与属性构造
+            for (auto& bp : props) {
+                bp.set_routing_key("prio");
+                bp.set_priority(rng() % v.spread);
+            }
+            for (size_t i = 0; i < depth; ++i) qm.insert(&props[i % props.size()], body, false);
+
+            double best = 1e300;
+            for (int r = 0; r < rounds; ++r) {
+                best = std::min(best, bench::time_ns([&] {
+                    for (size_t i = 0; i < ops; ++i) {
+                        qm.insert(&props[i % props.size()], body, false);
+                        qm.pop_front();
+                    }
+                }));
+            }
+            std::printf("%12zu %10s %14.1f\n", depth, v.name, best / static_cast<double>(ops));
+        }
+    }
+}
+
+// unlimited：无上限；headroom：x-max-length / x-max-length-bytes 远大于积压（只做比较）；
+// drop-head：x-max-length = depth，积压已满，每次入队挤出一条（不出队）
+BENCH(overflow_ops)
+{
+    const size_t max_depth = bench::max_scale(100000);
+    const size_t ops       = 200000;
+    const std::string body(64, 'q');
+    const int         rounds = 5;
+
+    std::printf("%12s %10s %14s\n", "depth", "queue", "steady ns/op");
+    for (size_t depth = 1000; depth <= max_depth; depth *= 10) {
+        for (const char* name : {"unlimited", "headroom", "drop-head"}) {
+            queue_message::args qargs;
+            bool drop = std::string(name) == "drop-head";
+            if (std::string(name) == "headroom") {
+                qargs[MAX_LENGTH_ARG]       = std::to_string(depth * 100);
+                qargs[MAX_LENGTH_BYTES_ARG] = std::to_string(depth * 100 * body.size());
+            } else if (drop) {
+                qargs[MAX_LENGTH_ARG] = std::to_string(depth);
+            }
+            queue_message qm("./bench_data", "ovf", nullptr,
+                             segment_log::DEFAULT_SEGMENT_BYTES, qargs);
+            BasicProperties bp;
+            bp.set_routing_key("ovf");
+            for (size_t i = 0; i < depth; ++i) qm.insert(&bp, body, false);
+
+            double best = 1e300;
+            for (int r = 0; r < rounds; ++r) {
+                best = std::min(best, bench::time_ns([&] {
+                    for (size_t i = 0; i < ops; ++i) {
+                        qm.insert(&bp, body, false);
+                        if (!drop) qm.pop_front();
+                    }
+                }));
+            }
+            std::printf("%12zu %10s %14.1f\n", depth, name, best / static_cast<double>(ops));
+        }
+    }
+}
@@ -0,0 +1,44 @@
+// ======================= bench_recovery.cpp =======================
+// 重启恢复耗时：全量扫描段文件 vs 从检查点恢复（lazy 队列，90% 已确认）。
+#include "bench.hpp"
+#include "../src/server/queue_message.hpp"
+
+#include <filesystem>
+
+using namespace hz_mq;
+
+BENCH(recovery)
+{
+    const size_t max_depth = bench::max_scale(1000000);
+    const std::string dir  = "./bench_data";
+    const queue_message::args lazy{{QUEUE_MODE_ARG, QUEUE_MODE_LAZY}};
+
+    std::printf("%12s %16s %16s\n", "messages", "full scan ms", "checkpoint ms");
+    for (size_t depth = 10000; depth <= max_depth; depth *= 10) {
+        std::filesystem::remove_all(dir);
+        {
+            queue_message qm(dir, "rq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, lazy);
+            BasicProperties bp;
+            bp.set_delivery_mode(DeliveryMode::DURABLE);
+            std::string body(256, 'r');
+            for (size_t i = 0; i < depth; ++i) {
+                bp.set_id("r" + std::to_string(i));
+                qm.insert(&bp, body, true);
+            }
+            for (size_t i = 0; i < depth / 10 * 9; ++i) qm.remove("");
+            qm.checkpoint();
+        }
+
+        double with_cp = bench::time_ns([&] {
+            queue_message qm(dir, "rq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, lazy);
+            qm.recovery();
+        });
+        std::filesystem::remove(dir + "/rq/checkpoint");
+        double full = bench::time_ns([&] {
+            queue_message qm(dir, "rq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, lazy);
+            qm.recovery();
+        });
+        std::printf("%12zu %16.1f %16.1f\n", depth, full / 1e6, with_cp / 1e6);
+    }
+    std::filesystem::remove_all(dir);
+}
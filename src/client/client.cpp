@@ -11,6 +11,7 @@
 #include "muduo/protoc/dispatcher.h"
 #include "../common/protocol.pb.h"
 #include "../common/msg.pb.h"
+#include "../common/compress.hpp"
 
 using namespace hz_mq;
 using muduo::net::TcpConnectionPtr;
@@ -37,8 +38,13 @@ void onCommonResponse(const TcpConnectionPtr&, const std::shared_ptr<basicCommon
     std::cout << "[Response] (cid=" << message->cid() << ") OK=" << (message->ok() ? "true" : "false") << std::endl;
 }
 void onConsumeResponse(const TcpConnectionPtr&, const std::shared_ptr<basicConsumeResponse>& message, muduo::Timestamp) {
+    std::string body = message->body();
+    if (message->properties().content_encoding() == ContentEncoding::ZLIB) {
+        std::string plain;
+        if (zlib_decompress(body, plain)) body.swap(plain);
+    }
     std::cout << "[Message Received] consumer_tag=" << message->consumer_tag()
-              << " body=\"" << message->body() << "\"" << std::endl;
+              << " body=\"" << body << "\"" << std::endl;
 }
 void onQueryResponse(const TcpConnectionPtr&, const std::shared_ptr<basicQueryResponse>& message, muduo::Timestamp) {
     std::string body = message->body();
@@ -121,6 +127,7 @@ int main(int argc, char* argv[]) {
             openChannelRequest req;
             req.set_rid("cli-open-" + cid);
             req.set_cid(cid);
+            req.set_compression(true);          // 大消息体以 zlib 收发
             g_codec->send(g_conn, req);
         } else if (cmd == "close") {
             std::string cid;
@@ -173,13 +180,19 @@ int main(int argc, char* argv[]) {
             req.set_rid("cli-pub-" + exch);
             req.set_cid("0");
             req.set_exchange_name(exch);
-            req.set_body(msg);
             // set properties with routing key if provided
             if (!rkey.empty()) {
                 BasicProperties* props = req.mutable_properties();
                 props->set_routing_key(rkey);
                 props->set_delivery_mode(DeliveryMode::UNDURABLE);
             }
+            std::string packed;
+            if (msg.size() >= COMPRESS_MIN_BYTES && zlib_compress(msg, packed)) {
+                req.set_body(std::move(packed));
+                req.mutable_properties()->set_content_encoding(ContentEncoding::ZLIB);
+            } else {
+                req.set_body(msg);
+            }
             g_codec->send(g_conn, req);
         } else if (cmd == "pull") {
             std::string cid;
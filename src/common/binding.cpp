@@ -0,0 +1,40 @@
+// ======================= binding.cpp =======================
+#include "binding.hpp"
+
+namespace hz_mq {
+
+// ---------- binding_mapper ----------
+// 存储格式：key = "交换机名\n队列名"，value = binding_key
+static std::string binding_key_of(const std::string& exchange_name, const std::string& queue_name)
+{
+    return exchange_name + "\n" + queue_name;
+}
+
+binding_mapper::binding_mapper(const std::string& dbfile)
+    : __store(meta_store::open(dbfile))
+{
+}
+
+void binding_mapper::insert(const binding::ptr& bd)
+{
+    __store->put(meta_kind::BINDING,
+                 binding_key_of(bd->exchange_name, bd->queue_name), bd->binding_key);
+}
+
+void binding_mapper::remove(const std::string& exchange_name, const std::string& queue_name)
+{
+    __store->erase(meta_kind::BINDING, binding_key_of(exchange_name, queue_name));
+}
+
+std::vector<binding::ptr> binding_mapper::all()
+{
+    std::vector<binding::ptr> result;
+    for (const auto& [key, value] : __store->all(meta_kind::BINDING)) {
+        size_t sep = key.find('\n');
+        if (sep == std::string::npos) continue;
+        result.push_back(std::make_shared<binding>(key.substr(0, sep), key.substr(sep + 1), value));
+    }
+    return result;
+}
+
+} 
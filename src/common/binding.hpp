@@ -4,6 +4,9 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <vector>
+
+#include "meta_store.hpp"
 
 namespace hz_mq {
 
@@ -24,6 +27,17 @@ struct binding {
 // 对某个交换机来说：队列名 → 绑定信息
 using msg_queue_binding_map = std::unordered_map<std::string, binding::ptr>;
 
-} 
-
+// ---------- 持久化映射层（落到 meta_store：WAL + 快照） ----------
+// 只保存两端都是持久化对象的绑定
+class binding_mapper {
+public:
+    explicit binding_mapper(const std::string& dbfile);
+    void insert(const binding::ptr& bd);
+    void remove(const std::string& exchange_name, const std::string& queue_name);
+    std::vector<binding::ptr> all();
+
+private:
+    meta_store::ptr __store;
+};
 
+} 
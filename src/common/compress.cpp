@@ -0,0 +1,71 @@
+// ======================= compress.cpp =======================
+#include "compress.hpp"
+#include "metrics.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include <zlib.h>
+
+namespace hz_mq {
+
+using std::chrono::steady_clock;
+
+static uint64_t elapsed_us(steady_clock::time_point t0)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - t0).count();
+}
+
+bool zlib_compress(const std::string& in, std::string& out)
+{
+    static metric& m_us    = metrics::instance().get("zlib.compress_us");
+    static metric& m_raw   = metrics::instance().get("zlib.raw_bytes");
+    static metric& m_comp  = metrics::instance().get("zlib.compressed_bytes");
+    static metric& m_ratio = metrics::instance().get("zlib.ratio_pct");      // 压缩后 / 原始 × 100
+
+    auto t0 = steady_clock::now();
+    uLongf bound = ::compressBound(static_cast<uLong>(in.size()));
+    out.resize(sizeof(uint32_t) + bound);
+
+    uint32_t raw_len = static_cast<uint32_t>(in.size());
+    std::memcpy(out.data(), &raw_len, sizeof raw_len);
+    int rc = ::compress2(reinterpret_cast<Bytef*>(out.data() + sizeof raw_len), &bound,
+                         reinterpret_cast<const Bytef*>(in.data()),
+                         static_cast<uLong>(in.size()), COMPRESS_LEVEL);
+    m_us.observe(elapsed_us(t0));
+    if (rc != Z_OK || sizeof raw_len + bound >= in.size()) {
+        out.clear();
+        return false;
+    }
+    out.resize(sizeof raw_len + bound);
+
+    m_raw.observe(in.size());
+    m_comp.observe(out.size());
+    m_ratio.observe(in.empty() ? 100 : out.size() * 100 / in.size());
+    return true;
+}
+
+bool zlib_decompress(const std::string& in, std::string& out)
+{
+    static metric& m_us = metrics::instance().get("zlib.decompress_us");
+
+    uint32_t raw_len;
+    if (in.size() < sizeof raw_len) return false;
+    std::memcpy(&raw_len, in.data(), sizeof raw_len);
+
+    auto t0 = steady_clock::now();
+    out.resize(raw_len);
+    uLongf len = raw_len;
+    int rc = ::uncompress(reinterpret_cast<Bytef*>(out.data()), &len,
+                          reinterpret_cast<const Bytef*>(in.data() + sizeof raw_len),
+                          static_cast<uLong>(in.size() - sizeof raw_len));
+    m_us.observe(elapsed_us(t0));
+    if (rc != Z_OK || len != raw_len) {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,27 @@
+// ======================= compress.hpp =======================
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace hz_mq {
+
+// ---------------------------------------------------------------------------
+// 消息体 zlib 压缩（BasicProperties.content_encoding = ZLIB）
+//
+//   | u32 原始长度 (小端) | zlib 流 |
+//
+// 存储（队列参数 x-compression = zlib）与网络（openChannel 协商）共用同一格式，
+// 压缩过的消息体可原样落盘、原样投递，只有对端不支持时才解压。
+// ---------------------------------------------------------------------------
+inline constexpr size_t      COMPRESS_MIN_BYTES = 1024;       // 小于该长度不压缩
+inline constexpr int         COMPRESS_LEVEL     = 1;          // 速度优先
+inline constexpr const char* COMPRESSION_ARG    = "x-compression";
+inline constexpr const char* COMPRESSION_ZLIB   = "zlib";
+
+// 压缩 in；结果不比原文短时返回 false（调用方保留原文）
+bool zlib_compress(const std::string& in, std::string& out);
+// 解压；格式或长度不符时返回 false
+bool zlib_decompress(const std::string& in, std::string& out);
+
+}
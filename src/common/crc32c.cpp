@@ -0,0 +1,179 @@
+// ======================= crc32c.cpp =======================
+#include "crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace hz_mq {
+
+static constexpr uint32_t POLY = 0x82F63B78;     // 反射形式的 Castagnoli 多项式
+
+// ---------- slicing-by-8 查表 ----------
+using crc_tables = std::array<std::array<uint32_t, 256>, 8>;
+
+static crc_tables make_tables()
+{
+    crc_tables t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (POLY & (0u - (c & 1)));
+        t[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+        for (int s = 1; s < 8; ++s)
+            t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+    return t;
+}
+
+static const crc_tables& tables()
+{
+    static const crc_tables t = make_tables();
+    return t;
+}
+
+uint32_t crc32c_portable(const void* data, size_t len, uint32_t crc)
+{
+    const auto& t = tables();
+    const auto* p = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+
+    while (len >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);                   // 小端
+        uint32_t lo = static_cast<uint32_t>(word) ^ crc;
+        uint32_t hi = static_cast<uint32_t>(word >> 32);
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        p   += 8;
+        len -= 8;
+    }
+    while (len--) crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    return ~crc;
+}
+
+// ---------- SSE4.2 ----------
+// crc32 指令延迟 3 周期、吞吐 1 周期：把数据块切成三段交错计算，
+// 再用“追加 n 个零字节”算子把前两段的结果移位合并（n 固定为 LONG / SHORT）。
+#if defined(__x86_64__)
+static constexpr size_t LONG_BLOCK  = 8192;
+static constexpr size_t SHORT_BLOCK = 256;
+
+using shift_table = std::array<std::array<uint32_t, 256>, 4>;
+
+static uint32_t gf2_matrix_times(const uint32_t* mat, uint32_t vec)
+{
+    uint32_t sum = 0;
+    for (; vec; vec >>= 1, ++mat)
+        if (vec & 1) sum ^= *mat;
+    return sum;
+}
+
+static void gf2_matrix_square(uint32_t* square, const uint32_t* mat)
+{
+    for (int n = 0; n < 32; ++n) square[n] = gf2_matrix_times(mat, mat[n]);
+}
+
+// len（2 的幂）个零字节对应的 GF(2) 矩阵
+static void zeros_operator(uint32_t* even, size_t len)
+{
+    uint32_t odd[32];
+    odd[0] = POLY;                                  // 1 个零比特
+    for (uint32_t n = 1, row = 1; n < 32; ++n, row <<= 1) odd[n] = row;
+
+    gf2_matrix_square(even, odd);                   // 2 个零比特
+    gf2_matrix_square(odd, even);                   // 4 个零比特
+    do {
+        gf2_matrix_square(even, odd);               // 首轮得到 1 个零字节
+        len >>= 1;
+        if (len == 0) return;
+        gf2_matrix_square(odd, even);
+        len >>= 1;
+    } while (len);
+    std::memcpy(even, odd, sizeof odd);
+}
+
+static shift_table make_shift(size_t len)
+{
+    uint32_t op[32];
+    zeros_operator(op, len);
+    shift_table t{};
+    for (uint32_t n = 0; n < 256; ++n)
+        for (int b = 0; b < 4; ++b) t[b][n] = gf2_matrix_times(op, n << (8 * b));
+    return t;
+}
+
+static uint32_t shift(const shift_table& t, uint32_t crc)
+{
+    return t[0][crc & 0xFF] ^ t[1][(crc >> 8) & 0xFF] ^ t[2][(crc >> 16) & 0xFF] ^ t[3][crc >> 24];
+}
+
+// 三段交错处理 3 * block 字节的整块
+__attribute__((target("sse4.2")))
+static void crc32c_interleave(const uint8_t*& p, size_t& len, uint64_t& c0,
+                              size_t block, const shift_table& t)
+{
+    while (len >= block * 3) {
+        uint64_t c1 = 0, c2 = 0;
+        for (const uint8_t* end = p + block; p < end; p += 8) {
+            uint64_t w0, w1, w2;
+            std::memcpy(&w0, p, 8);
+            std::memcpy(&w1, p + block, 8);
+            std::memcpy(&w2, p + 2 * block, 8);
+            c0 = _mm_crc32_u64(c0, w0);
+            c1 = _mm_crc32_u64(c1, w1);
+            c2 = _mm_crc32_u64(c2, w2);
+        }
+        c0 = shift(t, static_cast<uint32_t>(c0)) ^ static_cast<uint32_t>(c1);
+        c0 = shift(t, static_cast<uint32_t>(c0)) ^ static_cast<uint32_t>(c2);
+        p   += 2 * block;
+        len -= 3 * block;
+    }
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(const void* data, size_t len, uint32_t crc)
+{
+    static const shift_table long_shift  = make_shift(LONG_BLOCK);
+    static const shift_table short_shift = make_shift(SHORT_BLOCK);
+
+    const auto* p = static_cast<const uint8_t*>(data);
+    uint64_t c0 = static_cast<uint32_t>(~crc);
+    crc32c_interleave(p, len, c0, LONG_BLOCK, long_shift);
+    crc32c_interleave(p, len, c0, SHORT_BLOCK, short_shift);
+
+    while (len >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        c0   = _mm_crc32_u64(c0, word);
+        p   += 8;
+        len -= 8;
+    }
+    auto c32 = static_cast<uint32_t>(c0);
+    while (len--) c32 = _mm_crc32_u8(c32, *p++);
+    return ~c32;
+}
+#endif
+
+bool crc32c_hardware()
+{
+#if defined(__x86_64__)
+    static const bool hw = __builtin_cpu_supports("sse4.2");
+    return hw;
+#else
+    return false;
+#endif
+}
+
+uint32_t crc32c(const void* data, size_t len, uint32_t crc)
+{
+#if defined(__x86_64__)
+    if (crc32c_hardware()) return crc32c_sse42(data, len, crc);
+#endif
+    return crc32c_portable(data, len, crc);
+}
+
+}
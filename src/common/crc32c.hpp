@@ -0,0 +1,20 @@
+// ======================= crc32c.hpp =======================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hz_mq {
+
+// ---------------------------------------------------------------------------
+// CRC32C (Castagnoli)：x86-64 且 CPU 支持 SSE4.2 时用 crc32 指令（每次 8 字节），
+// 否则退回 slicing-by-8 查表。crc 参数用于分段续算：crc32c(b, n2, crc32c(a, n1))。
+// ---------------------------------------------------------------------------
+uint32_t crc32c(const void* data, size_t len, uint32_t crc = 0);
+
+// 纯软件实现，供测试与基准对照
+uint32_t crc32c_portable(const void* data, size_t len, uint32_t crc = 0);
+
+bool crc32c_hardware();     // 当前是否走硬件路径
+
+}
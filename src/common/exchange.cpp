@@ -41,25 +41,46 @@ std::string exchange::get_args() const
 }
 
 // ---------- exchange_mapper ----------
+// 存储格式：key = 交换机名，value = "type|durable|auto_delete|args"
 exchange_mapper::exchange_mapper(const std::string& dbfile)
+    : __store(meta_store::open(dbfile))
 {
-    (void)dbfile;  // 真实实现中可在此打开 DB、建表等
 }
 
 bool exchange_mapper::insert(exchange::ptr& ex)
 {
-    (void)ex;
-    return true;   // 示例总是成功
+    std::string value = std::to_string(static_cast<int>(ex->type)) + "|" +
+                        (ex->durable ? "1" : "0") + "|" +
+                        (ex->auto_delete ? "1" : "0") + "|" +
+                        ex->get_args();
+    __store->put(meta_kind::EXCHANGE, ex->name, value);
+    return true;
 }
 
 void exchange_mapper::remove(const std::string& name)
 {
-    (void)name;
+    __store->erase(meta_kind::EXCHANGE, name);
 }
 
 exchange_map exchange_mapper::all()
 {
-    return {};     // 示例：无持久化数据
+    exchange_map result;
+    for (const auto& [name, value] : __store->all(meta_kind::EXCHANGE)) {
+        size_t p1 = value.find('|');
+        size_t p2 = value.find('|', p1 + 1);
+        size_t p3 = value.find('|', p2 + 1);
+        if (p1 == std::string::npos || p2 == std::string::npos || p3 == std::string::npos)
+            continue;
+
+        auto ex = std::make_shared<exchange>();
+        ex->name        = name;
+        ex->type        = static_cast<ExchangeType>(std::stoi(value.substr(0, p1)));
+        ex->durable     = value[p1 + 1] == '1';
+        ex->auto_delete = value[p2 + 1] == '1';
+        ex->set_args(value.substr(p3 + 1));
+        result[name] = std::move(ex);
+    }
+    return result;
 }
 
 // ---------- exchange_manager ----------
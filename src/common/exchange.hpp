@@ -7,6 +7,7 @@
 #include <string>
 
 #include "../common/protocol.pb.h"   // ExchangeType 枚举（由 Protobuf 生成）
+#include "meta_store.hpp"
 
 namespace hz_mq {
 
@@ -32,13 +33,16 @@ struct exchange {
 // 交换机名 → 元数据
 using exchange_map = std::unordered_map<std::string, exchange::ptr>;
 
-// ---------- 持久化映射层（示例省略真实存储细节） ----------
+// ---------- 持久化映射层（落到 meta_store：WAL + 快照） ----------
 class exchange_mapper {
 public:
     explicit exchange_mapper(const std::string& dbfile);
     bool insert(exchange::ptr& ex);
     void remove(const std::string& name);
     exchange_map all();
+
+private:
+    meta_store::ptr __store;
 };
 
 // ---------- 内存交换机管理器 ----------
@@ -0,0 +1,49 @@
+// ======================= file_io.hpp =======================
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace hz_mq {
+
+// ===========================================================================
+// file_io : 存储层（段日志 / 元数据 WAL / 检查点）所有改动文件内容的调用都经由此处。
+//           默认直通系统调用；测试可用 set_file_io() 换成注入故障、模拟掉电的实现。
+//           open / unlink 等只改目录项的操作不经过这里。
+// ===========================================================================
+class file_io {
+public:
+    virtual ~file_io() = default;
+
+    virtual ssize_t pwrite(int fd, const void* buf, size_t len, off_t pos) { return ::pwrite(fd, buf, len, pos); }
+    virtual ssize_t write(int fd, const void* buf, size_t len)             { return ::write(fd, buf, len); }
+    virtual int     fdatasync(int fd)                                      { return ::fdatasync(fd); }
+    virtual int     ftruncate(int fd, off_t len)                           { return ::ftruncate(fd, len); }
+    virtual int     rename(const char* from, const char* to)               { return ::rename(from, to); }
+};
+
+namespace detail {
+inline file_io                g_default_file_io;
+inline std::atomic<file_io*>  g_file_io{&g_default_file_io};
+}
+
+inline file_io& fio() { return *detail::g_file_io.load(std::memory_order_acquire); }
+
+// 安装替代实现；nullptr 恢复直通。调用方保证替换期间没有进行中的存储操作
+inline void set_file_io(file_io* io)
+{
+    detail::g_file_io.store(io ? io : &detail::g_default_file_io, std::memory_order_release);
+}
+
+// 已被替换时，storage_io 等旁路实现（io_uring）应退回经由 fio() 的路径
+inline bool file_io_intercepted()
+{
+    return detail::g_file_io.load(std::memory_order_acquire) != &detail::g_default_file_io;
+}
+
+}
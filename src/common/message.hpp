@@ -12,4 +12,7 @@ namespace hz_mq {
 // 智能指针别名，指向队列中的 Protobuf Message
 using message_ptr = std::shared_ptr<Message>;
 
+// 扇出时多个队列共享的一份消息体：入队后只读，最后一个持有者出队时可直接接管
+using shared_body = std::shared_ptr<std::string>;
+
 } 
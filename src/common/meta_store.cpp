@@ -0,0 +1,314 @@
+// ======================= meta_store.cpp =======================
+#include "meta_store.hpp"
+#include "file_io.hpp"
+#include "logger.hpp"
+#include "metrics.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace hz_mq {
+
+namespace fs = std::filesystem;
+
+static constexpr size_t RECORD_HEAD = 8;     // u32 body_len + u32 crc32
+
+// -----------------------------------------------------------------------------
+// helpers
+// -----------------------------------------------------------------------------
+static void put_u32(std::string& out, uint32_t v)
+{
+    out.append(reinterpret_cast<const char*>(&v), sizeof v);
+}
+
+static uint32_t get_u32(const char* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+static bool write_all(int fd, const std::string& data)
+{
+    const char* p = data.data();
+    size_t len = data.size();
+    while (len > 0) {
+        ssize_t n = fio().write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p   += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// open / ctor / dtor
+// -----------------------------------------------------------------------------
+meta_store::ptr meta_store::open(const std::string& dbfile)
+{
+    static std::mutex                                        s_mtx;
+    static std::unordered_map<std::string, std::weak_ptr<meta_store>> s_stores;
+
+    std::unique_lock<std::mutex> lock(s_mtx);
+    auto& slot = s_stores[dbfile];
+    if (auto store = slot.lock()) return store;
+
+    auto store = std::make_shared<meta_store>(dbfile);
+    slot = store;
+    return store;
+}
+
+meta_store::meta_store(const std::string& dbfile)
+    : __path(dbfile), __wal_path(dbfile + ".wal")
+{
+    std::error_code ec;
+    auto dir = fs::path(__path).parent_path();
+    if (!dir.empty()) fs::create_directories(dir, ec);
+
+    load();
+    __worker = std::thread(&meta_store::run, this);
+}
+
+meta_store::~meta_store()
+{
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        __stop = true;
+    }
+    __cv.notify_all();
+    if (__worker.joinable()) __worker.join();
+    if (__wal_fd >= 0) ::close(__wal_fd);
+}
+
+// -----------------------------------------------------------------------------
+// 启动：读快照，再重放 WAL（WAL 尾部残缺记录截断）
+// -----------------------------------------------------------------------------
+void meta_store::load()
+{
+    auto t0 = std::chrono::steady_clock::now();
+    replay(__path, false);
+    replay(__wal_path, true);
+
+    std::error_code ec;
+    auto wal_size = fs::file_size(__wal_path, ec);
+    __wal_bytes   = ec ? 0 : wal_size;
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - t0).count();
+    LOG(INFO) << "meta store [" << __path << "] loaded: "
+              << __tables[static_cast<int>(meta_kind::EXCHANGE)].size() << " exchanges, "
+              << __tables[static_cast<int>(meta_kind::QUEUE)].size()    << " queues, "
+              << __tables[static_cast<int>(meta_kind::BINDING)].size()  << " bindings in "
+              << ms << " ms";
+}
+
+bool meta_store::replay(const std::string& path, bool truncate_torn)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    size_t pos = 0;
+    while (pos + RECORD_HEAD <= data.size()) {
+        uint32_t len = get_u32(data.data() + pos);
+        uint32_t crc = get_u32(data.data() + pos + 4);
+        if (len < 6 || pos + RECORD_HEAD + len > data.size()) break;
+
+        const char* body = data.data() + pos + RECORD_HEAD;
+        if (crc != ::crc32(0, reinterpret_cast<const Bytef*>(body), len)) break;
+
+        uint8_t   op      = static_cast<uint8_t>(body[0]);
+        auto      kind    = static_cast<meta_kind>(body[1]);
+        uint32_t  key_len = get_u32(body + 2);
+        if (6 + key_len > len) break;
+
+        apply(op, kind, std::string(body + 6, key_len),
+              std::string(body + 6 + key_len, len - 6 - key_len));
+        pos += RECORD_HEAD + len;
+    }
+
+    if (pos < data.size()) {
+        LOG(WARNING) << "meta file [" << path << "] has a torn tail at " << pos
+                     << "/" << data.size() << " bytes";
+        if (truncate_torn) ::truncate(path.c_str(), static_cast<off_t>(pos));
+    }
+    return true;
+}
+
+void meta_store::apply(uint8_t op, meta_kind kind, const std::string& key, const std::string& value)
+{
+    auto idx = static_cast<uint8_t>(kind);
+    if (idx == 0 || idx > static_cast<uint8_t>(meta_kind::BINDING)) return;
+
+    if (op == OP_PUT)        __tables[idx][key] = value;
+    else if (op == OP_ERASE) __tables[idx].erase(key);
+}
+
+void meta_store::append_record(std::string& out, uint8_t op, meta_kind kind,
+                               const std::string& key, const std::string& value)
+{
+    std::string body;
+    body.reserve(6 + key.size() + value.size());
+    body.push_back(static_cast<char>(op));
+    body.push_back(static_cast<char>(kind));
+    put_u32(body, static_cast<uint32_t>(key.size()));
+    body += key;
+    body += value;
+
+    put_u32(out, static_cast<uint32_t>(body.size()));
+    put_u32(out, static_cast<uint32_t>(::crc32(0, reinterpret_cast<const Bytef*>(body.data()),
+                                               static_cast<uInt>(body.size()))));
+    out += body;
+}
+
+// -----------------------------------------------------------------------------
+// 读写接口：只改内存表并追加到待写缓冲，不在调用线程里 fsync
+// -----------------------------------------------------------------------------
+void meta_store::put(meta_kind kind, const std::string& key, const std::string& value)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    apply(OP_PUT, kind, key, value);
+    append_record(__pending, OP_PUT, kind, key, value);
+    ++__pending_records;
+}
+
+void meta_store::erase(meta_kind kind, const std::string& key)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    apply(OP_ERASE, kind, key, {});
+    append_record(__pending, OP_ERASE, kind, key, {});
+    ++__pending_records;
+}
+
+meta_store::table meta_store::all(meta_kind kind)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    return __tables[static_cast<uint8_t>(kind)];
+}
+
+// -----------------------------------------------------------------------------
+// 落盘
+// -----------------------------------------------------------------------------
+bool meta_store::write_wal(const std::string& batch)
+{
+    if (batch.empty()) return true;
+
+    if (__wal_fd < 0) {
+        __wal_fd = ::open(__wal_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (__wal_fd < 0) {
+            LOG(ERROR) << "open meta wal [" << __wal_path << "] failed: " << std::strerror(errno);
+            return false;
+        }
+    }
+    if (!write_all(__wal_fd, batch) || fio().fdatasync(__wal_fd) != 0) {
+        LOG(ERROR) << "write meta wal [" << __wal_path << "] failed: " << std::strerror(errno);
+        // 写了一半的记录会让重放停在这里，之后重试追加的记录全部失效：截回写前长度
+        fio().ftruncate(__wal_fd, static_cast<off_t>(__wal_bytes));
+        return false;
+    }
+    __wal_bytes += batch.size();
+    return true;
+}
+
+// 写失败的一批放回缓冲最前面，保持与之后的 put / erase 的先后顺序
+void meta_store::restore_pending(std::string& batch, uint64_t records)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    batch.append(__pending);
+    __pending.swap(batch);
+    __pending_records += records;
+}
+
+bool meta_store::flush()
+{
+    static metric& m_batch = metrics::instance().get("meta_store.batch_records");
+
+    std::unique_lock<std::mutex> io(__io_mtx);
+    std::string batch;
+    uint64_t    records;
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        batch.swap(__pending);
+        records = __pending_records;
+        __pending_records = 0;
+    }
+    if (batch.empty()) return true;
+
+    if (!write_wal(batch)) {
+        restore_pending(batch, records);
+        return false;
+    }
+    m_batch.observe(records);
+    if (__wal_bytes >= SNAPSHOT_WAL_BYTES) checkpoint_io();   // 快照失败不影响已写入 WAL 的记录
+    return true;
+}
+
+bool meta_store::checkpoint()
+{
+    std::unique_lock<std::mutex> io(__io_mtx);
+    return checkpoint_io();
+}
+
+bool meta_store::checkpoint_io()
+{
+    // 先把缓冲写进 WAL，保证 “旧快照 + WAL” 始终覆盖新快照的内容
+    std::string batch, snapshot;
+    uint64_t    records;
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        batch.swap(__pending);
+        records = __pending_records;
+        __pending_records = 0;
+        for (uint8_t k = 1; k <= static_cast<uint8_t>(meta_kind::BINDING); ++k)
+            for (const auto& [key, value] : __tables[k])
+                append_record(snapshot, OP_PUT, static_cast<meta_kind>(k), key, value);
+    }
+    if (!write_wal(batch)) {
+        restore_pending(batch, records);
+        return false;
+    }
+
+    std::string tmp = __path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool ok = write_all(fd, snapshot) && fio().fdatasync(fd) == 0;
+    ::close(fd);
+    if (!ok || fio().rename(tmp.c_str(), __path.c_str()) != 0) {
+        LOG(ERROR) << "write meta snapshot [" << __path << "] failed: " << std::strerror(errno);
+        ::unlink(tmp.c_str());
+        return false;
+    }
+
+    // 快照已生效，WAL 可以清空
+    if (__wal_fd >= 0 && fio().ftruncate(__wal_fd, 0) == 0) {
+        fio().fdatasync(__wal_fd);
+        __wal_bytes = 0;
+    }
+    return true;
+}
+
+void meta_store::run()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    while (true) {
+        bool stop = __cv.wait_for(lock, FLUSH_INTERVAL, [this] { return __stop; });
+        bool idle = __pending.empty();
+        lock.unlock();
+        if (!idle) flush();
+        if (stop) return;
+        lock.lock();
+    }
+}
+
+}
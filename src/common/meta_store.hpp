@@ -0,0 +1,82 @@
+// ======================= meta_store.hpp =======================
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace hz_mq {
+
+// 元数据种类
+enum class meta_kind : uint8_t {
+    EXCHANGE = 1,
+    QUEUE    = 2,
+    BINDING  = 3,
+};
+
+// ===========================================================================
+// meta_store : 元数据持久化（WAL + 定期快照）
+//
+//   <dbfile>      快照：当前全部元数据
+//   <dbfile>.wal  快照之后的增量操作（put / erase），按批 write + fdatasync
+//
+// 记录格式：| u32 body_len | u32 crc32(body) | u8 op | u8 kind | u32 key_len | key | value |
+// 声明类操作只进内存缓冲，由后台线程成批落盘；WAL 过大时写新快照并清空 WAL。
+// 写 WAL 失败时 WAL 截回写前长度，这批记录放回缓冲最前面等下次重试，flush() 返回 false。
+// ===========================================================================
+class meta_store {
+public:
+    using ptr   = std::shared_ptr<meta_store>;
+    using table = std::unordered_map<std::string, std::string>;   // key -> value
+
+    static constexpr auto     FLUSH_INTERVAL      = std::chrono::milliseconds(10);
+    static constexpr uint64_t SNAPSHOT_WAL_BYTES  = 4ull << 20;
+
+    // 同一路径在进程内共享一个实例（exchange / queue / binding 三个 mapper 共用）
+    static ptr open(const std::string& dbfile);
+
+    explicit meta_store(const std::string& dbfile);
+    ~meta_store();
+
+    void  put(meta_kind kind, const std::string& key, const std::string& value);
+    void  erase(meta_kind kind, const std::string& key);
+    table all(meta_kind kind);
+
+    bool flush();         // 立即把缓冲写入 WAL 并 fdatasync；失败返回 false，记录留待重试
+    bool checkpoint();    // 写快照并清空 WAL
+
+private:
+    enum : uint8_t { OP_PUT = 1, OP_ERASE = 2 };
+
+    void load();
+    bool replay(const std::string& path, bool truncate_torn);
+    void apply(uint8_t op, meta_kind kind, const std::string& key, const std::string& value);
+    void append_record(std::string& out, uint8_t op, meta_kind kind,
+                       const std::string& key, const std::string& value);
+    bool write_wal(const std::string& batch);    // 需持有 __io_mtx
+    void restore_pending(std::string& batch, uint64_t records);
+    bool checkpoint_io();                        // 需持有 __io_mtx
+    void run();
+
+    std::string               __path;
+    std::string               __wal_path;
+
+    std::mutex                __io_mtx;         // 串行化 WAL / 快照文件操作
+    int                       __wal_fd{-1};
+    uint64_t                  __wal_bytes{0};   // WAL 中完整写入的长度，写失败时截回这里
+
+    std::mutex                __mtx;            // 保护内存表与待写缓冲
+    std::condition_variable   __cv;
+    table                     __tables[4];      // 以 meta_kind 为下标
+    std::string               __pending;        // 待写入 WAL 的记录
+    uint64_t                  __pending_records{0};
+    bool                      __stop{false};
+    std::thread               __worker;
+};
+
+}
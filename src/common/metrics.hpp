@@ -0,0 +1,73 @@
+// ======================= metrics.hpp =======================
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace hz_mq {
+
+// ---------- 单项指标：次数 / 累计值 / 最大值 ----------
+class metric {
+public:
+    void observe(uint64_t v)
+    {
+        __count.fetch_add(1, std::memory_order_relaxed);
+        __sum.fetch_add(v, std::memory_order_relaxed);
+        uint64_t cur = __max.load(std::memory_order_relaxed);
+        while (v > cur && !__max.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t count() const { return __count.load(std::memory_order_relaxed); }
+    uint64_t sum()   const { return __sum.load(std::memory_order_relaxed); }
+    uint64_t max()   const { return __max.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> __count{0};
+    std::atomic<uint64_t> __sum{0};
+    std::atomic<uint64_t> __max{0};
+};
+
+// ---------- 进程级指标表：按名字取用，定期打印 ----------
+class metrics {
+public:
+    static metrics& instance()
+    {
+        static metrics inst;
+        return inst;
+    }
+
+    // 返回的引用在进程生命周期内有效，调用方可缓存
+    metric& get(const std::string& name)
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        auto& slot = __metrics[name];
+        if (!slot) slot = std::make_unique<metric>();
+        return *slot;
+    }
+
+    std::string dump()
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        std::ostringstream os;
+        for (const auto& [name, m] : __metrics) {
+            uint64_t n = m->count();
+            os << name << ": count=" << n << " sum=" << m->sum()
+               << " avg=" << (n ? m->sum() / n : 0) << " max=" << m->max() << '\n';
+        }
+        return os.str();
+    }
+
+private:
+    metrics() = default;
+
+    std::mutex                                       __mtx;
+    std::map<std::string, std::unique_ptr<metric>>   __metrics;
+};
+
+}
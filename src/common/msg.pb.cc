@@ -22,11 +22,20 @@ namespace _pbi = _pb::internal;
 
 namespace hz_mq {
 PROTOBUF_CONSTEXPR BasicProperties::BasicProperties(
-    ::_pbi::ConstantInitialized)
-  : id_(&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{})
-  , routing_key_(&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{})
-  , delivery_mode_(0)
-{}
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.routing_key_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.delay_exchange_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.death_reason_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.death_queue_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.delivery_mode_)*/0
+  , /*decltype(_impl_.content_encoding_)*/0
+  , /*decltype(_impl_.expiration_)*/uint64_t{0u}
+  , /*decltype(_impl_.expire_at_)*/int64_t{0}
+  , /*decltype(_impl_.deliver_at_)*/int64_t{0}
+  , /*decltype(_impl_.priority_)*/0u
+  , /*decltype(_impl_.death_count_)*/0u
+  , /*decltype(_impl_._cached_size_)*/{}} {}
 struct BasicPropertiesDefaultTypeInternal {
   PROTOBUF_CONSTEXPR BasicPropertiesDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -37,10 +46,11 @@ struct BasicPropertiesDefaultTypeInternal {
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 BasicPropertiesDefaultTypeInternal _BasicProperties_default_instance_;
 PROTOBUF_CONSTEXPR MessagePayload::MessagePayload(
-    ::_pbi::ConstantInitialized)
-  : body_(&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{})
-  , valid_(&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{})
-  , properties_(nullptr){}
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.body_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.valid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.properties_)*/nullptr
+  , /*decltype(_impl_._cached_size_)*/{}} {}
 struct MessagePayloadDefaultTypeInternal {
   PROTOBUF_CONSTEXPR MessagePayloadDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -51,10 +61,11 @@ struct MessagePayloadDefaultTypeInternal {
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 MessagePayloadDefaultTypeInternal _MessagePayload_default_instance_;
 PROTOBUF_CONSTEXPR Message::Message(
-    ::_pbi::ConstantInitialized)
-  : payload_(nullptr)
-  , offset_(uint64_t{0u})
-  , length_(uint64_t{0u}){}
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.payload_)*/nullptr
+  , /*decltype(_impl_.offset_)*/uint64_t{0u}
+  , /*decltype(_impl_.length_)*/uint64_t{0u}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
 struct MessageDefaultTypeInternal {
   PROTOBUF_CONSTEXPR MessageDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -64,9 +75,23 @@ struct MessageDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 MessageDefaultTypeInternal _Message_default_instance_;
+PROTOBUF_CONSTEXPR QueueCheckpoint::QueueCheckpoint(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.messages_)*/{}
+  , /*decltype(_impl_.tail_)*/uint64_t{0u}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct QueueCheckpointDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR QueueCheckpointDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~QueueCheckpointDefaultTypeInternal() {}
+  union {
+    QueueCheckpoint _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 QueueCheckpointDefaultTypeInternal _QueueCheckpoint_default_instance_;
 }  // namespace hz_mq
-static ::_pb::Metadata file_level_metadata_msg_2eproto[3];
-static const ::_pb::EnumDescriptor* file_level_enum_descriptors_msg_2eproto[1];
+static ::_pb::Metadata file_level_metadata_msg_2eproto[4];
+static const ::_pb::EnumDescriptor* file_level_enum_descriptors_msg_2eproto[2];
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_msg_2eproto = nullptr;
 
 const uint32_t TableStruct_msg_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
@@ -76,56 +101,83 @@ const uint32_t TableStruct_msg_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(prot
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
-  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, id_),
-  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, delivery_mode_),
-  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, routing_key_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.delivery_mode_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.routing_key_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.content_encoding_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.priority_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.expiration_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.expire_at_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.deliver_at_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.delay_exchange_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.death_reason_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.death_queue_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::BasicProperties, _impl_.death_count_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::hz_mq::MessagePayload, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
-  PROTOBUF_FIELD_OFFSET(::hz_mq::MessagePayload, properties_),
-  PROTOBUF_FIELD_OFFSET(::hz_mq::MessagePayload, body_),
-  PROTOBUF_FIELD_OFFSET(::hz_mq::MessagePayload, valid_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::MessagePayload, _impl_.properties_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::MessagePayload, _impl_.body_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::MessagePayload, _impl_.valid_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::hz_mq::Message, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
-  PROTOBUF_FIELD_OFFSET(::hz_mq::Message, payload_),
-  PROTOBUF_FIELD_OFFSET(::hz_mq::Message, offset_),
-  PROTOBUF_FIELD_OFFSET(::hz_mq::Message, length_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::Message, _impl_.payload_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::Message, _impl_.offset_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::Message, _impl_.length_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::hz_mq::QueueCheckpoint, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::hz_mq::QueueCheckpoint, _impl_.tail_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::QueueCheckpoint, _impl_.messages_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::hz_mq::BasicProperties)},
-  { 9, -1, -1, sizeof(::hz_mq::MessagePayload)},
-  { 18, -1, -1, sizeof(::hz_mq::Message)},
+  { 18, -1, -1, sizeof(::hz_mq::MessagePayload)},
+  { 27, -1, -1, sizeof(::hz_mq::Message)},
+  { 36, -1, -1, sizeof(::hz_mq::QueueCheckpoint)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
   &::hz_mq::_BasicProperties_default_instance_._instance,
   &::hz_mq::_MessagePayload_default_instance_._instance,
   &::hz_mq::_Message_default_instance_._instance,
+  &::hz_mq::_QueueCheckpoint_default_instance_._instance,
 };
 
 const char descriptor_table_protodef_msg_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\tmsg.proto\022\005hz_mq\"^\n\017BasicProperties\022\n\n"
-  "\002id\030\001 \001(\t\022*\n\rdelivery_mode\030\002 \001(\0162\023.hz_mq"
-  ".DeliveryMode\022\023\n\013routing_key\030\003 \001(\t\"Y\n\016Me"
-  "ssagePayload\022*\n\nproperties\030\001 \001(\0132\026.hz_mq"
-  ".BasicProperties\022\014\n\004body\030\002 \001(\t\022\r\n\005valid\030"
-  "\003 \001(\t\"Q\n\007Message\022&\n\007payload\030\001 \001(\0132\025.hz_m"
-  "q.MessagePayload\022\016\n\006offset\030\002 \001(\004\022\016\n\006leng"
-  "th\030\003 \001(\004**\n\014DeliveryMode\022\r\n\tUNDURABLE\020\000\022"
-  "\013\n\007DURABLE\020\001b\006proto3"
+  "\n\tmsg.proto\022\005hz_mq\"\265\002\n\017BasicProperties\022\n"
+  "\n\002id\030\001 \001(\t\022*\n\rdelivery_mode\030\002 \001(\0162\023.hz_m"
+  "q.DeliveryMode\022\023\n\013routing_key\030\003 \001(\t\0220\n\020c"
+  "ontent_encoding\030\004 \001(\0162\026.hz_mq.ContentEnc"
+  "oding\022\020\n\010priority\030\005 \001(\r\022\022\n\nexpiration\030\006 "
+  "\001(\004\022\021\n\texpire_at\030\007 \001(\003\022\022\n\ndeliver_at\030\010 \001"
+  "(\003\022\026\n\016delay_exchange\030\t \001(\t\022\024\n\014death_reas"
+  "on\030\n \001(\t\022\023\n\013death_queue\030\013 \001(\t\022\023\n\013death_c"
+  "ount\030\014 \001(\r\"Y\n\016MessagePayload\022*\n\nproperti"
+  "es\030\001 \001(\0132\026.hz_mq.BasicProperties\022\014\n\004body"
+  "\030\002 \001(\014\022\r\n\005valid\030\003 \001(\t\"Q\n\007Message\022&\n\007payl"
+  "oad\030\001 \001(\0132\025.hz_mq.MessagePayload\022\016\n\006offs"
+  "et\030\002 \001(\004\022\016\n\006length\030\003 \001(\004\"A\n\017QueueCheckpo"
+  "int\022\014\n\004tail\030\001 \001(\004\022 \n\010messages\030\002 \003(\0132\016.hz"
+  "_mq.Message**\n\014DeliveryMode\022\r\n\tUNDURABLE"
+  "\020\000\022\013\n\007DURABLE\020\001*)\n\017ContentEncoding\022\014\n\010ID"
+  "ENTITY\020\000\022\010\n\004ZLIB\020\001b\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_msg_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_msg_2eproto = {
-    false, false, 340, descriptor_table_protodef_msg_2eproto,
+    false, false, 666, descriptor_table_protodef_msg_2eproto,
     "msg.proto",
-    &descriptor_table_msg_2eproto_once, nullptr, 0, 3,
+    &descriptor_table_msg_2eproto_once, nullptr, 0, 4,
     schemas, file_default_instances, TableStruct_msg_2eproto::offsets,
     file_level_metadata_msg_2eproto, file_level_enum_descriptors_msg_2eproto,
     file_level_service_descriptors_msg_2eproto,
@@ -151,6 +203,20 @@ bool DeliveryMode_IsValid(int value) {
   }
 }
 
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ContentEncoding_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_msg_2eproto);
+  return file_level_enum_descriptors_msg_2eproto[1];
+}
+bool ContentEncoding_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+      return true;
+    default:
+      return false;
+  }
+}
+
 
 // ===================================================================
 
@@ -161,42 +227,113 @@ class BasicProperties::_Internal {
 BasicProperties::BasicProperties(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
-  SharedCtor();
+  SharedCtor(arena, is_message_owned);
   // @@protoc_insertion_point(arena_constructor:hz_mq.BasicProperties)
 }
 BasicProperties::BasicProperties(const BasicProperties& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
+  BasicProperties* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.id_){}
+    , decltype(_impl_.routing_key_){}
+    , decltype(_impl_.delay_exchange_){}
+    , decltype(_impl_.death_reason_){}
+    , decltype(_impl_.death_queue_){}
+    , decltype(_impl_.delivery_mode_){}
+    , decltype(_impl_.content_encoding_){}
+    , decltype(_impl_.expiration_){}
+    , decltype(_impl_.expire_at_){}
+    , decltype(_impl_.deliver_at_){}
+    , decltype(_impl_.priority_){}
+    , decltype(_impl_.death_count_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  id_.InitDefault();
+  _impl_.id_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    id_.Set("", GetArenaForAllocation());
+    _impl_.id_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   if (!from._internal_id().empty()) {
-    id_.Set(from._internal_id(), 
-      GetArenaForAllocation());
+    _this->_impl_.id_.Set(from._internal_id(), 
+      _this->GetArenaForAllocation());
   }
-  routing_key_.InitDefault();
+  _impl_.routing_key_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    routing_key_.Set("", GetArenaForAllocation());
+    _impl_.routing_key_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   if (!from._internal_routing_key().empty()) {
-    routing_key_.Set(from._internal_routing_key(), 
-      GetArenaForAllocation());
+    _this->_impl_.routing_key_.Set(from._internal_routing_key(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.delay_exchange_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.delay_exchange_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_delay_exchange().empty()) {
+    _this->_impl_.delay_exchange_.Set(from._internal_delay_exchange(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.death_reason_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.death_reason_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_death_reason().empty()) {
+    _this->_impl_.death_reason_.Set(from._internal_death_reason(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.death_queue_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.death_queue_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_death_queue().empty()) {
+    _this->_impl_.death_queue_.Set(from._internal_death_queue(), 
+      _this->GetArenaForAllocation());
   }
-  delivery_mode_ = from.delivery_mode_;
+  ::memcpy(&_impl_.delivery_mode_, &from._impl_.delivery_mode_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.death_count_) -
+    reinterpret_cast<char*>(&_impl_.delivery_mode_)) + sizeof(_impl_.death_count_));
   // @@protoc_insertion_point(copy_constructor:hz_mq.BasicProperties)
 }
 
-inline void BasicProperties::SharedCtor() {
-id_.InitDefault();
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  id_.Set("", GetArenaForAllocation());
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-routing_key_.InitDefault();
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  routing_key_.Set("", GetArenaForAllocation());
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-delivery_mode_ = 0;
+inline void BasicProperties::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.id_){}
+    , decltype(_impl_.routing_key_){}
+    , decltype(_impl_.delay_exchange_){}
+    , decltype(_impl_.death_reason_){}
+    , decltype(_impl_.death_queue_){}
+    , decltype(_impl_.delivery_mode_){0}
+    , decltype(_impl_.content_encoding_){0}
+    , decltype(_impl_.expiration_){uint64_t{0u}}
+    , decltype(_impl_.expire_at_){int64_t{0}}
+    , decltype(_impl_.deliver_at_){int64_t{0}}
+    , decltype(_impl_.priority_){0u}
+    , decltype(_impl_.death_count_){0u}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.routing_key_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.routing_key_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.delay_exchange_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.delay_exchange_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.death_reason_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.death_reason_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.death_queue_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.death_queue_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 BasicProperties::~BasicProperties() {
@@ -210,12 +347,15 @@ BasicProperties::~BasicProperties() {
 
 inline void BasicProperties::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
-  id_.Destroy();
-  routing_key_.Destroy();
+  _impl_.id_.Destroy();
+  _impl_.routing_key_.Destroy();
+  _impl_.delay_exchange_.Destroy();
+  _impl_.death_reason_.Destroy();
+  _impl_.death_queue_.Destroy();
 }
 
 void BasicProperties::SetCachedSize(int size) const {
-  _cached_size_.Set(size);
+  _impl_._cached_size_.Set(size);
 }
 
 void BasicProperties::Clear() {
@@ -224,9 +364,14 @@ void BasicProperties::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  id_.ClearToEmpty();
-  routing_key_.ClearToEmpty();
-  delivery_mode_ = 0;
+  _impl_.id_.ClearToEmpty();
+  _impl_.routing_key_.ClearToEmpty();
+  _impl_.delay_exchange_.ClearToEmpty();
+  _impl_.death_reason_.ClearToEmpty();
+  _impl_.death_queue_.ClearToEmpty();
+  ::memset(&_impl_.delivery_mode_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.death_count_) -
+      reinterpret_cast<char*>(&_impl_.delivery_mode_)) + sizeof(_impl_.death_count_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -265,6 +410,85 @@ const char* BasicProperties::_InternalParse(const char* ptr, ::_pbi::ParseContex
         } else
           goto handle_unusual;
         continue;
+      // .hz_mq.ContentEncoding content_encoding = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_content_encoding(static_cast<::hz_mq::ContentEncoding>(val));
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 priority = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.priority_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint64 expiration = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _impl_.expiration_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 expire_at = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _impl_.expire_at_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 deliver_at = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 64)) {
+          _impl_.deliver_at_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // string delay_exchange = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 74)) {
+          auto str = _internal_mutable_delay_exchange();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.BasicProperties.delay_exchange"));
+        } else
+          goto handle_unusual;
+        continue;
+      // string death_reason = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 82)) {
+          auto str = _internal_mutable_death_reason();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.BasicProperties.death_reason"));
+        } else
+          goto handle_unusual;
+        continue;
+      // string death_queue = 11;
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 90)) {
+          auto str = _internal_mutable_death_queue();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.BasicProperties.death_queue"));
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 death_count = 12;
+      case 12:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 96)) {
+          _impl_.death_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -321,6 +545,73 @@ uint8_t* BasicProperties::_InternalSerialize(
         3, this->_internal_routing_key(), target);
   }
 
+  // .hz_mq.ContentEncoding content_encoding = 4;
+  if (this->_internal_content_encoding() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      4, this->_internal_content_encoding(), target);
+  }
+
+  // uint32 priority = 5;
+  if (this->_internal_priority() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(5, this->_internal_priority(), target);
+  }
+
+  // uint64 expiration = 6;
+  if (this->_internal_expiration() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(6, this->_internal_expiration(), target);
+  }
+
+  // int64 expire_at = 7;
+  if (this->_internal_expire_at() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(7, this->_internal_expire_at(), target);
+  }
+
+  // int64 deliver_at = 8;
+  if (this->_internal_deliver_at() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(8, this->_internal_deliver_at(), target);
+  }
+
+  // string delay_exchange = 9;
+  if (!this->_internal_delay_exchange().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_delay_exchange().data(), static_cast<int>(this->_internal_delay_exchange().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "hz_mq.BasicProperties.delay_exchange");
+    target = stream->WriteStringMaybeAliased(
+        9, this->_internal_delay_exchange(), target);
+  }
+
+  // string death_reason = 10;
+  if (!this->_internal_death_reason().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_death_reason().data(), static_cast<int>(this->_internal_death_reason().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "hz_mq.BasicProperties.death_reason");
+    target = stream->WriteStringMaybeAliased(
+        10, this->_internal_death_reason(), target);
+  }
+
+  // string death_queue = 11;
+  if (!this->_internal_death_queue().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_death_queue().data(), static_cast<int>(this->_internal_death_queue().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "hz_mq.BasicProperties.death_queue");
+    target = stream->WriteStringMaybeAliased(
+        11, this->_internal_death_queue(), target);
+  }
+
+  // uint32 death_count = 12;
+  if (this->_internal_death_count() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(12, this->_internal_death_count(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -351,44 +642,119 @@ size_t BasicProperties::ByteSizeLong() const {
         this->_internal_routing_key());
   }
 
+  // string delay_exchange = 9;
+  if (!this->_internal_delay_exchange().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_delay_exchange());
+  }
+
+  // string death_reason = 10;
+  if (!this->_internal_death_reason().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_death_reason());
+  }
+
+  // string death_queue = 11;
+  if (!this->_internal_death_queue().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_death_queue());
+  }
+
   // .hz_mq.DeliveryMode delivery_mode = 2;
   if (this->_internal_delivery_mode() != 0) {
     total_size += 1 +
       ::_pbi::WireFormatLite::EnumSize(this->_internal_delivery_mode());
   }
 
-  return MaybeComputeUnknownFieldsSize(total_size, &_cached_size_);
+  // .hz_mq.ContentEncoding content_encoding = 4;
+  if (this->_internal_content_encoding() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_content_encoding());
+  }
+
+  // uint64 expiration = 6;
+  if (this->_internal_expiration() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_expiration());
+  }
+
+  // int64 expire_at = 7;
+  if (this->_internal_expire_at() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_expire_at());
+  }
+
+  // int64 deliver_at = 8;
+  if (this->_internal_deliver_at() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_deliver_at());
+  }
+
+  // uint32 priority = 5;
+  if (this->_internal_priority() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_priority());
+  }
+
+  // uint32 death_count = 12;
+  if (this->_internal_death_count() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_death_count());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData BasicProperties::_class_data_ = {
-    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSizeCheck,
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
     BasicProperties::MergeImpl
 };
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*BasicProperties::GetClassData() const { return &_class_data_; }
 
-void BasicProperties::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message* to,
-                      const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-  static_cast<BasicProperties *>(to)->MergeFrom(
-      static_cast<const BasicProperties &>(from));
-}
-
 
-void BasicProperties::MergeFrom(const BasicProperties& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:hz_mq.BasicProperties)
-  GOOGLE_DCHECK_NE(&from, this);
+void BasicProperties::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<BasicProperties*>(&to_msg);
+  auto& from = static_cast<const BasicProperties&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:hz_mq.BasicProperties)
+  GOOGLE_DCHECK_NE(&from, _this);
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
   if (!from._internal_id().empty()) {
-    _internal_set_id(from._internal_id());
+    _this->_internal_set_id(from._internal_id());
   }
   if (!from._internal_routing_key().empty()) {
-    _internal_set_routing_key(from._internal_routing_key());
+    _this->_internal_set_routing_key(from._internal_routing_key());
+  }
+  if (!from._internal_delay_exchange().empty()) {
+    _this->_internal_set_delay_exchange(from._internal_delay_exchange());
+  }
+  if (!from._internal_death_reason().empty()) {
+    _this->_internal_set_death_reason(from._internal_death_reason());
+  }
+  if (!from._internal_death_queue().empty()) {
+    _this->_internal_set_death_queue(from._internal_death_queue());
   }
   if (from._internal_delivery_mode() != 0) {
-    _internal_set_delivery_mode(from._internal_delivery_mode());
+    _this->_internal_set_delivery_mode(from._internal_delivery_mode());
   }
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  if (from._internal_content_encoding() != 0) {
+    _this->_internal_set_content_encoding(from._internal_content_encoding());
+  }
+  if (from._internal_expiration() != 0) {
+    _this->_internal_set_expiration(from._internal_expiration());
+  }
+  if (from._internal_expire_at() != 0) {
+    _this->_internal_set_expire_at(from._internal_expire_at());
+  }
+  if (from._internal_deliver_at() != 0) {
+    _this->_internal_set_deliver_at(from._internal_deliver_at());
+  }
+  if (from._internal_priority() != 0) {
+    _this->_internal_set_priority(from._internal_priority());
+  }
+  if (from._internal_death_count() != 0) {
+    _this->_internal_set_death_count(from._internal_death_count());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void BasicProperties::CopyFrom(const BasicProperties& from) {
@@ -408,14 +774,31 @@ void BasicProperties::InternalSwap(BasicProperties* other) {
   auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
-      &id_, lhs_arena,
-      &other->id_, rhs_arena
+      &_impl_.id_, lhs_arena,
+      &other->_impl_.id_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.routing_key_, lhs_arena,
+      &other->_impl_.routing_key_, rhs_arena
   );
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
-      &routing_key_, lhs_arena,
-      &other->routing_key_, rhs_arena
+      &_impl_.delay_exchange_, lhs_arena,
+      &other->_impl_.delay_exchange_, rhs_arena
   );
-  swap(delivery_mode_, other->delivery_mode_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.death_reason_, lhs_arena,
+      &other->_impl_.death_reason_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.death_queue_, lhs_arena,
+      &other->_impl_.death_queue_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(BasicProperties, _impl_.death_count_)
+      + sizeof(BasicProperties::_impl_.death_count_)
+      - PROTOBUF_FIELD_OFFSET(BasicProperties, _impl_.delivery_mode_)>(
+          reinterpret_cast<char*>(&_impl_.delivery_mode_),
+          reinterpret_cast<char*>(&other->_impl_.delivery_mode_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata BasicProperties::GetMetadata() const {
@@ -433,51 +816,64 @@ class MessagePayload::_Internal {
 
 const ::hz_mq::BasicProperties&
 MessagePayload::_Internal::properties(const MessagePayload* msg) {
-  return *msg->properties_;
+  return *msg->_impl_.properties_;
 }
 MessagePayload::MessagePayload(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
-  SharedCtor();
+  SharedCtor(arena, is_message_owned);
   // @@protoc_insertion_point(arena_constructor:hz_mq.MessagePayload)
 }
 MessagePayload::MessagePayload(const MessagePayload& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
+  MessagePayload* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.body_){}
+    , decltype(_impl_.valid_){}
+    , decltype(_impl_.properties_){nullptr}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  body_.InitDefault();
+  _impl_.body_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    body_.Set("", GetArenaForAllocation());
+    _impl_.body_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   if (!from._internal_body().empty()) {
-    body_.Set(from._internal_body(), 
-      GetArenaForAllocation());
+    _this->_impl_.body_.Set(from._internal_body(), 
+      _this->GetArenaForAllocation());
   }
-  valid_.InitDefault();
+  _impl_.valid_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    valid_.Set("", GetArenaForAllocation());
+    _impl_.valid_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   if (!from._internal_valid().empty()) {
-    valid_.Set(from._internal_valid(), 
-      GetArenaForAllocation());
+    _this->_impl_.valid_.Set(from._internal_valid(), 
+      _this->GetArenaForAllocation());
   }
   if (from._internal_has_properties()) {
-    properties_ = new ::hz_mq::BasicProperties(*from.properties_);
-  } else {
-    properties_ = nullptr;
+    _this->_impl_.properties_ = new ::hz_mq::BasicProperties(*from._impl_.properties_);
   }
   // @@protoc_insertion_point(copy_constructor:hz_mq.MessagePayload)
 }
 
-inline void MessagePayload::SharedCtor() {
-body_.InitDefault();
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  body_.Set("", GetArenaForAllocation());
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-valid_.InitDefault();
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  valid_.Set("", GetArenaForAllocation());
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-properties_ = nullptr;
+inline void MessagePayload::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.body_){}
+    , decltype(_impl_.valid_){}
+    , decltype(_impl_.properties_){nullptr}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.body_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.body_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.valid_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.valid_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 MessagePayload::~MessagePayload() {
@@ -491,13 +887,13 @@ MessagePayload::~MessagePayload() {
 
 inline void MessagePayload::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
-  body_.Destroy();
-  valid_.Destroy();
-  if (this != internal_default_instance()) delete properties_;
+  _impl_.body_.Destroy();
+  _impl_.valid_.Destroy();
+  if (this != internal_default_instance()) delete _impl_.properties_;
 }
 
 void MessagePayload::SetCachedSize(int size) const {
-  _cached_size_.Set(size);
+  _impl_._cached_size_.Set(size);
 }
 
 void MessagePayload::Clear() {
@@ -506,12 +902,12 @@ void MessagePayload::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  body_.ClearToEmpty();
-  valid_.ClearToEmpty();
-  if (GetArenaForAllocation() == nullptr && properties_ != nullptr) {
-    delete properties_;
+  _impl_.body_.ClearToEmpty();
+  _impl_.valid_.ClearToEmpty();
+  if (GetArenaForAllocation() == nullptr && _impl_.properties_ != nullptr) {
+    delete _impl_.properties_;
   }
-  properties_ = nullptr;
+  _impl_.properties_ = nullptr;
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -529,13 +925,12 @@ const char* MessagePayload::_InternalParse(const char* ptr, ::_pbi::ParseContext
         } else
           goto handle_unusual;
         continue;
-      // string body = 2;
+      // bytes body = 2;
       case 2:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
           auto str = _internal_mutable_body();
           ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
           CHK_(ptr);
-          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.MessagePayload.body"));
         } else
           goto handle_unusual;
         continue;
@@ -585,13 +980,9 @@ uint8_t* MessagePayload::_InternalSerialize(
         _Internal::properties(this).GetCachedSize(), target, stream);
   }
 
-  // string body = 2;
+  // bytes body = 2;
   if (!this->_internal_body().empty()) {
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      this->_internal_body().data(), static_cast<int>(this->_internal_body().length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "hz_mq.MessagePayload.body");
-    target = stream->WriteStringMaybeAliased(
+    target = stream->WriteBytesMaybeAliased(
         2, this->_internal_body(), target);
   }
 
@@ -621,10 +1012,10 @@ size_t MessagePayload::ByteSizeLong() const {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  // string body = 2;
+  // bytes body = 2;
   if (!this->_internal_body().empty()) {
     total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
         this->_internal_body());
   }
 
@@ -639,41 +1030,38 @@ size_t MessagePayload::ByteSizeLong() const {
   if (this->_internal_has_properties()) {
     total_size += 1 +
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
-        *properties_);
+        *_impl_.properties_);
   }
 
-  return MaybeComputeUnknownFieldsSize(total_size, &_cached_size_);
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData MessagePayload::_class_data_ = {
-    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSizeCheck,
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
     MessagePayload::MergeImpl
 };
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*MessagePayload::GetClassData() const { return &_class_data_; }
 
-void MessagePayload::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message* to,
-                      const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-  static_cast<MessagePayload *>(to)->MergeFrom(
-      static_cast<const MessagePayload &>(from));
-}
-
 
-void MessagePayload::MergeFrom(const MessagePayload& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:hz_mq.MessagePayload)
-  GOOGLE_DCHECK_NE(&from, this);
+void MessagePayload::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<MessagePayload*>(&to_msg);
+  auto& from = static_cast<const MessagePayload&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:hz_mq.MessagePayload)
+  GOOGLE_DCHECK_NE(&from, _this);
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
   if (!from._internal_body().empty()) {
-    _internal_set_body(from._internal_body());
+    _this->_internal_set_body(from._internal_body());
   }
   if (!from._internal_valid().empty()) {
-    _internal_set_valid(from._internal_valid());
+    _this->_internal_set_valid(from._internal_valid());
   }
   if (from._internal_has_properties()) {
-    _internal_mutable_properties()->::hz_mq::BasicProperties::MergeFrom(from._internal_properties());
+    _this->_internal_mutable_properties()->::hz_mq::BasicProperties::MergeFrom(
+        from._internal_properties());
   }
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void MessagePayload::CopyFrom(const MessagePayload& from) {
@@ -693,14 +1081,14 @@ void MessagePayload::InternalSwap(MessagePayload* other) {
   auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
-      &body_, lhs_arena,
-      &other->body_, rhs_arena
+      &_impl_.body_, lhs_arena,
+      &other->_impl_.body_, rhs_arena
   );
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
-      &valid_, lhs_arena,
-      &other->valid_, rhs_arena
+      &_impl_.valid_, lhs_arena,
+      &other->_impl_.valid_, rhs_arena
   );
-  swap(properties_, other->properties_);
+  swap(_impl_.properties_, other->_impl_.properties_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata MessagePayload::GetMetadata() const {
@@ -718,33 +1106,43 @@ class Message::_Internal {
 
 const ::hz_mq::MessagePayload&
 Message::_Internal::payload(const Message* msg) {
-  return *msg->payload_;
+  return *msg->_impl_.payload_;
 }
 Message::Message(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
-  SharedCtor();
+  SharedCtor(arena, is_message_owned);
   // @@protoc_insertion_point(arena_constructor:hz_mq.Message)
 }
 Message::Message(const Message& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Message* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.payload_){nullptr}
+    , decltype(_impl_.offset_){}
+    , decltype(_impl_.length_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
   if (from._internal_has_payload()) {
-    payload_ = new ::hz_mq::MessagePayload(*from.payload_);
-  } else {
-    payload_ = nullptr;
+    _this->_impl_.payload_ = new ::hz_mq::MessagePayload(*from._impl_.payload_);
   }
-  ::memcpy(&offset_, &from.offset_,
-    static_cast<size_t>(reinterpret_cast<char*>(&length_) -
-    reinterpret_cast<char*>(&offset_)) + sizeof(length_));
+  ::memcpy(&_impl_.offset_, &from._impl_.offset_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.length_) -
+    reinterpret_cast<char*>(&_impl_.offset_)) + sizeof(_impl_.length_));
   // @@protoc_insertion_point(copy_constructor:hz_mq.Message)
 }
 
-inline void Message::SharedCtor() {
-::memset(reinterpret_cast<char*>(this) + static_cast<size_t>(
-    reinterpret_cast<char*>(&payload_) - reinterpret_cast<char*>(this)),
-    0, static_cast<size_t>(reinterpret_cast<char*>(&length_) -
-    reinterpret_cast<char*>(&payload_)) + sizeof(length_));
+inline void Message::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.payload_){nullptr}
+    , decltype(_impl_.offset_){uint64_t{0u}}
+    , decltype(_impl_.length_){uint64_t{0u}}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
 }
 
 Message::~Message() {
@@ -758,11 +1156,11 @@ Message::~Message() {
 
 inline void Message::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
-  if (this != internal_default_instance()) delete payload_;
+  if (this != internal_default_instance()) delete _impl_.payload_;
 }
 
 void Message::SetCachedSize(int size) const {
-  _cached_size_.Set(size);
+  _impl_._cached_size_.Set(size);
 }
 
 void Message::Clear() {
@@ -771,13 +1169,13 @@ void Message::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  if (GetArenaForAllocation() == nullptr && payload_ != nullptr) {
-    delete payload_;
+  if (GetArenaForAllocation() == nullptr && _impl_.payload_ != nullptr) {
+    delete _impl_.payload_;
   }
-  payload_ = nullptr;
-  ::memset(&offset_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&length_) -
-      reinterpret_cast<char*>(&offset_)) + sizeof(length_));
+  _impl_.payload_ = nullptr;
+  ::memset(&_impl_.offset_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.length_) -
+      reinterpret_cast<char*>(&_impl_.offset_)) + sizeof(_impl_.length_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -798,7 +1196,7 @@ const char* Message::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx)
       // uint64 offset = 2;
       case 2:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
-          offset_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          _impl_.offset_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
           CHK_(ptr);
         } else
           goto handle_unusual;
@@ -806,7 +1204,7 @@ const char* Message::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx)
       // uint64 length = 3;
       case 3:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
-          length_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          _impl_.length_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
           CHK_(ptr);
         } else
           goto handle_unusual;
@@ -879,7 +1277,7 @@ size_t Message::ByteSizeLong() const {
   if (this->_internal_has_payload()) {
     total_size += 1 +
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
-        *payload_);
+        *_impl_.payload_);
   }
 
   // uint64 offset = 2;
@@ -892,38 +1290,35 @@ size_t Message::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_length());
   }
 
-  return MaybeComputeUnknownFieldsSize(total_size, &_cached_size_);
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Message::_class_data_ = {
-    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSizeCheck,
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
     Message::MergeImpl
 };
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Message::GetClassData() const { return &_class_data_; }
 
-void Message::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message* to,
-                      const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-  static_cast<Message *>(to)->MergeFrom(
-      static_cast<const Message &>(from));
-}
 
-
-void Message::MergeFrom(const Message& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:hz_mq.Message)
-  GOOGLE_DCHECK_NE(&from, this);
+void Message::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Message*>(&to_msg);
+  auto& from = static_cast<const Message&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:hz_mq.Message)
+  GOOGLE_DCHECK_NE(&from, _this);
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
   if (from._internal_has_payload()) {
-    _internal_mutable_payload()->::hz_mq::MessagePayload::MergeFrom(from._internal_payload());
+    _this->_internal_mutable_payload()->::hz_mq::MessagePayload::MergeFrom(
+        from._internal_payload());
   }
   if (from._internal_offset() != 0) {
-    _internal_set_offset(from._internal_offset());
+    _this->_internal_set_offset(from._internal_offset());
   }
   if (from._internal_length() != 0) {
-    _internal_set_length(from._internal_length());
+    _this->_internal_set_length(from._internal_length());
   }
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
 void Message::CopyFrom(const Message& from) {
@@ -941,11 +1336,11 @@ void Message::InternalSwap(Message* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(Message, length_)
-      + sizeof(Message::length_)
-      - PROTOBUF_FIELD_OFFSET(Message, payload_)>(
-          reinterpret_cast<char*>(&payload_),
-          reinterpret_cast<char*>(&other->payload_));
+      PROTOBUF_FIELD_OFFSET(Message, _impl_.length_)
+      + sizeof(Message::_impl_.length_)
+      - PROTOBUF_FIELD_OFFSET(Message, _impl_.payload_)>(
+          reinterpret_cast<char*>(&_impl_.payload_),
+          reinterpret_cast<char*>(&other->_impl_.payload_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata Message::GetMetadata() const {
@@ -954,6 +1349,218 @@ void Message::InternalSwap(Message* other) {
       file_level_metadata_msg_2eproto[2]);
 }
 
+// ===================================================================
+
+class QueueCheckpoint::_Internal {
+ public:
+};
+
+QueueCheckpoint::QueueCheckpoint(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:hz_mq.QueueCheckpoint)
+}
+QueueCheckpoint::QueueCheckpoint(const QueueCheckpoint& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  QueueCheckpoint* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.messages_){from._impl_.messages_}
+    , decltype(_impl_.tail_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.tail_ = from._impl_.tail_;
+  // @@protoc_insertion_point(copy_constructor:hz_mq.QueueCheckpoint)
+}
+
+inline void QueueCheckpoint::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.messages_){arena}
+    , decltype(_impl_.tail_){uint64_t{0u}}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+QueueCheckpoint::~QueueCheckpoint() {
+  // @@protoc_insertion_point(destructor:hz_mq.QueueCheckpoint)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void QueueCheckpoint::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.messages_.~RepeatedPtrField();
+}
+
+void QueueCheckpoint::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void QueueCheckpoint::Clear() {
+// @@protoc_insertion_point(message_clear_start:hz_mq.QueueCheckpoint)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.messages_.Clear();
+  _impl_.tail_ = uint64_t{0u};
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* QueueCheckpoint::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // uint64 tail = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _impl_.tail_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .hz_mq.Message messages = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_messages(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* QueueCheckpoint::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:hz_mq.QueueCheckpoint)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // uint64 tail = 1;
+  if (this->_internal_tail() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_tail(), target);
+  }
+
+  // repeated .hz_mq.Message messages = 2;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_messages_size()); i < n; i++) {
+    const auto& repfield = this->_internal_messages(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(2, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:hz_mq.QueueCheckpoint)
+  return target;
+}
+
+size_t QueueCheckpoint::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:hz_mq.QueueCheckpoint)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .hz_mq.Message messages = 2;
+  total_size += 1UL * this->_internal_messages_size();
+  for (const auto& msg : this->_impl_.messages_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // uint64 tail = 1;
+  if (this->_internal_tail() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_tail());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData QueueCheckpoint::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    QueueCheckpoint::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*QueueCheckpoint::GetClassData() const { return &_class_data_; }
+
+
+void QueueCheckpoint::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<QueueCheckpoint*>(&to_msg);
+  auto& from = static_cast<const QueueCheckpoint&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:hz_mq.QueueCheckpoint)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.messages_.MergeFrom(from._impl_.messages_);
+  if (from._internal_tail() != 0) {
+    _this->_internal_set_tail(from._internal_tail());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void QueueCheckpoint::CopyFrom(const QueueCheckpoint& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:hz_mq.QueueCheckpoint)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool QueueCheckpoint::IsInitialized() const {
+  return true;
+}
+
+void QueueCheckpoint::InternalSwap(QueueCheckpoint* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.messages_.InternalSwap(&other->_impl_.messages_);
+  swap(_impl_.tail_, other->_impl_.tail_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata QueueCheckpoint::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_msg_2eproto_getter, &descriptor_table_msg_2eproto_once,
+      file_level_metadata_msg_2eproto[3]);
+}
+
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace hz_mq
 PROTOBUF_NAMESPACE_OPEN
@@ -969,6 +1576,10 @@ template<> PROTOBUF_NOINLINE ::hz_mq::Message*
 Arena::CreateMaybeMessage< ::hz_mq::Message >(Arena* arena) {
   return Arena::CreateMessageInternal< ::hz_mq::Message >(arena);
 }
+template<> PROTOBUF_NOINLINE ::hz_mq::QueueCheckpoint*
+Arena::CreateMaybeMessage< ::hz_mq::QueueCheckpoint >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::hz_mq::QueueCheckpoint >(arena);
+}
 PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
@@ -8,12 +8,12 @@
 #include <string>
 
 #include <google/protobuf/port_def.inc>
-#if PROTOBUF_VERSION < 3020000
+#if PROTOBUF_VERSION < 3021000
 #error This file was generated by a newer version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3020002 < PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
@@ -55,11 +55,15 @@ extern MessageDefaultTypeInternal _Message_default_instance_;
 class MessagePayload;
 struct MessagePayloadDefaultTypeInternal;
 extern MessagePayloadDefaultTypeInternal _MessagePayload_default_instance_;
+class QueueCheckpoint;
+struct QueueCheckpointDefaultTypeInternal;
+extern QueueCheckpointDefaultTypeInternal _QueueCheckpoint_default_instance_;
 }  // namespace hz_mq
 PROTOBUF_NAMESPACE_OPEN
 template<> ::hz_mq::BasicProperties* Arena::CreateMaybeMessage<::hz_mq::BasicProperties>(Arena*);
 template<> ::hz_mq::Message* Arena::CreateMaybeMessage<::hz_mq::Message>(Arena*);
 template<> ::hz_mq::MessagePayload* Arena::CreateMaybeMessage<::hz_mq::MessagePayload>(Arena*);
+template<> ::hz_mq::QueueCheckpoint* Arena::CreateMaybeMessage<::hz_mq::QueueCheckpoint>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace hz_mq {
 
@@ -88,6 +92,31 @@ inline bool DeliveryMode_Parse(
   return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<DeliveryMode>(
     DeliveryMode_descriptor(), name, value);
 }
+enum ContentEncoding : int {
+  IDENTITY = 0,
+  ZLIB = 1,
+  ContentEncoding_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  ContentEncoding_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool ContentEncoding_IsValid(int value);
+constexpr ContentEncoding ContentEncoding_MIN = IDENTITY;
+constexpr ContentEncoding ContentEncoding_MAX = ZLIB;
+constexpr int ContentEncoding_ARRAYSIZE = ContentEncoding_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ContentEncoding_descriptor();
+template<typename T>
+inline const std::string& ContentEncoding_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, ContentEncoding>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function ContentEncoding_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    ContentEncoding_descriptor(), enum_t_value);
+}
+inline bool ContentEncoding_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, ContentEncoding* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<ContentEncoding>(
+    ContentEncoding_descriptor(), name, value);
+}
 // ===================================================================
 
 class BasicProperties final :
@@ -170,9 +199,11 @@ class BasicProperties final :
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const BasicProperties& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom(const BasicProperties& from);
+  void MergeFrom( const BasicProperties& from) {
+    BasicProperties::MergeImpl(*this, from);
+  }
   private:
-  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message* to, const ::PROTOBUF_NAMESPACE_ID::Message& from);
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
   public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
@@ -181,10 +212,10 @@ class BasicProperties final :
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   uint8_t* _InternalSerialize(
       uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(BasicProperties* other);
@@ -211,7 +242,16 @@ class BasicProperties final :
   enum : int {
     kIdFieldNumber = 1,
     kRoutingKeyFieldNumber = 3,
+    kDelayExchangeFieldNumber = 9,
+    kDeathReasonFieldNumber = 10,
+    kDeathQueueFieldNumber = 11,
     kDeliveryModeFieldNumber = 2,
+    kContentEncodingFieldNumber = 4,
+    kExpirationFieldNumber = 6,
+    kExpireAtFieldNumber = 7,
+    kDeliverAtFieldNumber = 8,
+    kPriorityFieldNumber = 5,
+    kDeathCountFieldNumber = 12,
   };
   // string id = 1;
   void clear_id();
@@ -241,6 +281,48 @@ class BasicProperties final :
   std::string* _internal_mutable_routing_key();
   public:
 
+  // string delay_exchange = 9;
+  void clear_delay_exchange();
+  const std::string& delay_exchange() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_delay_exchange(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_delay_exchange();
+  PROTOBUF_NODISCARD std::string* release_delay_exchange();
+  void set_allocated_delay_exchange(std::string* delay_exchange);
+  private:
+  const std::string& _internal_delay_exchange() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_delay_exchange(const std::string& value);
+  std::string* _internal_mutable_delay_exchange();
+  public:
+
+  // string death_reason = 10;
+  void clear_death_reason();
+  const std::string& death_reason() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_death_reason(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_death_reason();
+  PROTOBUF_NODISCARD std::string* release_death_reason();
+  void set_allocated_death_reason(std::string* death_reason);
+  private:
+  const std::string& _internal_death_reason() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_death_reason(const std::string& value);
+  std::string* _internal_mutable_death_reason();
+  public:
+
+  // string death_queue = 11;
+  void clear_death_queue();
+  const std::string& death_queue() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_death_queue(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_death_queue();
+  PROTOBUF_NODISCARD std::string* release_death_queue();
+  void set_allocated_death_queue(std::string* death_queue);
+  private:
+  const std::string& _internal_death_queue() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_death_queue(const std::string& value);
+  std::string* _internal_mutable_death_queue();
+  public:
+
   // .hz_mq.DeliveryMode delivery_mode = 2;
   void clear_delivery_mode();
   ::hz_mq::DeliveryMode delivery_mode() const;
@@ -250,6 +332,60 @@ class BasicProperties final :
   void _internal_set_delivery_mode(::hz_mq::DeliveryMode value);
   public:
 
+  // .hz_mq.ContentEncoding content_encoding = 4;
+  void clear_content_encoding();
+  ::hz_mq::ContentEncoding content_encoding() const;
+  void set_content_encoding(::hz_mq::ContentEncoding value);
+  private:
+  ::hz_mq::ContentEncoding _internal_content_encoding() const;
+  void _internal_set_content_encoding(::hz_mq::ContentEncoding value);
+  public:
+
+  // uint64 expiration = 6;
+  void clear_expiration();
+  uint64_t expiration() const;
+  void set_expiration(uint64_t value);
+  private:
+  uint64_t _internal_expiration() const;
+  void _internal_set_expiration(uint64_t value);
+  public:
+
+  // int64 expire_at = 7;
+  void clear_expire_at();
+  int64_t expire_at() const;
+  void set_expire_at(int64_t value);
+  private:
+  int64_t _internal_expire_at() const;
+  void _internal_set_expire_at(int64_t value);
+  public:
+
+  // int64 deliver_at = 8;
+  void clear_deliver_at();
+  int64_t deliver_at() const;
+  void set_deliver_at(int64_t value);
+  private:
+  int64_t _internal_deliver_at() const;
+  void _internal_set_deliver_at(int64_t value);
+  public:
+
+  // uint32 priority = 5;
+  void clear_priority();
+  uint32_t priority() const;
+  void set_priority(uint32_t value);
+  private:
+  uint32_t _internal_priority() const;
+  void _internal_set_priority(uint32_t value);
+  public:
+
+  // uint32 death_count = 12;
+  void clear_death_count();
+  uint32_t death_count() const;
+  void set_death_count(uint32_t value);
+  private:
+  uint32_t _internal_death_count() const;
+  void _internal_set_death_count(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:hz_mq.BasicProperties)
  private:
   class _Internal;
@@ -257,10 +393,22 @@ class BasicProperties final :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr id_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr routing_key_;
-  int delivery_mode_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr id_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr routing_key_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr delay_exchange_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr death_reason_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr death_queue_;
+    int delivery_mode_;
+    int content_encoding_;
+    uint64_t expiration_;
+    int64_t expire_at_;
+    int64_t deliver_at_;
+    uint32_t priority_;
+    uint32_t death_count_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_msg_2eproto;
 };
 // -------------------------------------------------------------------
@@ -345,9 +493,11 @@ class MessagePayload final :
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const MessagePayload& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom(const MessagePayload& from);
+  void MergeFrom( const MessagePayload& from) {
+    MessagePayload::MergeImpl(*this, from);
+  }
   private:
-  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message* to, const ::PROTOBUF_NAMESPACE_ID::Message& from);
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
   public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
@@ -356,10 +506,10 @@ class MessagePayload final :
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   uint8_t* _InternalSerialize(
       uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(MessagePayload* other);
@@ -388,7 +538,7 @@ class MessagePayload final :
     kValidFieldNumber = 3,
     kPropertiesFieldNumber = 1,
   };
-  // string body = 2;
+  // bytes body = 2;
   void clear_body();
   const std::string& body() const;
   template <typename ArgT0 = const std::string&, typename... ArgT>
@@ -441,10 +591,13 @@ class MessagePayload final :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr body_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr valid_;
-  ::hz_mq::BasicProperties* properties_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr body_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr valid_;
+    ::hz_mq::BasicProperties* properties_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_msg_2eproto;
 };
 // -------------------------------------------------------------------
@@ -529,9 +682,11 @@ class Message final :
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Message& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom(const Message& from);
+  void MergeFrom( const Message& from) {
+    Message::MergeImpl(*this, from);
+  }
   private:
-  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message* to, const ::PROTOBUF_NAMESPACE_ID::Message& from);
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
   public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
@@ -540,10 +695,10 @@ class Message final :
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   uint8_t* _InternalSerialize(
       uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(Message* other);
@@ -615,10 +770,181 @@ class Message final :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::hz_mq::MessagePayload* payload_;
-  uint64_t offset_;
-  uint64_t length_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  struct Impl_ {
+    ::hz_mq::MessagePayload* payload_;
+    uint64_t offset_;
+    uint64_t length_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_msg_2eproto;
+};
+// -------------------------------------------------------------------
+
+class QueueCheckpoint final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:hz_mq.QueueCheckpoint) */ {
+ public:
+  inline QueueCheckpoint() : QueueCheckpoint(nullptr) {}
+  ~QueueCheckpoint() override;
+  explicit PROTOBUF_CONSTEXPR QueueCheckpoint(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  QueueCheckpoint(const QueueCheckpoint& from);
+  QueueCheckpoint(QueueCheckpoint&& from) noexcept
+    : QueueCheckpoint() {
+    *this = ::std::move(from);
+  }
+
+  inline QueueCheckpoint& operator=(const QueueCheckpoint& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline QueueCheckpoint& operator=(QueueCheckpoint&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const QueueCheckpoint& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const QueueCheckpoint* internal_default_instance() {
+    return reinterpret_cast<const QueueCheckpoint*>(
+               &_QueueCheckpoint_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
+
+  friend void swap(QueueCheckpoint& a, QueueCheckpoint& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(QueueCheckpoint* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(QueueCheckpoint* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  QueueCheckpoint* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<QueueCheckpoint>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const QueueCheckpoint& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const QueueCheckpoint& from) {
+    QueueCheckpoint::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(QueueCheckpoint* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "hz_mq.QueueCheckpoint";
+  }
+  protected:
+  explicit QueueCheckpoint(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMessagesFieldNumber = 2,
+    kTailFieldNumber = 1,
+  };
+  // repeated .hz_mq.Message messages = 2;
+  int messages_size() const;
+  private:
+  int _internal_messages_size() const;
+  public:
+  void clear_messages();
+  ::hz_mq::Message* mutable_messages(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::hz_mq::Message >*
+      mutable_messages();
+  private:
+  const ::hz_mq::Message& _internal_messages(int index) const;
+  ::hz_mq::Message* _internal_add_messages();
+  public:
+  const ::hz_mq::Message& messages(int index) const;
+  ::hz_mq::Message* add_messages();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::hz_mq::Message >&
+      messages() const;
+
+  // uint64 tail = 1;
+  void clear_tail();
+  uint64_t tail() const;
+  void set_tail(uint64_t value);
+  private:
+  uint64_t _internal_tail() const;
+  void _internal_set_tail(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:hz_mq.QueueCheckpoint)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::hz_mq::Message > messages_;
+    uint64_t tail_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_msg_2eproto;
 };
 // ===================================================================
@@ -634,7 +960,7 @@ class Message final :
 
 // string id = 1;
 inline void BasicProperties::clear_id() {
-  id_.ClearToEmpty();
+  _impl_.id_.ClearToEmpty();
 }
 inline const std::string& BasicProperties::id() const {
   // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.id)
@@ -644,7 +970,7 @@ template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
 void BasicProperties::set_id(ArgT0&& arg0, ArgT... args) {
  
- id_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+ _impl_.id_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.id)
 }
 inline std::string* BasicProperties::mutable_id() {
@@ -653,19 +979,19 @@ inline std::string* BasicProperties::mutable_id() {
   return _s;
 }
 inline const std::string& BasicProperties::_internal_id() const {
-  return id_.Get();
+  return _impl_.id_.Get();
 }
 inline void BasicProperties::_internal_set_id(const std::string& value) {
   
-  id_.Set(value, GetArenaForAllocation());
+  _impl_.id_.Set(value, GetArenaForAllocation());
 }
 inline std::string* BasicProperties::_internal_mutable_id() {
   
-  return id_.Mutable(GetArenaForAllocation());
+  return _impl_.id_.Mutable(GetArenaForAllocation());
 }
 inline std::string* BasicProperties::release_id() {
   // @@protoc_insertion_point(field_release:hz_mq.BasicProperties.id)
-  return id_.Release();
+  return _impl_.id_.Release();
 }
 inline void BasicProperties::set_allocated_id(std::string* id) {
   if (id != nullptr) {
@@ -673,10 +999,10 @@ inline void BasicProperties::set_allocated_id(std::string* id) {
   } else {
     
   }
-  id_.SetAllocated(id, GetArenaForAllocation());
+  _impl_.id_.SetAllocated(id, GetArenaForAllocation());
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (id_.IsDefault()) {
-    id_.Set("", GetArenaForAllocation());
+  if (_impl_.id_.IsDefault()) {
+    _impl_.id_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:hz_mq.BasicProperties.id)
@@ -684,10 +1010,10 @@ inline void BasicProperties::set_allocated_id(std::string* id) {
 
 // .hz_mq.DeliveryMode delivery_mode = 2;
 inline void BasicProperties::clear_delivery_mode() {
-  delivery_mode_ = 0;
+  _impl_.delivery_mode_ = 0;
 }
 inline ::hz_mq::DeliveryMode BasicProperties::_internal_delivery_mode() const {
-  return static_cast< ::hz_mq::DeliveryMode >(delivery_mode_);
+  return static_cast< ::hz_mq::DeliveryMode >(_impl_.delivery_mode_);
 }
 inline ::hz_mq::DeliveryMode BasicProperties::delivery_mode() const {
   // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.delivery_mode)
@@ -695,7 +1021,7 @@ inline ::hz_mq::DeliveryMode BasicProperties::delivery_mode() const {
 }
 inline void BasicProperties::_internal_set_delivery_mode(::hz_mq::DeliveryMode value) {
   
-  delivery_mode_ = value;
+  _impl_.delivery_mode_ = value;
 }
 inline void BasicProperties::set_delivery_mode(::hz_mq::DeliveryMode value) {
   _internal_set_delivery_mode(value);
@@ -704,7 +1030,7 @@ inline void BasicProperties::set_delivery_mode(::hz_mq::DeliveryMode value) {
 
 // string routing_key = 3;
 inline void BasicProperties::clear_routing_key() {
-  routing_key_.ClearToEmpty();
+  _impl_.routing_key_.ClearToEmpty();
 }
 inline const std::string& BasicProperties::routing_key() const {
   // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.routing_key)
@@ -714,7 +1040,7 @@ template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
 void BasicProperties::set_routing_key(ArgT0&& arg0, ArgT... args) {
  
- routing_key_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+ _impl_.routing_key_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.routing_key)
 }
 inline std::string* BasicProperties::mutable_routing_key() {
@@ -723,19 +1049,19 @@ inline std::string* BasicProperties::mutable_routing_key() {
   return _s;
 }
 inline const std::string& BasicProperties::_internal_routing_key() const {
-  return routing_key_.Get();
+  return _impl_.routing_key_.Get();
 }
 inline void BasicProperties::_internal_set_routing_key(const std::string& value) {
   
-  routing_key_.Set(value, GetArenaForAllocation());
+  _impl_.routing_key_.Set(value, GetArenaForAllocation());
 }
 inline std::string* BasicProperties::_internal_mutable_routing_key() {
   
-  return routing_key_.Mutable(GetArenaForAllocation());
+  return _impl_.routing_key_.Mutable(GetArenaForAllocation());
 }
 inline std::string* BasicProperties::release_routing_key() {
   // @@protoc_insertion_point(field_release:hz_mq.BasicProperties.routing_key)
-  return routing_key_.Release();
+  return _impl_.routing_key_.Release();
 }
 inline void BasicProperties::set_allocated_routing_key(std::string* routing_key) {
   if (routing_key != nullptr) {
@@ -743,34 +1069,304 @@ inline void BasicProperties::set_allocated_routing_key(std::string* routing_key)
   } else {
     
   }
-  routing_key_.SetAllocated(routing_key, GetArenaForAllocation());
+  _impl_.routing_key_.SetAllocated(routing_key, GetArenaForAllocation());
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (routing_key_.IsDefault()) {
-    routing_key_.Set("", GetArenaForAllocation());
+  if (_impl_.routing_key_.IsDefault()) {
+    _impl_.routing_key_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:hz_mq.BasicProperties.routing_key)
 }
 
+// .hz_mq.ContentEncoding content_encoding = 4;
+inline void BasicProperties::clear_content_encoding() {
+  _impl_.content_encoding_ = 0;
+}
+inline ::hz_mq::ContentEncoding BasicProperties::_internal_content_encoding() const {
+  return static_cast< ::hz_mq::ContentEncoding >(_impl_.content_encoding_);
+}
+inline ::hz_mq::ContentEncoding BasicProperties::content_encoding() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.content_encoding)
+  return _internal_content_encoding();
+}
+inline void BasicProperties::_internal_set_content_encoding(::hz_mq::ContentEncoding value) {
+  
+  _impl_.content_encoding_ = value;
+}
+inline void BasicProperties::set_content_encoding(::hz_mq::ContentEncoding value) {
+  _internal_set_content_encoding(value);
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.content_encoding)
+}
+
+// uint32 priority = 5;
+inline void BasicProperties::clear_priority() {
+  _impl_.priority_ = 0u;
+}
+inline uint32_t BasicProperties::_internal_priority() const {
+  return _impl_.priority_;
+}
+inline uint32_t BasicProperties::priority() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.priority)
+  return _internal_priority();
+}
+inline void BasicProperties::_internal_set_priority(uint32_t value) {
+  
+  _impl_.priority_ = value;
+}
+inline void BasicProperties::set_priority(uint32_t value) {
+  _internal_set_priority(value);
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.priority)
+}
+
+// uint64 expiration = 6;
+inline void BasicProperties::clear_expiration() {
+  _impl_.expiration_ = uint64_t{0u};
+}
+inline uint64_t BasicProperties::_internal_expiration() const {
+  return _impl_.expiration_;
+}
+inline uint64_t BasicProperties::expiration() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.expiration)
+  return _internal_expiration();
+}
+inline void BasicProperties::_internal_set_expiration(uint64_t value) {
+  
+  _impl_.expiration_ = value;
+}
+inline void BasicProperties::set_expiration(uint64_t value) {
+  _internal_set_expiration(value);
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.expiration)
+}
+
+// int64 expire_at = 7;
+inline void BasicProperties::clear_expire_at() {
+  _impl_.expire_at_ = int64_t{0};
+}
+inline int64_t BasicProperties::_internal_expire_at() const {
+  return _impl_.expire_at_;
+}
+inline int64_t BasicProperties::expire_at() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.expire_at)
+  return _internal_expire_at();
+}
+inline void BasicProperties::_internal_set_expire_at(int64_t value) {
+  
+  _impl_.expire_at_ = value;
+}
+inline void BasicProperties::set_expire_at(int64_t value) {
+  _internal_set_expire_at(value);
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.expire_at)
+}
+
+// int64 deliver_at = 8;
+inline void BasicProperties::clear_deliver_at() {
+  _impl_.deliver_at_ = int64_t{0};
+}
+inline int64_t BasicProperties::_internal_deliver_at() const {
+  return _impl_.deliver_at_;
+}
+inline int64_t BasicProperties::deliver_at() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.deliver_at)
+  return _internal_deliver_at();
+}
+inline void BasicProperties::_internal_set_deliver_at(int64_t value) {
+  
+  _impl_.deliver_at_ = value;
+}
+inline void BasicProperties::set_deliver_at(int64_t value) {
+  _internal_set_deliver_at(value);
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.deliver_at)
+}
+
+// string delay_exchange = 9;
+inline void BasicProperties::clear_delay_exchange() {
+  _impl_.delay_exchange_.ClearToEmpty();
+}
+inline const std::string& BasicProperties::delay_exchange() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.delay_exchange)
+  return _internal_delay_exchange();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void BasicProperties::set_delay_exchange(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.delay_exchange_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.delay_exchange)
+}
+inline std::string* BasicProperties::mutable_delay_exchange() {
+  std::string* _s = _internal_mutable_delay_exchange();
+  // @@protoc_insertion_point(field_mutable:hz_mq.BasicProperties.delay_exchange)
+  return _s;
+}
+inline const std::string& BasicProperties::_internal_delay_exchange() const {
+  return _impl_.delay_exchange_.Get();
+}
+inline void BasicProperties::_internal_set_delay_exchange(const std::string& value) {
+  
+  _impl_.delay_exchange_.Set(value, GetArenaForAllocation());
+}
+inline std::string* BasicProperties::_internal_mutable_delay_exchange() {
+  
+  return _impl_.delay_exchange_.Mutable(GetArenaForAllocation());
+}
+inline std::string* BasicProperties::release_delay_exchange() {
+  // @@protoc_insertion_point(field_release:hz_mq.BasicProperties.delay_exchange)
+  return _impl_.delay_exchange_.Release();
+}
+inline void BasicProperties::set_allocated_delay_exchange(std::string* delay_exchange) {
+  if (delay_exchange != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.delay_exchange_.SetAllocated(delay_exchange, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.delay_exchange_.IsDefault()) {
+    _impl_.delay_exchange_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:hz_mq.BasicProperties.delay_exchange)
+}
+
+// string death_reason = 10;
+inline void BasicProperties::clear_death_reason() {
+  _impl_.death_reason_.ClearToEmpty();
+}
+inline const std::string& BasicProperties::death_reason() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.death_reason)
+  return _internal_death_reason();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void BasicProperties::set_death_reason(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.death_reason_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.death_reason)
+}
+inline std::string* BasicProperties::mutable_death_reason() {
+  std::string* _s = _internal_mutable_death_reason();
+  // @@protoc_insertion_point(field_mutable:hz_mq.BasicProperties.death_reason)
+  return _s;
+}
+inline const std::string& BasicProperties::_internal_death_reason() const {
+  return _impl_.death_reason_.Get();
+}
+inline void BasicProperties::_internal_set_death_reason(const std::string& value) {
+  
+  _impl_.death_reason_.Set(value, GetArenaForAllocation());
+}
+inline std::string* BasicProperties::_internal_mutable_death_reason() {
+  
+  return _impl_.death_reason_.Mutable(GetArenaForAllocation());
+}
+inline std::string* BasicProperties::release_death_reason() {
+  // @@protoc_insertion_point(field_release:hz_mq.BasicProperties.death_reason)
+  return _impl_.death_reason_.Release();
+}
+inline void BasicProperties::set_allocated_death_reason(std::string* death_reason) {
+  if (death_reason != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.death_reason_.SetAllocated(death_reason, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.death_reason_.IsDefault()) {
+    _impl_.death_reason_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:hz_mq.BasicProperties.death_reason)
+}
+
+// string death_queue = 11;
+inline void BasicProperties::clear_death_queue() {
+  _impl_.death_queue_.ClearToEmpty();
+}
+inline const std::string& BasicProperties::death_queue() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.death_queue)
+  return _internal_death_queue();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void BasicProperties::set_death_queue(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.death_queue_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.death_queue)
+}
+inline std::string* BasicProperties::mutable_death_queue() {
+  std::string* _s = _internal_mutable_death_queue();
+  // @@protoc_insertion_point(field_mutable:hz_mq.BasicProperties.death_queue)
+  return _s;
+}
+inline const std::string& BasicProperties::_internal_death_queue() const {
+  return _impl_.death_queue_.Get();
+}
+inline void BasicProperties::_internal_set_death_queue(const std::string& value) {
+  
+  _impl_.death_queue_.Set(value, GetArenaForAllocation());
+}
+inline std::string* BasicProperties::_internal_mutable_death_queue() {
+  
+  return _impl_.death_queue_.Mutable(GetArenaForAllocation());
+}
+inline std::string* BasicProperties::release_death_queue() {
+  // @@protoc_insertion_point(field_release:hz_mq.BasicProperties.death_queue)
+  return _impl_.death_queue_.Release();
+}
+inline void BasicProperties::set_allocated_death_queue(std::string* death_queue) {
+  if (death_queue != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.death_queue_.SetAllocated(death_queue, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.death_queue_.IsDefault()) {
+    _impl_.death_queue_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:hz_mq.BasicProperties.death_queue)
+}
+
+// uint32 death_count = 12;
+inline void BasicProperties::clear_death_count() {
+  _impl_.death_count_ = 0u;
+}
+inline uint32_t BasicProperties::_internal_death_count() const {
+  return _impl_.death_count_;
+}
+inline uint32_t BasicProperties::death_count() const {
+  // @@protoc_insertion_point(field_get:hz_mq.BasicProperties.death_count)
+  return _internal_death_count();
+}
+inline void BasicProperties::_internal_set_death_count(uint32_t value) {
+  
+  _impl_.death_count_ = value;
+}
+inline void BasicProperties::set_death_count(uint32_t value) {
+  _internal_set_death_count(value);
+  // @@protoc_insertion_point(field_set:hz_mq.BasicProperties.death_count)
+}
+
 // -------------------------------------------------------------------
 
 // MessagePayload
 
 // .hz_mq.BasicProperties properties = 1;
 inline bool MessagePayload::_internal_has_properties() const {
-  return this != internal_default_instance() && properties_ != nullptr;
+  return this != internal_default_instance() && _impl_.properties_ != nullptr;
 }
 inline bool MessagePayload::has_properties() const {
   return _internal_has_properties();
 }
 inline void MessagePayload::clear_properties() {
-  if (GetArenaForAllocation() == nullptr && properties_ != nullptr) {
-    delete properties_;
+  if (GetArenaForAllocation() == nullptr && _impl_.properties_ != nullptr) {
+    delete _impl_.properties_;
   }
-  properties_ = nullptr;
+  _impl_.properties_ = nullptr;
 }
 inline const ::hz_mq::BasicProperties& MessagePayload::_internal_properties() const {
-  const ::hz_mq::BasicProperties* p = properties_;
+  const ::hz_mq::BasicProperties* p = _impl_.properties_;
   return p != nullptr ? *p : reinterpret_cast<const ::hz_mq::BasicProperties&>(
       ::hz_mq::_BasicProperties_default_instance_);
 }
@@ -781,9 +1377,9 @@ inline const ::hz_mq::BasicProperties& MessagePayload::properties() const {
 inline void MessagePayload::unsafe_arena_set_allocated_properties(
     ::hz_mq::BasicProperties* properties) {
   if (GetArenaForAllocation() == nullptr) {
-    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(properties_);
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.properties_);
   }
-  properties_ = properties;
+  _impl_.properties_ = properties;
   if (properties) {
     
   } else {
@@ -793,8 +1389,8 @@ inline void MessagePayload::unsafe_arena_set_allocated_properties(
 }
 inline ::hz_mq::BasicProperties* MessagePayload::release_properties() {
   
-  ::hz_mq::BasicProperties* temp = properties_;
-  properties_ = nullptr;
+  ::hz_mq::BasicProperties* temp = _impl_.properties_;
+  _impl_.properties_ = nullptr;
 #ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
   auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
   temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
@@ -809,17 +1405,17 @@ inline ::hz_mq::BasicProperties* MessagePayload::release_properties() {
 inline ::hz_mq::BasicProperties* MessagePayload::unsafe_arena_release_properties() {
   // @@protoc_insertion_point(field_release:hz_mq.MessagePayload.properties)
   
-  ::hz_mq::BasicProperties* temp = properties_;
-  properties_ = nullptr;
+  ::hz_mq::BasicProperties* temp = _impl_.properties_;
+  _impl_.properties_ = nullptr;
   return temp;
 }
 inline ::hz_mq::BasicProperties* MessagePayload::_internal_mutable_properties() {
   
-  if (properties_ == nullptr) {
+  if (_impl_.properties_ == nullptr) {
     auto* p = CreateMaybeMessage<::hz_mq::BasicProperties>(GetArenaForAllocation());
-    properties_ = p;
+    _impl_.properties_ = p;
   }
-  return properties_;
+  return _impl_.properties_;
 }
 inline ::hz_mq::BasicProperties* MessagePayload::mutable_properties() {
   ::hz_mq::BasicProperties* _msg = _internal_mutable_properties();
@@ -829,7 +1425,7 @@ inline ::hz_mq::BasicProperties* MessagePayload::mutable_properties() {
 inline void MessagePayload::set_allocated_properties(::hz_mq::BasicProperties* properties) {
   ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
   if (message_arena == nullptr) {
-    delete properties_;
+    delete _impl_.properties_;
   }
   if (properties) {
     ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
@@ -842,13 +1438,13 @@ inline void MessagePayload::set_allocated_properties(::hz_mq::BasicProperties* p
   } else {
     
   }
-  properties_ = properties;
+  _impl_.properties_ = properties;
   // @@protoc_insertion_point(field_set_allocated:hz_mq.MessagePayload.properties)
 }
 
-// string body = 2;
+// bytes body = 2;
 inline void MessagePayload::clear_body() {
-  body_.ClearToEmpty();
+  _impl_.body_.ClearToEmpty();
 }
 inline const std::string& MessagePayload::body() const {
   // @@protoc_insertion_point(field_get:hz_mq.MessagePayload.body)
@@ -858,7 +1454,7 @@ template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
 void MessagePayload::set_body(ArgT0&& arg0, ArgT... args) {
  
- body_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+ _impl_.body_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:hz_mq.MessagePayload.body)
 }
 inline std::string* MessagePayload::mutable_body() {
@@ -867,19 +1463,19 @@ inline std::string* MessagePayload::mutable_body() {
   return _s;
 }
 inline const std::string& MessagePayload::_internal_body() const {
-  return body_.Get();
+  return _impl_.body_.Get();
 }
 inline void MessagePayload::_internal_set_body(const std::string& value) {
   
-  body_.Set(value, GetArenaForAllocation());
+  _impl_.body_.Set(value, GetArenaForAllocation());
 }
 inline std::string* MessagePayload::_internal_mutable_body() {
   
-  return body_.Mutable(GetArenaForAllocation());
+  return _impl_.body_.Mutable(GetArenaForAllocation());
 }
 inline std::string* MessagePayload::release_body() {
   // @@protoc_insertion_point(field_release:hz_mq.MessagePayload.body)
-  return body_.Release();
+  return _impl_.body_.Release();
 }
 inline void MessagePayload::set_allocated_body(std::string* body) {
   if (body != nullptr) {
@@ -887,10 +1483,10 @@ inline void MessagePayload::set_allocated_body(std::string* body) {
   } else {
     
   }
-  body_.SetAllocated(body, GetArenaForAllocation());
+  _impl_.body_.SetAllocated(body, GetArenaForAllocation());
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (body_.IsDefault()) {
-    body_.Set("", GetArenaForAllocation());
+  if (_impl_.body_.IsDefault()) {
+    _impl_.body_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:hz_mq.MessagePayload.body)
@@ -898,7 +1494,7 @@ inline void MessagePayload::set_allocated_body(std::string* body) {
 
 // string valid = 3;
 inline void MessagePayload::clear_valid() {
-  valid_.ClearToEmpty();
+  _impl_.valid_.ClearToEmpty();
 }
 inline const std::string& MessagePayload::valid() const {
   // @@protoc_insertion_point(field_get:hz_mq.MessagePayload.valid)
@@ -908,7 +1504,7 @@ template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
 void MessagePayload::set_valid(ArgT0&& arg0, ArgT... args) {
  
- valid_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+ _impl_.valid_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:hz_mq.MessagePayload.valid)
 }
 inline std::string* MessagePayload::mutable_valid() {
@@ -917,19 +1513,19 @@ inline std::string* MessagePayload::mutable_valid() {
   return _s;
 }
 inline const std::string& MessagePayload::_internal_valid() const {
-  return valid_.Get();
+  return _impl_.valid_.Get();
 }
 inline void MessagePayload::_internal_set_valid(const std::string& value) {
   
-  valid_.Set(value, GetArenaForAllocation());
+  _impl_.valid_.Set(value, GetArenaForAllocation());
 }
 inline std::string* MessagePayload::_internal_mutable_valid() {
   
-  return valid_.Mutable(GetArenaForAllocation());
+  return _impl_.valid_.Mutable(GetArenaForAllocation());
 }
 inline std::string* MessagePayload::release_valid() {
   // @@protoc_insertion_point(field_release:hz_mq.MessagePayload.valid)
-  return valid_.Release();
+  return _impl_.valid_.Release();
 }
 inline void MessagePayload::set_allocated_valid(std::string* valid) {
   if (valid != nullptr) {
@@ -937,10 +1533,10 @@ inline void MessagePayload::set_allocated_valid(std::string* valid) {
   } else {
     
   }
-  valid_.SetAllocated(valid, GetArenaForAllocation());
+  _impl_.valid_.SetAllocated(valid, GetArenaForAllocation());
 #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (valid_.IsDefault()) {
-    valid_.Set("", GetArenaForAllocation());
+  if (_impl_.valid_.IsDefault()) {
+    _impl_.valid_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:hz_mq.MessagePayload.valid)
@@ -952,19 +1548,19 @@ inline void MessagePayload::set_allocated_valid(std::string* valid) {
 
 // .hz_mq.MessagePayload payload = 1;
 inline bool Message::_internal_has_payload() const {
-  return this != internal_default_instance() && payload_ != nullptr;
+  return this != internal_default_instance() && _impl_.payload_ != nullptr;
 }
 inline bool Message::has_payload() const {
   return _internal_has_payload();
 }
 inline void Message::clear_payload() {
-  if (GetArenaForAllocation() == nullptr && payload_ != nullptr) {
-    delete payload_;
+  if (GetArenaForAllocation() == nullptr && _impl_.payload_ != nullptr) {
+    delete _impl_.payload_;
   }
-  payload_ = nullptr;
+  _impl_.payload_ = nullptr;
 }
 inline const ::hz_mq::MessagePayload& Message::_internal_payload() const {
-  const ::hz_mq::MessagePayload* p = payload_;
+  const ::hz_mq::MessagePayload* p = _impl_.payload_;
   return p != nullptr ? *p : reinterpret_cast<const ::hz_mq::MessagePayload&>(
       ::hz_mq::_MessagePayload_default_instance_);
 }
@@ -975,9 +1571,9 @@ inline const ::hz_mq::MessagePayload& Message::payload() const {
 inline void Message::unsafe_arena_set_allocated_payload(
     ::hz_mq::MessagePayload* payload) {
   if (GetArenaForAllocation() == nullptr) {
-    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(payload_);
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.payload_);
   }
-  payload_ = payload;
+  _impl_.payload_ = payload;
   if (payload) {
     
   } else {
@@ -987,8 +1583,8 @@ inline void Message::unsafe_arena_set_allocated_payload(
 }
 inline ::hz_mq::MessagePayload* Message::release_payload() {
   
-  ::hz_mq::MessagePayload* temp = payload_;
-  payload_ = nullptr;
+  ::hz_mq::MessagePayload* temp = _impl_.payload_;
+  _impl_.payload_ = nullptr;
 #ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
   auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
   temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
@@ -1003,17 +1599,17 @@ inline ::hz_mq::MessagePayload* Message::release_payload() {
 inline ::hz_mq::MessagePayload* Message::unsafe_arena_release_payload() {
   // @@protoc_insertion_point(field_release:hz_mq.Message.payload)
   
-  ::hz_mq::MessagePayload* temp = payload_;
-  payload_ = nullptr;
+  ::hz_mq::MessagePayload* temp = _impl_.payload_;
+  _impl_.payload_ = nullptr;
   return temp;
 }
 inline ::hz_mq::MessagePayload* Message::_internal_mutable_payload() {
   
-  if (payload_ == nullptr) {
+  if (_impl_.payload_ == nullptr) {
     auto* p = CreateMaybeMessage<::hz_mq::MessagePayload>(GetArenaForAllocation());
-    payload_ = p;
+    _impl_.payload_ = p;
   }
-  return payload_;
+  return _impl_.payload_;
 }
 inline ::hz_mq::MessagePayload* Message::mutable_payload() {
   ::hz_mq::MessagePayload* _msg = _internal_mutable_payload();
@@ -1023,7 +1619,7 @@ inline ::hz_mq::MessagePayload* Message::mutable_payload() {
 inline void Message::set_allocated_payload(::hz_mq::MessagePayload* payload) {
   ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
   if (message_arena == nullptr) {
-    delete payload_;
+    delete _impl_.payload_;
   }
   if (payload) {
     ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
@@ -1036,16 +1632,16 @@ inline void Message::set_allocated_payload(::hz_mq::MessagePayload* payload) {
   } else {
     
   }
-  payload_ = payload;
+  _impl_.payload_ = payload;
   // @@protoc_insertion_point(field_set_allocated:hz_mq.Message.payload)
 }
 
 // uint64 offset = 2;
 inline void Message::clear_offset() {
-  offset_ = uint64_t{0u};
+  _impl_.offset_ = uint64_t{0u};
 }
 inline uint64_t Message::_internal_offset() const {
-  return offset_;
+  return _impl_.offset_;
 }
 inline uint64_t Message::offset() const {
   // @@protoc_insertion_point(field_get:hz_mq.Message.offset)
@@ -1053,7 +1649,7 @@ inline uint64_t Message::offset() const {
 }
 inline void Message::_internal_set_offset(uint64_t value) {
   
-  offset_ = value;
+  _impl_.offset_ = value;
 }
 inline void Message::set_offset(uint64_t value) {
   _internal_set_offset(value);
@@ -1062,10 +1658,10 @@ inline void Message::set_offset(uint64_t value) {
 
 // uint64 length = 3;
 inline void Message::clear_length() {
-  length_ = uint64_t{0u};
+  _impl_.length_ = uint64_t{0u};
 }
 inline uint64_t Message::_internal_length() const {
-  return length_;
+  return _impl_.length_;
 }
 inline uint64_t Message::length() const {
   // @@protoc_insertion_point(field_get:hz_mq.Message.length)
@@ -1073,13 +1669,77 @@ inline uint64_t Message::length() const {
 }
 inline void Message::_internal_set_length(uint64_t value) {
   
-  length_ = value;
+  _impl_.length_ = value;
 }
 inline void Message::set_length(uint64_t value) {
   _internal_set_length(value);
   // @@protoc_insertion_point(field_set:hz_mq.Message.length)
 }
 
+// -------------------------------------------------------------------
+
+// QueueCheckpoint
+
+// uint64 tail = 1;
+inline void QueueCheckpoint::clear_tail() {
+  _impl_.tail_ = uint64_t{0u};
+}
+inline uint64_t QueueCheckpoint::_internal_tail() const {
+  return _impl_.tail_;
+}
+inline uint64_t QueueCheckpoint::tail() const {
+  // @@protoc_insertion_point(field_get:hz_mq.QueueCheckpoint.tail)
+  return _internal_tail();
+}
+inline void QueueCheckpoint::_internal_set_tail(uint64_t value) {
+  
+  _impl_.tail_ = value;
+}
+inline void QueueCheckpoint::set_tail(uint64_t value) {
+  _internal_set_tail(value);
+  // @@protoc_insertion_point(field_set:hz_mq.QueueCheckpoint.tail)
+}
+
+// repeated .hz_mq.Message messages = 2;
+inline int QueueCheckpoint::_internal_messages_size() const {
+  return _impl_.messages_.size();
+}
+inline int QueueCheckpoint::messages_size() const {
+  return _internal_messages_size();
+}
+inline void QueueCheckpoint::clear_messages() {
+  _impl_.messages_.Clear();
+}
+inline ::hz_mq::Message* QueueCheckpoint::mutable_messages(int index) {
+  // @@protoc_insertion_point(field_mutable:hz_mq.QueueCheckpoint.messages)
+  return _impl_.messages_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::hz_mq::Message >*
+QueueCheckpoint::mutable_messages() {
+  // @@protoc_insertion_point(field_mutable_list:hz_mq.QueueCheckpoint.messages)
+  return &_impl_.messages_;
+}
+inline const ::hz_mq::Message& QueueCheckpoint::_internal_messages(int index) const {
+  return _impl_.messages_.Get(index);
+}
+inline const ::hz_mq::Message& QueueCheckpoint::messages(int index) const {
+  // @@protoc_insertion_point(field_get:hz_mq.QueueCheckpoint.messages)
+  return _internal_messages(index);
+}
+inline ::hz_mq::Message* QueueCheckpoint::_internal_add_messages() {
+  return _impl_.messages_.Add();
+}
+inline ::hz_mq::Message* QueueCheckpoint::add_messages() {
+  ::hz_mq::Message* _add = _internal_add_messages();
+  // @@protoc_insertion_point(field_add:hz_mq.QueueCheckpoint.messages)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::hz_mq::Message >&
+QueueCheckpoint::messages() const {
+  // @@protoc_insertion_point(field_list:hz_mq.QueueCheckpoint.messages)
+  return _impl_.messages_;
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -1087,6 +1747,8 @@ inline void Message::set_length(uint64_t value) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -1099,6 +1761,11 @@ template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::hz_mq::DeliveryMode>() {
   return ::hz_mq::DeliveryMode_descriptor();
 }
+template <> struct is_proto_enum< ::hz_mq::ContentEncoding> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::hz_mq::ContentEncoding>() {
+  return ::hz_mq::ContentEncoding_descriptor();
+}
 
 PROTOBUF_NAMESPACE_CLOSE
 
@@ -25,6 +25,7 @@ PROTOBUF_CONSTEXPR openChannelRequest::openChannelRequest(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.rid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.cid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.compression_)*/false
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct openChannelRequestDefaultTypeInternal {
   PROTOBUF_CONSTEXPR openChannelRequestDefaultTypeInternal()
@@ -179,6 +180,7 @@ PROTOBUF_CONSTEXPR basicPublishRequest::basicPublishRequest(
   , /*decltype(_impl_.exchange_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.body_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.properties_)*/nullptr
+  , /*decltype(_impl_.delay_ms_)*/uint64_t{0u}
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct basicPublishRequestDefaultTypeInternal {
   PROTOBUF_CONSTEXPR basicPublishRequestDefaultTypeInternal()
@@ -195,6 +197,8 @@ PROTOBUF_CONSTEXPR basicAckRequest::basicAckRequest(
   , /*decltype(_impl_.cid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.queue_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.message_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.delivery_tag_)*/uint64_t{0u}
+  , /*decltype(_impl_.multiple_)*/false
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct basicAckRequestDefaultTypeInternal {
   PROTOBUF_CONSTEXPR basicAckRequestDefaultTypeInternal()
@@ -205,6 +209,23 @@ struct basicAckRequestDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 basicAckRequestDefaultTypeInternal _basicAckRequest_default_instance_;
+PROTOBUF_CONSTEXPR basicNackRequest::basicNackRequest(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.rid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.cid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.delivery_tag_)*/uint64_t{0u}
+  , /*decltype(_impl_.multiple_)*/false
+  , /*decltype(_impl_.requeue_)*/false
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct basicNackRequestDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR basicNackRequestDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~basicNackRequestDefaultTypeInternal() {}
+  union {
+    basicNackRequest _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 basicNackRequestDefaultTypeInternal _basicNackRequest_default_instance_;
 PROTOBUF_CONSTEXPR basicConsumeRequest::basicConsumeRequest(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.rid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
@@ -257,6 +278,7 @@ PROTOBUF_CONSTEXPR basicCommonResponse::basicCommonResponse(
     /*decltype(_impl_.rid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.cid_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.ok_)*/false
+  , /*decltype(_impl_.compression_)*/false
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct basicCommonResponseDefaultTypeInternal {
   PROTOBUF_CONSTEXPR basicCommonResponseDefaultTypeInternal()
@@ -273,6 +295,7 @@ PROTOBUF_CONSTEXPR basicConsumeResponse::basicConsumeResponse(
   , /*decltype(_impl_.consumer_tag_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.body_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.properties_)*/nullptr
+  , /*decltype(_impl_.delivery_tag_)*/uint64_t{0u}
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct basicConsumeResponseDefaultTypeInternal {
   PROTOBUF_CONSTEXPR basicConsumeResponseDefaultTypeInternal()
@@ -325,7 +348,7 @@ struct heartbeatResponseDefaultTypeInternal {
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 heartbeatResponseDefaultTypeInternal _heartbeatResponse_default_instance_;
 }  // namespace hz_mq
-static ::_pb::Metadata file_level_metadata_protocol_2eproto[20];
+static ::_pb::Metadata file_level_metadata_protocol_2eproto[21];
 static const ::_pb::EnumDescriptor* file_level_enum_descriptors_protocol_2eproto[1];
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_protocol_2eproto = nullptr;
 
@@ -338,6 +361,7 @@ const uint32_t TableStruct_protocol_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::hz_mq::openChannelRequest, _impl_.rid_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::openChannelRequest, _impl_.cid_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::openChannelRequest, _impl_.compression_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::hz_mq::closeChannelRequest, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -442,6 +466,7 @@ const uint32_t TableStruct_protocol_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicPublishRequest, _impl_.exchange_name_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicPublishRequest, _impl_.body_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicPublishRequest, _impl_.properties_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicPublishRequest, _impl_.delay_ms_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicAckRequest, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -452,6 +477,19 @@ const uint32_t TableStruct_protocol_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicAckRequest, _impl_.cid_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicAckRequest, _impl_.queue_name_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicAckRequest, _impl_.message_id_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicAckRequest, _impl_.delivery_tag_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicAckRequest, _impl_.multiple_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicNackRequest, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicNackRequest, _impl_.rid_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicNackRequest, _impl_.cid_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicNackRequest, _impl_.delivery_tag_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicNackRequest, _impl_.multiple_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicNackRequest, _impl_.requeue_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicConsumeRequest, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -490,6 +528,7 @@ const uint32_t TableStruct_protocol_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicCommonResponse, _impl_.rid_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicCommonResponse, _impl_.cid_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicCommonResponse, _impl_.ok_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicCommonResponse, _impl_.compression_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicConsumeResponse, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -500,6 +539,7 @@ const uint32_t TableStruct_protocol_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicConsumeResponse, _impl_.consumer_tag_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicConsumeResponse, _impl_.body_),
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicConsumeResponse, _impl_.properties_),
+  PROTOBUF_FIELD_OFFSET(::hz_mq::basicConsumeResponse, _impl_.delivery_tag_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::hz_mq::basicQueryResponse, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -526,25 +566,26 @@ const uint32_t TableStruct_protocol_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::hz_mq::openChannelRequest)},
-  { 8, -1, -1, sizeof(::hz_mq::closeChannelRequest)},
-  { 16, 24, -1, sizeof(::hz_mq::declareExchangeRequest_ArgsEntry_DoNotUse)},
-  { 26, -1, -1, sizeof(::hz_mq::declareExchangeRequest)},
-  { 39, -1, -1, sizeof(::hz_mq::deleteExchangeRequest)},
-  { 48, 56, -1, sizeof(::hz_mq::declareQueueRequest_ArgsEntry_DoNotUse)},
-  { 58, -1, -1, sizeof(::hz_mq::declareQueueRequest)},
-  { 71, -1, -1, sizeof(::hz_mq::deleteQueueRequest)},
-  { 80, -1, -1, sizeof(::hz_mq::bindRequest)},
-  { 91, -1, -1, sizeof(::hz_mq::unbindRequest)},
-  { 101, -1, -1, sizeof(::hz_mq::basicPublishRequest)},
-  { 112, -1, -1, sizeof(::hz_mq::basicAckRequest)},
-  { 122, -1, -1, sizeof(::hz_mq::basicConsumeRequest)},
-  { 133, -1, -1, sizeof(::hz_mq::basicCancelRequest)},
-  { 143, -1, -1, sizeof(::hz_mq::basicQueryRequest)},
-  { 151, -1, -1, sizeof(::hz_mq::basicCommonResponse)},
-  { 160, -1, -1, sizeof(::hz_mq::basicConsumeResponse)},
-  { 170, -1, -1, sizeof(::hz_mq::basicQueryResponse)},
-  { 179, -1, -1, sizeof(::hz_mq::heartbeatRequest)},
-  { 186, -1, -1, sizeof(::hz_mq::heartbeatResponse)},
+  { 9, -1, -1, sizeof(::hz_mq::closeChannelRequest)},
+  { 17, 25, -1, sizeof(::hz_mq::declareExchangeRequest_ArgsEntry_DoNotUse)},
+  { 27, -1, -1, sizeof(::hz_mq::declareExchangeRequest)},
+  { 40, -1, -1, sizeof(::hz_mq::deleteExchangeRequest)},
+  { 49, 57, -1, sizeof(::hz_mq::declareQueueRequest_ArgsEntry_DoNotUse)},
+  { 59, -1, -1, sizeof(::hz_mq::declareQueueRequest)},
+  { 72, -1, -1, sizeof(::hz_mq::deleteQueueRequest)},
+  { 81, -1, -1, sizeof(::hz_mq::bindRequest)},
+  { 92, -1, -1, sizeof(::hz_mq::unbindRequest)},
+  { 102, -1, -1, sizeof(::hz_mq::basicPublishRequest)},
+  { 114, -1, -1, sizeof(::hz_mq::basicAckRequest)},
+  { 126, -1, -1, sizeof(::hz_mq::basicNackRequest)},
+  { 137, -1, -1, sizeof(::hz_mq::basicConsumeRequest)},
+  { 148, -1, -1, sizeof(::hz_mq::basicCancelRequest)},
+  { 158, -1, -1, sizeof(::hz_mq::basicQueryRequest)},
+  { 166, -1, -1, sizeof(::hz_mq::basicCommonResponse)},
+  { 176, -1, -1, sizeof(::hz_mq::basicConsumeResponse)},
+  { 187, -1, -1, sizeof(::hz_mq::basicQueryResponse)},
+  { 196, -1, -1, sizeof(::hz_mq::heartbeatRequest)},
+  { 203, -1, -1, sizeof(::hz_mq::heartbeatResponse)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -560,6 +601,7 @@ static const ::_pb::Message* const file_default_instances[] = {
   &::hz_mq::_unbindRequest_default_instance_._instance,
   &::hz_mq::_basicPublishRequest_default_instance_._instance,
   &::hz_mq::_basicAckRequest_default_instance_._instance,
+  &::hz_mq::_basicNackRequest_default_instance_._instance,
   &::hz_mq::_basicConsumeRequest_default_instance_._instance,
   &::hz_mq::_basicCancelRequest_default_instance_._instance,
   &::hz_mq::_basicQueryRequest_default_instance_._instance,
@@ -571,60 +613,65 @@ static const ::_pb::Message* const file_default_instances[] = {
 };
 
 const char descriptor_table_protodef_protocol_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\016protocol.proto\022\005hz_mq\032\tmsg.proto\".\n\022op"
+  "\n\016protocol.proto\022\005hz_mq\032\tmsg.proto\"C\n\022op"
   "enChannelRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001"
-  "(\t\"/\n\023closeChannelRequest\022\013\n\003rid\030\001 \001(\t\022\013"
-  "\n\003cid\030\002 \001(\t\"\377\001\n\026declareExchangeRequest\022\013"
-  "\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\025\n\rexchange_nam"
-  "e\030\003 \001(\t\022*\n\rexchange_type\030\004 \001(\0162\023.hz_mq.E"
-  "xchangeType\022\017\n\007durable\030\005 \001(\010\022\023\n\013auto_del"
-  "ete\030\006 \001(\010\0225\n\004args\030\007 \003(\0132\'.hz_mq.declareE"
-  "xchangeRequest.ArgsEntry\032+\n\tArgsEntry\022\013\n"
-  "\003key\030\001 \001(\t\022\r\n\005value\030\002 \001(\t:\0028\001\"H\n\025deleteE"
-  "xchangeRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t"
-  "\022\025\n\rexchange_name\030\003 \001(\t\"\335\001\n\023declareQueue"
-  "Request\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\022\n\nque"
-  "ue_name\030\003 \001(\t\022\021\n\texclusive\030\004 \001(\010\022\017\n\007dura"
-  "ble\030\005 \001(\010\022\023\n\013auto_delete\030\006 \001(\010\0222\n\004args\030\007"
-  " \003(\0132$.hz_mq.declareQueueRequest.ArgsEnt"
-  "ry\032+\n\tArgsEntry\022\013\n\003key\030\001 \001(\t\022\r\n\005value\030\002 "
-  "\001(\t:\0028\001\"B\n\022deleteQueueRequest\022\013\n\003rid\030\001 \001"
-  "(\t\022\013\n\003cid\030\002 \001(\t\022\022\n\nqueue_name\030\003 \001(\t\"g\n\013b"
-  "indRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\025\n\r"
-  "exchange_name\030\003 \001(\t\022\022\n\nqueue_name\030\004 \001(\t\022"
-  "\023\n\013binding_key\030\005 \001(\t\"T\n\runbindRequest\022\013\n"
-  "\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\025\n\rexchange_name"
-  "\030\003 \001(\t\022\022\n\nqueue_name\030\004 \001(\t\"\200\001\n\023basicPubl"
-  "ishRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\025\n\r"
-  "exchange_name\030\003 \001(\t\022\014\n\004body\030\004 \001(\t\022*\n\npro"
-  "perties\030\005 \001(\0132\026.hz_mq.BasicProperties\"S\n"
-  "\017basicAckRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001"
-  "(\t\022\022\n\nqueue_name\030\003 \001(\t\022\022\n\nmessage_id\030\004 \001"
-  "(\t\"k\n\023basicConsumeRequest\022\013\n\003rid\030\001 \001(\t\022\013"
-  "\n\003cid\030\002 \001(\t\022\024\n\014consumer_tag\030\003 \001(\t\022\022\n\nque"
-  "ue_name\030\004 \001(\t\022\020\n\010auto_ack\030\005 \001(\010\"X\n\022basic"
-  "CancelRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022"
-  "\024\n\014consumer_tag\030\003 \001(\t\022\022\n\nqueue_name\030\004 \001("
-  "\t\"-\n\021basicQueryRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003c"
-  "id\030\002 \001(\t\";\n\023basicCommonResponse\022\013\n\003rid\030\001"
-  " \001(\t\022\013\n\003cid\030\002 \001(\t\022\n\n\002ok\030\003 \001(\010\"s\n\024basicCo"
-  "nsumeResponse\022\013\n\003cid\030\001 \001(\t\022\024\n\014consumer_t"
-  "ag\030\002 \001(\t\022\014\n\004body\030\003 \001(\t\022*\n\nproperties\030\004 \001"
-  "(\0132\026.hz_mq.BasicProperties\"<\n\022basicQuery"
-  "Response\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\014\n\004bo"
-  "dy\030\003 \001(\t\"\037\n\020heartbeatRequest\022\013\n\003rid\030\001 \001("
-  "\t\" \n\021heartbeatResponse\022\013\n\003rid\030\001 \001(\t*1\n\014E"
-  "xchangeType\022\n\n\006DIRECT\020\000\022\n\n\006FANOUT\020\001\022\t\n\005T"
-  "OPIC\020\002b\006proto3"
+  "(\t\022\023\n\013compression\030\003 \001(\010\"/\n\023closeChannelR"
+  "equest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\"\377\001\n\026dec"
+  "lareExchangeRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030"
+  "\002 \001(\t\022\025\n\rexchange_name\030\003 \001(\t\022*\n\rexchange"
+  "_type\030\004 \001(\0162\023.hz_mq.ExchangeType\022\017\n\007dura"
+  "ble\030\005 \001(\010\022\023\n\013auto_delete\030\006 \001(\010\0225\n\004args\030\007"
+  " \003(\0132\'.hz_mq.declareExchangeRequest.Args"
+  "Entry\032+\n\tArgsEntry\022\013\n\003key\030\001 \001(\t\022\r\n\005value"
+  "\030\002 \001(\t:\0028\001\"H\n\025deleteExchangeRequest\022\013\n\003r"
+  "id\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\025\n\rexchange_name\030\003"
+  " \001(\t\"\335\001\n\023declareQueueRequest\022\013\n\003rid\030\001 \001("
+  "\t\022\013\n\003cid\030\002 \001(\t\022\022\n\nqueue_name\030\003 \001(\t\022\021\n\tex"
+  "clusive\030\004 \001(\010\022\017\n\007durable\030\005 \001(\010\022\023\n\013auto_d"
+  "elete\030\006 \001(\010\0222\n\004args\030\007 \003(\0132$.hz_mq.declar"
+  "eQueueRequest.ArgsEntry\032+\n\tArgsEntry\022\013\n\003"
+  "key\030\001 \001(\t\022\r\n\005value\030\002 \001(\t:\0028\001\"B\n\022deleteQu"
+  "eueRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\022\n\n"
+  "queue_name\030\003 \001(\t\"g\n\013bindRequest\022\013\n\003rid\030\001"
+  " \001(\t\022\013\n\003cid\030\002 \001(\t\022\025\n\rexchange_name\030\003 \001(\t"
+  "\022\022\n\nqueue_name\030\004 \001(\t\022\023\n\013binding_key\030\005 \001("
+  "\t\"T\n\runbindRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002"
+  " \001(\t\022\025\n\rexchange_name\030\003 \001(\t\022\022\n\nqueue_nam"
+  "e\030\004 \001(\t\"\222\001\n\023basicPublishRequest\022\013\n\003rid\030\001"
+  " \001(\t\022\013\n\003cid\030\002 \001(\t\022\025\n\rexchange_name\030\003 \001(\t"
+  "\022\014\n\004body\030\004 \001(\014\022*\n\nproperties\030\005 \001(\0132\026.hz_"
+  "mq.BasicProperties\022\020\n\010delay_ms\030\006 \001(\004\"{\n\017"
+  "basicAckRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001("
+  "\t\022\022\n\nqueue_name\030\003 \001(\t\022\022\n\nmessage_id\030\004 \001("
+  "\t\022\024\n\014delivery_tag\030\005 \001(\004\022\020\n\010multiple\030\006 \001("
+  "\010\"e\n\020basicNackRequest\022\013\n\003rid\030\001 \001(\t\022\013\n\003ci"
+  "d\030\002 \001(\t\022\024\n\014delivery_tag\030\003 \001(\004\022\020\n\010multipl"
+  "e\030\004 \001(\010\022\017\n\007requeue\030\005 \001(\010\"k\n\023basicConsume"
+  "Request\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\024\n\014con"
+  "sumer_tag\030\003 \001(\t\022\022\n\nqueue_name\030\004 \001(\t\022\020\n\010a"
+  "uto_ack\030\005 \001(\010\"X\n\022basicCancelRequest\022\013\n\003r"
+  "id\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\024\n\014consumer_tag\030\003 "
+  "\001(\t\022\022\n\nqueue_name\030\004 \001(\t\"-\n\021basicQueryReq"
+  "uest\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\"P\n\023basicC"
+  "ommonResponse\022\013\n\003rid\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022"
+  "\n\n\002ok\030\003 \001(\010\022\023\n\013compression\030\004 \001(\010\"\211\001\n\024bas"
+  "icConsumeResponse\022\013\n\003cid\030\001 \001(\t\022\024\n\014consum"
+  "er_tag\030\002 \001(\t\022\014\n\004body\030\003 \001(\014\022*\n\nproperties"
+  "\030\004 \001(\0132\026.hz_mq.BasicProperties\022\024\n\014delive"
+  "ry_tag\030\005 \001(\004\"<\n\022basicQueryResponse\022\013\n\003ri"
+  "d\030\001 \001(\t\022\013\n\003cid\030\002 \001(\t\022\014\n\004body\030\003 \001(\014\"\037\n\020he"
+  "artbeatRequest\022\013\n\003rid\030\001 \001(\t\" \n\021heartbeat"
+  "Response\022\013\n\003rid\030\001 \001(\t*1\n\014ExchangeType\022\n\n"
+  "\006DIRECT\020\000\022\n\n\006FANOUT\020\001\022\t\n\005TOPIC\020\002b\006proto3"
   ;
 static const ::_pbi::DescriptorTable* const descriptor_table_protocol_2eproto_deps[1] = {
   &::descriptor_table_msg_2eproto,
 };
 static ::_pbi::once_flag descriptor_table_protocol_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_protocol_2eproto = {
-    false, false, 1774, descriptor_table_protodef_protocol_2eproto,
+    false, false, 2000, descriptor_table_protodef_protocol_2eproto,
     "protocol.proto",
-    &descriptor_table_protocol_2eproto_once, descriptor_table_protocol_2eproto_deps, 1, 20,
+    &descriptor_table_protocol_2eproto_once, descriptor_table_protocol_2eproto_deps, 1, 21,
     schemas, file_default_instances, TableStruct_protocol_2eproto::offsets,
     file_level_metadata_protocol_2eproto, file_level_enum_descriptors_protocol_2eproto,
     file_level_service_descriptors_protocol_2eproto,
@@ -670,6 +717,7 @@ openChannelRequest::openChannelRequest(const openChannelRequest& from)
   new (&_impl_) Impl_{
       decltype(_impl_.rid_){}
     , decltype(_impl_.cid_){}
+    , decltype(_impl_.compression_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -689,6 +737,7 @@ openChannelRequest::openChannelRequest(const openChannelRequest& from)
     _this->_impl_.cid_.Set(from._internal_cid(), 
       _this->GetArenaForAllocation());
   }
+  _this->_impl_.compression_ = from._impl_.compression_;
   // @@protoc_insertion_point(copy_constructor:hz_mq.openChannelRequest)
 }
 
@@ -699,6 +748,7 @@ inline void openChannelRequest::SharedCtor(
   new (&_impl_) Impl_{
       decltype(_impl_.rid_){}
     , decltype(_impl_.cid_){}
+    , decltype(_impl_.compression_){false}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.rid_.InitDefault();
@@ -738,6 +788,7 @@ void openChannelRequest::Clear() {
 
   _impl_.rid_.ClearToEmpty();
   _impl_.cid_.ClearToEmpty();
+  _impl_.compression_ = false;
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -767,6 +818,14 @@ const char* openChannelRequest::_InternalParse(const char* ptr, ::_pbi::ParseCon
         } else
           goto handle_unusual;
         continue;
+      // bool compression = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.compression_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -816,6 +875,12 @@ uint8_t* openChannelRequest::_InternalSerialize(
         2, this->_internal_cid(), target);
   }
 
+  // bool compression = 3;
+  if (this->_internal_compression() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(3, this->_internal_compression(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -846,6 +911,11 @@ size_t openChannelRequest::ByteSizeLong() const {
         this->_internal_cid());
   }
 
+  // bool compression = 3;
+  if (this->_internal_compression() != 0) {
+    total_size += 1 + 1;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -870,6 +940,9 @@ void openChannelRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, con
   if (!from._internal_cid().empty()) {
     _this->_internal_set_cid(from._internal_cid());
   }
+  if (from._internal_compression() != 0) {
+    _this->_internal_set_compression(from._internal_compression());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -897,6 +970,7 @@ void openChannelRequest::InternalSwap(openChannelRequest* other) {
       &_impl_.cid_, lhs_arena,
       &other->_impl_.cid_, rhs_arena
   );
+  swap(_impl_.compression_, other->_impl_.compression_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata openChannelRequest::GetMetadata() const {
@@ -3493,6 +3567,7 @@ basicPublishRequest::basicPublishRequest(const basicPublishRequest& from)
     , decltype(_impl_.exchange_name_){}
     , decltype(_impl_.body_){}
     , decltype(_impl_.properties_){nullptr}
+    , decltype(_impl_.delay_ms_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -3531,6 +3606,7 @@ basicPublishRequest::basicPublishRequest(const basicPublishRequest& from)
   if (from._internal_has_properties()) {
     _this->_impl_.properties_ = new ::hz_mq::BasicProperties(*from._impl_.properties_);
   }
+  _this->_impl_.delay_ms_ = from._impl_.delay_ms_;
   // @@protoc_insertion_point(copy_constructor:hz_mq.basicPublishRequest)
 }
 
@@ -3544,6 +3620,7 @@ inline void basicPublishRequest::SharedCtor(
     , decltype(_impl_.exchange_name_){}
     , decltype(_impl_.body_){}
     , decltype(_impl_.properties_){nullptr}
+    , decltype(_impl_.delay_ms_){uint64_t{0u}}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.rid_.InitDefault();
@@ -3600,6 +3677,7 @@ void basicPublishRequest::Clear() {
     delete _impl_.properties_;
   }
   _impl_.properties_ = nullptr;
+  _impl_.delay_ms_ = uint64_t{0u};
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -3639,13 +3717,12 @@ const char* basicPublishRequest::_InternalParse(const char* ptr, ::_pbi::ParseCo
         } else
           goto handle_unusual;
         continue;
-      // string body = 4;
+      // bytes body = 4;
       case 4:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
           auto str = _internal_mutable_body();
           ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
           CHK_(ptr);
-          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.basicPublishRequest.body"));
         } else
           goto handle_unusual;
         continue;
@@ -3657,6 +3734,14 @@ const char* basicPublishRequest::_InternalParse(const char* ptr, ::_pbi::ParseCo
         } else
           goto handle_unusual;
         continue;
+      // uint64 delay_ms = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _impl_.delay_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -3716,13 +3801,9 @@ uint8_t* basicPublishRequest::_InternalSerialize(
         3, this->_internal_exchange_name(), target);
   }
 
-  // string body = 4;
+  // bytes body = 4;
   if (!this->_internal_body().empty()) {
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      this->_internal_body().data(), static_cast<int>(this->_internal_body().length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "hz_mq.basicPublishRequest.body");
-    target = stream->WriteStringMaybeAliased(
+    target = stream->WriteBytesMaybeAliased(
         4, this->_internal_body(), target);
   }
 
@@ -3733,6 +3814,12 @@ uint8_t* basicPublishRequest::_InternalSerialize(
         _Internal::properties(this).GetCachedSize(), target, stream);
   }
 
+  // uint64 delay_ms = 6;
+  if (this->_internal_delay_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(6, this->_internal_delay_ms(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -3770,10 +3857,10 @@ size_t basicPublishRequest::ByteSizeLong() const {
         this->_internal_exchange_name());
   }
 
-  // string body = 4;
+  // bytes body = 4;
   if (!this->_internal_body().empty()) {
     total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
         this->_internal_body());
   }
 
@@ -3784,6 +3871,11 @@ size_t basicPublishRequest::ByteSizeLong() const {
         *_impl_.properties_);
   }
 
+  // uint64 delay_ms = 6;
+  if (this->_internal_delay_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_delay_ms());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -3818,6 +3910,9 @@ void basicPublishRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, co
     _this->_internal_mutable_properties()->::hz_mq::BasicProperties::MergeFrom(
         from._internal_properties());
   }
+  if (from._internal_delay_ms() != 0) {
+    _this->_internal_set_delay_ms(from._internal_delay_ms());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -3853,7 +3948,12 @@ void basicPublishRequest::InternalSwap(basicPublishRequest* other) {
       &_impl_.body_, lhs_arena,
       &other->_impl_.body_, rhs_arena
   );
-  swap(_impl_.properties_, other->_impl_.properties_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(basicPublishRequest, _impl_.delay_ms_)
+      + sizeof(basicPublishRequest::_impl_.delay_ms_)
+      - PROTOBUF_FIELD_OFFSET(basicPublishRequest, _impl_.properties_)>(
+          reinterpret_cast<char*>(&_impl_.properties_),
+          reinterpret_cast<char*>(&other->_impl_.properties_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata basicPublishRequest::GetMetadata() const {
@@ -3882,6 +3982,8 @@ basicAckRequest::basicAckRequest(const basicAckRequest& from)
     , decltype(_impl_.cid_){}
     , decltype(_impl_.queue_name_){}
     , decltype(_impl_.message_id_){}
+    , decltype(_impl_.delivery_tag_){}
+    , decltype(_impl_.multiple_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -3917,6 +4019,9 @@ basicAckRequest::basicAckRequest(const basicAckRequest& from)
     _this->_impl_.message_id_.Set(from._internal_message_id(), 
       _this->GetArenaForAllocation());
   }
+  ::memcpy(&_impl_.delivery_tag_, &from._impl_.delivery_tag_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.multiple_) -
+    reinterpret_cast<char*>(&_impl_.delivery_tag_)) + sizeof(_impl_.multiple_));
   // @@protoc_insertion_point(copy_constructor:hz_mq.basicAckRequest)
 }
 
@@ -3929,6 +4034,8 @@ inline void basicAckRequest::SharedCtor(
     , decltype(_impl_.cid_){}
     , decltype(_impl_.queue_name_){}
     , decltype(_impl_.message_id_){}
+    , decltype(_impl_.delivery_tag_){uint64_t{0u}}
+    , decltype(_impl_.multiple_){false}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.rid_.InitDefault();
@@ -3980,6 +4087,9 @@ void basicAckRequest::Clear() {
   _impl_.cid_.ClearToEmpty();
   _impl_.queue_name_.ClearToEmpty();
   _impl_.message_id_.ClearToEmpty();
+  ::memset(&_impl_.delivery_tag_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.multiple_) -
+      reinterpret_cast<char*>(&_impl_.delivery_tag_)) + sizeof(_impl_.multiple_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -4029,6 +4139,22 @@ const char* basicAckRequest::_InternalParse(const char* ptr, ::_pbi::ParseContex
         } else
           goto handle_unusual;
         continue;
+      // uint64 delivery_tag = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.delivery_tag_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bool multiple = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _impl_.multiple_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -4098,6 +4224,18 @@ uint8_t* basicAckRequest::_InternalSerialize(
         4, this->_internal_message_id(), target);
   }
 
+  // uint64 delivery_tag = 5;
+  if (this->_internal_delivery_tag() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(5, this->_internal_delivery_tag(), target);
+  }
+
+  // bool multiple = 6;
+  if (this->_internal_multiple() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(6, this->_internal_multiple(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -4142,6 +4280,16 @@ size_t basicAckRequest::ByteSizeLong() const {
         this->_internal_message_id());
   }
 
+  // uint64 delivery_tag = 5;
+  if (this->_internal_delivery_tag() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_delivery_tag());
+  }
+
+  // bool multiple = 6;
+  if (this->_internal_multiple() != 0) {
+    total_size += 1 + 1;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -4172,6 +4320,12 @@ void basicAckRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const
   if (!from._internal_message_id().empty()) {
     _this->_internal_set_message_id(from._internal_message_id());
   }
+  if (from._internal_delivery_tag() != 0) {
+    _this->_internal_set_delivery_tag(from._internal_delivery_tag());
+  }
+  if (from._internal_multiple() != 0) {
+    _this->_internal_set_multiple(from._internal_multiple());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -4207,6 +4361,12 @@ void basicAckRequest::InternalSwap(basicAckRequest* other) {
       &_impl_.message_id_, lhs_arena,
       &other->_impl_.message_id_, rhs_arena
   );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(basicAckRequest, _impl_.multiple_)
+      + sizeof(basicAckRequest::_impl_.multiple_)
+      - PROTOBUF_FIELD_OFFSET(basicAckRequest, _impl_.delivery_tag_)>(
+          reinterpret_cast<char*>(&_impl_.delivery_tag_),
+          reinterpret_cast<char*>(&other->_impl_.delivery_tag_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata basicAckRequest::GetMetadata() const {
@@ -4217,6 +4377,343 @@ void basicAckRequest::InternalSwap(basicAckRequest* other) {
 
 // ===================================================================
 
+class basicNackRequest::_Internal {
+ public:
+};
+
+basicNackRequest::basicNackRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:hz_mq.basicNackRequest)
+}
+basicNackRequest::basicNackRequest(const basicNackRequest& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  basicNackRequest* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.rid_){}
+    , decltype(_impl_.cid_){}
+    , decltype(_impl_.delivery_tag_){}
+    , decltype(_impl_.multiple_){}
+    , decltype(_impl_.requeue_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.rid_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.rid_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_rid().empty()) {
+    _this->_impl_.rid_.Set(from._internal_rid(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.cid_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.cid_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_cid().empty()) {
+    _this->_impl_.cid_.Set(from._internal_cid(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.delivery_tag_, &from._impl_.delivery_tag_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.requeue_) -
+    reinterpret_cast<char*>(&_impl_.delivery_tag_)) + sizeof(_impl_.requeue_));
+  // @@protoc_insertion_point(copy_constructor:hz_mq.basicNackRequest)
+}
+
+inline void basicNackRequest::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.rid_){}
+    , decltype(_impl_.cid_){}
+    , decltype(_impl_.delivery_tag_){uint64_t{0u}}
+    , decltype(_impl_.multiple_){false}
+    , decltype(_impl_.requeue_){false}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.rid_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.rid_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.cid_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.cid_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+basicNackRequest::~basicNackRequest() {
+  // @@protoc_insertion_point(destructor:hz_mq.basicNackRequest)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void basicNackRequest::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.rid_.Destroy();
+  _impl_.cid_.Destroy();
+}
+
+void basicNackRequest::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void basicNackRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:hz_mq.basicNackRequest)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.rid_.ClearToEmpty();
+  _impl_.cid_.ClearToEmpty();
+  ::memset(&_impl_.delivery_tag_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.requeue_) -
+      reinterpret_cast<char*>(&_impl_.delivery_tag_)) + sizeof(_impl_.requeue_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* basicNackRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // string rid = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_rid();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.basicNackRequest.rid"));
+        } else
+          goto handle_unusual;
+        continue;
+      // string cid = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_cid();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.basicNackRequest.cid"));
+        } else
+          goto handle_unusual;
+        continue;
+      // uint64 delivery_tag = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.delivery_tag_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bool multiple = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.multiple_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bool requeue = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.requeue_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* basicNackRequest::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:hz_mq.basicNackRequest)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string rid = 1;
+  if (!this->_internal_rid().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_rid().data(), static_cast<int>(this->_internal_rid().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "hz_mq.basicNackRequest.rid");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_rid(), target);
+  }
+
+  // string cid = 2;
+  if (!this->_internal_cid().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_cid().data(), static_cast<int>(this->_internal_cid().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "hz_mq.basicNackRequest.cid");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_cid(), target);
+  }
+
+  // uint64 delivery_tag = 3;
+  if (this->_internal_delivery_tag() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(3, this->_internal_delivery_tag(), target);
+  }
+
+  // bool multiple = 4;
+  if (this->_internal_multiple() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(4, this->_internal_multiple(), target);
+  }
+
+  // bool requeue = 5;
+  if (this->_internal_requeue() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(5, this->_internal_requeue(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:hz_mq.basicNackRequest)
+  return target;
+}
+
+size_t basicNackRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:hz_mq.basicNackRequest)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // string rid = 1;
+  if (!this->_internal_rid().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_rid());
+  }
+
+  // string cid = 2;
+  if (!this->_internal_cid().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_cid());
+  }
+
+  // uint64 delivery_tag = 3;
+  if (this->_internal_delivery_tag() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_delivery_tag());
+  }
+
+  // bool multiple = 4;
+  if (this->_internal_multiple() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // bool requeue = 5;
+  if (this->_internal_requeue() != 0) {
+    total_size += 1 + 1;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData basicNackRequest::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    basicNackRequest::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*basicNackRequest::GetClassData() const { return &_class_data_; }
+
+
+void basicNackRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<basicNackRequest*>(&to_msg);
+  auto& from = static_cast<const basicNackRequest&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:hz_mq.basicNackRequest)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_rid().empty()) {
+    _this->_internal_set_rid(from._internal_rid());
+  }
+  if (!from._internal_cid().empty()) {
+    _this->_internal_set_cid(from._internal_cid());
+  }
+  if (from._internal_delivery_tag() != 0) {
+    _this->_internal_set_delivery_tag(from._internal_delivery_tag());
+  }
+  if (from._internal_multiple() != 0) {
+    _this->_internal_set_multiple(from._internal_multiple());
+  }
+  if (from._internal_requeue() != 0) {
+    _this->_internal_set_requeue(from._internal_requeue());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void basicNackRequest::CopyFrom(const basicNackRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:hz_mq.basicNackRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool basicNackRequest::IsInitialized() const {
+  return true;
+}
+
+void basicNackRequest::InternalSwap(basicNackRequest* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.rid_, lhs_arena,
+      &other->_impl_.rid_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.cid_, lhs_arena,
+      &other->_impl_.cid_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(basicNackRequest, _impl_.requeue_)
+      + sizeof(basicNackRequest::_impl_.requeue_)
+      - PROTOBUF_FIELD_OFFSET(basicNackRequest, _impl_.delivery_tag_)>(
+          reinterpret_cast<char*>(&_impl_.delivery_tag_),
+          reinterpret_cast<char*>(&other->_impl_.delivery_tag_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata basicNackRequest::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
+      file_level_metadata_protocol_2eproto[12]);
+}
+
+// ===================================================================
+
 class basicConsumeRequest::_Internal {
  public:
 };
@@ -4592,7 +5089,7 @@ void basicConsumeRequest::InternalSwap(basicConsumeRequest* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata basicConsumeRequest::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
-      file_level_metadata_protocol_2eproto[12]);
+      file_level_metadata_protocol_2eproto[13]);
 }
 
 // ===================================================================
@@ -4945,7 +5442,7 @@ void basicCancelRequest::InternalSwap(basicCancelRequest* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata basicCancelRequest::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
-      file_level_metadata_protocol_2eproto[13]);
+      file_level_metadata_protocol_2eproto[14]);
 }
 
 // ===================================================================
@@ -5198,7 +5695,7 @@ void basicQueryRequest::InternalSwap(basicQueryRequest* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata basicQueryRequest::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
-      file_level_metadata_protocol_2eproto[14]);
+      file_level_metadata_protocol_2eproto[15]);
 }
 
 // ===================================================================
@@ -5220,6 +5717,7 @@ basicCommonResponse::basicCommonResponse(const basicCommonResponse& from)
       decltype(_impl_.rid_){}
     , decltype(_impl_.cid_){}
     , decltype(_impl_.ok_){}
+    , decltype(_impl_.compression_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -5239,7 +5737,9 @@ basicCommonResponse::basicCommonResponse(const basicCommonResponse& from)
     _this->_impl_.cid_.Set(from._internal_cid(), 
       _this->GetArenaForAllocation());
   }
-  _this->_impl_.ok_ = from._impl_.ok_;
+  ::memcpy(&_impl_.ok_, &from._impl_.ok_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.compression_) -
+    reinterpret_cast<char*>(&_impl_.ok_)) + sizeof(_impl_.compression_));
   // @@protoc_insertion_point(copy_constructor:hz_mq.basicCommonResponse)
 }
 
@@ -5251,6 +5751,7 @@ inline void basicCommonResponse::SharedCtor(
       decltype(_impl_.rid_){}
     , decltype(_impl_.cid_){}
     , decltype(_impl_.ok_){false}
+    , decltype(_impl_.compression_){false}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.rid_.InitDefault();
@@ -5290,7 +5791,9 @@ void basicCommonResponse::Clear() {
 
   _impl_.rid_.ClearToEmpty();
   _impl_.cid_.ClearToEmpty();
-  _impl_.ok_ = false;
+  ::memset(&_impl_.ok_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.compression_) -
+      reinterpret_cast<char*>(&_impl_.ok_)) + sizeof(_impl_.compression_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -5328,6 +5831,14 @@ const char* basicCommonResponse::_InternalParse(const char* ptr, ::_pbi::ParseCo
         } else
           goto handle_unusual;
         continue;
+      // bool compression = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.compression_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -5383,6 +5894,12 @@ uint8_t* basicCommonResponse::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteBoolToArray(3, this->_internal_ok(), target);
   }
 
+  // bool compression = 4;
+  if (this->_internal_compression() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(4, this->_internal_compression(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -5418,6 +5935,11 @@ size_t basicCommonResponse::ByteSizeLong() const {
     total_size += 1 + 1;
   }
 
+  // bool compression = 4;
+  if (this->_internal_compression() != 0) {
+    total_size += 1 + 1;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -5445,6 +5967,9 @@ void basicCommonResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, co
   if (from._internal_ok() != 0) {
     _this->_internal_set_ok(from._internal_ok());
   }
+  if (from._internal_compression() != 0) {
+    _this->_internal_set_compression(from._internal_compression());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -5472,13 +5997,18 @@ void basicCommonResponse::InternalSwap(basicCommonResponse* other) {
       &_impl_.cid_, lhs_arena,
       &other->_impl_.cid_, rhs_arena
   );
-  swap(_impl_.ok_, other->_impl_.ok_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(basicCommonResponse, _impl_.compression_)
+      + sizeof(basicCommonResponse::_impl_.compression_)
+      - PROTOBUF_FIELD_OFFSET(basicCommonResponse, _impl_.ok_)>(
+          reinterpret_cast<char*>(&_impl_.ok_),
+          reinterpret_cast<char*>(&other->_impl_.ok_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata basicCommonResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
-      file_level_metadata_protocol_2eproto[15]);
+      file_level_metadata_protocol_2eproto[16]);
 }
 
 // ===================================================================
@@ -5512,6 +6042,7 @@ basicConsumeResponse::basicConsumeResponse(const basicConsumeResponse& from)
     , decltype(_impl_.consumer_tag_){}
     , decltype(_impl_.body_){}
     , decltype(_impl_.properties_){nullptr}
+    , decltype(_impl_.delivery_tag_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -5542,6 +6073,7 @@ basicConsumeResponse::basicConsumeResponse(const basicConsumeResponse& from)
   if (from._internal_has_properties()) {
     _this->_impl_.properties_ = new ::hz_mq::BasicProperties(*from._impl_.properties_);
   }
+  _this->_impl_.delivery_tag_ = from._impl_.delivery_tag_;
   // @@protoc_insertion_point(copy_constructor:hz_mq.basicConsumeResponse)
 }
 
@@ -5554,6 +6086,7 @@ inline void basicConsumeResponse::SharedCtor(
     , decltype(_impl_.consumer_tag_){}
     , decltype(_impl_.body_){}
     , decltype(_impl_.properties_){nullptr}
+    , decltype(_impl_.delivery_tag_){uint64_t{0u}}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.cid_.InitDefault();
@@ -5604,6 +6137,7 @@ void basicConsumeResponse::Clear() {
     delete _impl_.properties_;
   }
   _impl_.properties_ = nullptr;
+  _impl_.delivery_tag_ = uint64_t{0u};
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -5633,13 +6167,12 @@ const char* basicConsumeResponse::_InternalParse(const char* ptr, ::_pbi::ParseC
         } else
           goto handle_unusual;
         continue;
-      // string body = 3;
+      // bytes body = 3;
       case 3:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
           auto str = _internal_mutable_body();
           ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
           CHK_(ptr);
-          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.basicConsumeResponse.body"));
         } else
           goto handle_unusual;
         continue;
@@ -5651,6 +6184,14 @@ const char* basicConsumeResponse::_InternalParse(const char* ptr, ::_pbi::ParseC
         } else
           goto handle_unusual;
         continue;
+      // uint64 delivery_tag = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.delivery_tag_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -5700,13 +6241,9 @@ uint8_t* basicConsumeResponse::_InternalSerialize(
         2, this->_internal_consumer_tag(), target);
   }
 
-  // string body = 3;
+  // bytes body = 3;
   if (!this->_internal_body().empty()) {
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      this->_internal_body().data(), static_cast<int>(this->_internal_body().length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "hz_mq.basicConsumeResponse.body");
-    target = stream->WriteStringMaybeAliased(
+    target = stream->WriteBytesMaybeAliased(
         3, this->_internal_body(), target);
   }
 
@@ -5717,6 +6254,12 @@ uint8_t* basicConsumeResponse::_InternalSerialize(
         _Internal::properties(this).GetCachedSize(), target, stream);
   }
 
+  // uint64 delivery_tag = 5;
+  if (this->_internal_delivery_tag() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(5, this->_internal_delivery_tag(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -5747,10 +6290,10 @@ size_t basicConsumeResponse::ByteSizeLong() const {
         this->_internal_consumer_tag());
   }
 
-  // string body = 3;
+  // bytes body = 3;
   if (!this->_internal_body().empty()) {
     total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
         this->_internal_body());
   }
 
@@ -5761,6 +6304,11 @@ size_t basicConsumeResponse::ByteSizeLong() const {
         *_impl_.properties_);
   }
 
+  // uint64 delivery_tag = 5;
+  if (this->_internal_delivery_tag() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_delivery_tag());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -5792,6 +6340,9 @@ void basicConsumeResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, c
     _this->_internal_mutable_properties()->::hz_mq::BasicProperties::MergeFrom(
         from._internal_properties());
   }
+  if (from._internal_delivery_tag() != 0) {
+    _this->_internal_set_delivery_tag(from._internal_delivery_tag());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -5823,13 +6374,18 @@ void basicConsumeResponse::InternalSwap(basicConsumeResponse* other) {
       &_impl_.body_, lhs_arena,
       &other->_impl_.body_, rhs_arena
   );
-  swap(_impl_.properties_, other->_impl_.properties_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(basicConsumeResponse, _impl_.delivery_tag_)
+      + sizeof(basicConsumeResponse::_impl_.delivery_tag_)
+      - PROTOBUF_FIELD_OFFSET(basicConsumeResponse, _impl_.properties_)>(
+          reinterpret_cast<char*>(&_impl_.properties_),
+          reinterpret_cast<char*>(&other->_impl_.properties_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata basicConsumeResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
-      file_level_metadata_protocol_2eproto[16]);
+      file_level_metadata_protocol_2eproto[17]);
 }
 
 // ===================================================================
@@ -5963,13 +6519,12 @@ const char* basicQueryResponse::_InternalParse(const char* ptr, ::_pbi::ParseCon
         } else
           goto handle_unusual;
         continue;
-      // string body = 3;
+      // bytes body = 3;
       case 3:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
           auto str = _internal_mutable_body();
           ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
           CHK_(ptr);
-          CHK_(::_pbi::VerifyUTF8(str, "hz_mq.basicQueryResponse.body"));
         } else
           goto handle_unusual;
         continue;
@@ -6022,13 +6577,9 @@ uint8_t* basicQueryResponse::_InternalSerialize(
         2, this->_internal_cid(), target);
   }
 
-  // string body = 3;
+  // bytes body = 3;
   if (!this->_internal_body().empty()) {
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      this->_internal_body().data(), static_cast<int>(this->_internal_body().length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "hz_mq.basicQueryResponse.body");
-    target = stream->WriteStringMaybeAliased(
+    target = stream->WriteBytesMaybeAliased(
         3, this->_internal_body(), target);
   }
 
@@ -6062,10 +6613,10 @@ size_t basicQueryResponse::ByteSizeLong() const {
         this->_internal_cid());
   }
 
-  // string body = 3;
+  // bytes body = 3;
   if (!this->_internal_body().empty()) {
     total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
         this->_internal_body());
   }
 
@@ -6132,7 +6683,7 @@ void basicQueryResponse::InternalSwap(basicQueryResponse* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata basicQueryResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
-      file_level_metadata_protocol_2eproto[17]);
+      file_level_metadata_protocol_2eproto[18]);
 }
 
 // ===================================================================
@@ -6335,7 +6886,7 @@ void heartbeatRequest::InternalSwap(heartbeatRequest* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata heartbeatRequest::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
-      file_level_metadata_protocol_2eproto[18]);
+      file_level_metadata_protocol_2eproto[19]);
 }
 
 // ===================================================================
@@ -6538,7 +7089,7 @@ void heartbeatResponse::InternalSwap(heartbeatResponse* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata heartbeatResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_protocol_2eproto_getter, &descriptor_table_protocol_2eproto_once,
-      file_level_metadata_protocol_2eproto[19]);
+      file_level_metadata_protocol_2eproto[20]);
 }
 
 // @@protoc_insertion_point(namespace_scope)
@@ -6592,6 +7143,10 @@ template<> PROTOBUF_NOINLINE ::hz_mq::basicAckRequest*
 Arena::CreateMaybeMessage< ::hz_mq::basicAckRequest >(Arena* arena) {
   return Arena::CreateMessageInternal< ::hz_mq::basicAckRequest >(arena);
 }
+template<> PROTOBUF_NOINLINE ::hz_mq::basicNackRequest*
+Arena::CreateMaybeMessage< ::hz_mq::basicNackRequest >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::hz_mq::basicNackRequest >(arena);
+}
 template<> PROTOBUF_NOINLINE ::hz_mq::basicConsumeRequest*
 Arena::CreateMaybeMessage< ::hz_mq::basicConsumeRequest >(Arena* arena) {
   return Arena::CreateMessageInternal< ::hz_mq::basicConsumeRequest >(arena);
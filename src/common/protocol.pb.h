@@ -65,6 +65,9 @@ extern basicConsumeRequestDefaultTypeInternal _basicConsumeRequest_default_insta
 class basicConsumeResponse;
 struct basicConsumeResponseDefaultTypeInternal;
 extern basicConsumeResponseDefaultTypeInternal _basicConsumeResponse_default_instance_;
+class basicNackRequest;
+struct basicNackRequestDefaultTypeInternal;
+extern basicNackRequestDefaultTypeInternal _basicNackRequest_default_instance_;
 class basicPublishRequest;
 struct basicPublishRequestDefaultTypeInternal;
 extern basicPublishRequestDefaultTypeInternal _basicPublishRequest_default_instance_;
@@ -117,6 +120,7 @@ template<> ::hz_mq::basicCancelRequest* Arena::CreateMaybeMessage<::hz_mq::basic
 template<> ::hz_mq::basicCommonResponse* Arena::CreateMaybeMessage<::hz_mq::basicCommonResponse>(Arena*);
 template<> ::hz_mq::basicConsumeRequest* Arena::CreateMaybeMessage<::hz_mq::basicConsumeRequest>(Arena*);
 template<> ::hz_mq::basicConsumeResponse* Arena::CreateMaybeMessage<::hz_mq::basicConsumeResponse>(Arena*);
+template<> ::hz_mq::basicNackRequest* Arena::CreateMaybeMessage<::hz_mq::basicNackRequest>(Arena*);
 template<> ::hz_mq::basicPublishRequest* Arena::CreateMaybeMessage<::hz_mq::basicPublishRequest>(Arena*);
 template<> ::hz_mq::basicQueryRequest* Arena::CreateMaybeMessage<::hz_mq::basicQueryRequest>(Arena*);
 template<> ::hz_mq::basicQueryResponse* Arena::CreateMaybeMessage<::hz_mq::basicQueryResponse>(Arena*);
@@ -286,6 +290,7 @@ class openChannelRequest final :
   enum : int {
     kRidFieldNumber = 1,
     kCidFieldNumber = 2,
+    kCompressionFieldNumber = 3,
   };
   // string rid = 1;
   void clear_rid();
@@ -315,6 +320,15 @@ class openChannelRequest final :
   std::string* _internal_mutable_cid();
   public:
 
+  // bool compression = 3;
+  void clear_compression();
+  bool compression() const;
+  void set_compression(bool value);
+  private:
+  bool _internal_compression() const;
+  void _internal_set_compression(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:hz_mq.openChannelRequest)
  private:
   class _Internal;
@@ -325,6 +339,7 @@ class openChannelRequest final :
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr rid_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr cid_;
+    bool compression_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -1959,6 +1974,7 @@ class basicPublishRequest final :
     kExchangeNameFieldNumber = 3,
     kBodyFieldNumber = 4,
     kPropertiesFieldNumber = 5,
+    kDelayMsFieldNumber = 6,
   };
   // string rid = 1;
   void clear_rid();
@@ -2002,7 +2018,7 @@ class basicPublishRequest final :
   std::string* _internal_mutable_exchange_name();
   public:
 
-  // string body = 4;
+  // bytes body = 4;
   void clear_body();
   const std::string& body() const;
   template <typename ArgT0 = const std::string&, typename... ArgT>
@@ -2034,6 +2050,15 @@ class basicPublishRequest final :
       ::hz_mq::BasicProperties* properties);
   ::hz_mq::BasicProperties* unsafe_arena_release_properties();
 
+  // uint64 delay_ms = 6;
+  void clear_delay_ms();
+  uint64_t delay_ms() const;
+  void set_delay_ms(uint64_t value);
+  private:
+  uint64_t _internal_delay_ms() const;
+  void _internal_set_delay_ms(uint64_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:hz_mq.basicPublishRequest)
  private:
   class _Internal;
@@ -2047,6 +2072,7 @@ class basicPublishRequest final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr exchange_name_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr body_;
     ::hz_mq::BasicProperties* properties_;
+    uint64_t delay_ms_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -2179,6 +2205,8 @@ class basicAckRequest final :
     kCidFieldNumber = 2,
     kQueueNameFieldNumber = 3,
     kMessageIdFieldNumber = 4,
+    kDeliveryTagFieldNumber = 5,
+    kMultipleFieldNumber = 6,
   };
   // string rid = 1;
   void clear_rid();
@@ -2236,6 +2264,24 @@ class basicAckRequest final :
   std::string* _internal_mutable_message_id();
   public:
 
+  // uint64 delivery_tag = 5;
+  void clear_delivery_tag();
+  uint64_t delivery_tag() const;
+  void set_delivery_tag(uint64_t value);
+  private:
+  uint64_t _internal_delivery_tag() const;
+  void _internal_set_delivery_tag(uint64_t value);
+  public:
+
+  // bool multiple = 6;
+  void clear_multiple();
+  bool multiple() const;
+  void set_multiple(bool value);
+  private:
+  bool _internal_multiple() const;
+  void _internal_set_multiple(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:hz_mq.basicAckRequest)
  private:
   class _Internal;
@@ -2248,6 +2294,210 @@ class basicAckRequest final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr cid_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr queue_name_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_id_;
+    uint64_t delivery_tag_;
+    bool multiple_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_protocol_2eproto;
+};
+// -------------------------------------------------------------------
+
+class basicNackRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:hz_mq.basicNackRequest) */ {
+ public:
+  inline basicNackRequest() : basicNackRequest(nullptr) {}
+  ~basicNackRequest() override;
+  explicit PROTOBUF_CONSTEXPR basicNackRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  basicNackRequest(const basicNackRequest& from);
+  basicNackRequest(basicNackRequest&& from) noexcept
+    : basicNackRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline basicNackRequest& operator=(const basicNackRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline basicNackRequest& operator=(basicNackRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const basicNackRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const basicNackRequest* internal_default_instance() {
+    return reinterpret_cast<const basicNackRequest*>(
+               &_basicNackRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    12;
+
+  friend void swap(basicNackRequest& a, basicNackRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(basicNackRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(basicNackRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  basicNackRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<basicNackRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const basicNackRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const basicNackRequest& from) {
+    basicNackRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(basicNackRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "hz_mq.basicNackRequest";
+  }
+  protected:
+  explicit basicNackRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kRidFieldNumber = 1,
+    kCidFieldNumber = 2,
+    kDeliveryTagFieldNumber = 3,
+    kMultipleFieldNumber = 4,
+    kRequeueFieldNumber = 5,
+  };
+  // string rid = 1;
+  void clear_rid();
+  const std::string& rid() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_rid(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_rid();
+  PROTOBUF_NODISCARD std::string* release_rid();
+  void set_allocated_rid(std::string* rid);
+  private:
+  const std::string& _internal_rid() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_rid(const std::string& value);
+  std::string* _internal_mutable_rid();
+  public:
+
+  // string cid = 2;
+  void clear_cid();
+  const std::string& cid() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_cid(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_cid();
+  PROTOBUF_NODISCARD std::string* release_cid();
+  void set_allocated_cid(std::string* cid);
+  private:
+  const std::string& _internal_cid() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_cid(const std::string& value);
+  std::string* _internal_mutable_cid();
+  public:
+
+  // uint64 delivery_tag = 3;
+  void clear_delivery_tag();
+  uint64_t delivery_tag() const;
+  void set_delivery_tag(uint64_t value);
+  private:
+  uint64_t _internal_delivery_tag() const;
+  void _internal_set_delivery_tag(uint64_t value);
+  public:
+
+  // bool multiple = 4;
+  void clear_multiple();
+  bool multiple() const;
+  void set_multiple(bool value);
+  private:
+  bool _internal_multiple() const;
+  void _internal_set_multiple(bool value);
+  public:
+
+  // bool requeue = 5;
+  void clear_requeue();
+  bool requeue() const;
+  void set_requeue(bool value);
+  private:
+  bool _internal_requeue() const;
+  void _internal_set_requeue(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:hz_mq.basicNackRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr rid_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr cid_;
+    uint64_t delivery_tag_;
+    bool multiple_;
+    bool requeue_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -2303,7 +2553,7 @@ class basicConsumeRequest final :
                &_basicConsumeRequest_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    12;
+    13;
 
   friend void swap(basicConsumeRequest& a, basicConsumeRequest& b) {
     a.Swap(&b);
@@ -2515,7 +2765,7 @@ class basicCancelRequest final :
                &_basicCancelRequest_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    13;
+    14;
 
   friend void swap(basicCancelRequest& a, basicCancelRequest& b) {
     a.Swap(&b);
@@ -2716,7 +2966,7 @@ class basicQueryRequest final :
                &_basicQueryRequest_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    14;
+    15;
 
   friend void swap(basicQueryRequest& a, basicQueryRequest& b) {
     a.Swap(&b);
@@ -2885,7 +3135,7 @@ class basicCommonResponse final :
                &_basicCommonResponse_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    15;
+    16;
 
   friend void swap(basicCommonResponse& a, basicCommonResponse& b) {
     a.Swap(&b);
@@ -2961,6 +3211,7 @@ class basicCommonResponse final :
     kRidFieldNumber = 1,
     kCidFieldNumber = 2,
     kOkFieldNumber = 3,
+    kCompressionFieldNumber = 4,
   };
   // string rid = 1;
   void clear_rid();
@@ -2999,6 +3250,15 @@ class basicCommonResponse final :
   void _internal_set_ok(bool value);
   public:
 
+  // bool compression = 4;
+  void clear_compression();
+  bool compression() const;
+  void set_compression(bool value);
+  private:
+  bool _internal_compression() const;
+  void _internal_set_compression(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:hz_mq.basicCommonResponse)
  private:
   class _Internal;
@@ -3010,6 +3270,7 @@ class basicCommonResponse final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr rid_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr cid_;
     bool ok_;
+    bool compression_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -3065,7 +3326,7 @@ class basicConsumeResponse final :
                &_basicConsumeResponse_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    16;
+    17;
 
   friend void swap(basicConsumeResponse& a, basicConsumeResponse& b) {
     a.Swap(&b);
@@ -3142,6 +3403,7 @@ class basicConsumeResponse final :
     kConsumerTagFieldNumber = 2,
     kBodyFieldNumber = 3,
     kPropertiesFieldNumber = 4,
+    kDeliveryTagFieldNumber = 5,
   };
   // string cid = 1;
   void clear_cid();
@@ -3171,7 +3433,7 @@ class basicConsumeResponse final :
   std::string* _internal_mutable_consumer_tag();
   public:
 
-  // string body = 3;
+  // bytes body = 3;
   void clear_body();
   const std::string& body() const;
   template <typename ArgT0 = const std::string&, typename... ArgT>
@@ -3203,6 +3465,15 @@ class basicConsumeResponse final :
       ::hz_mq::BasicProperties* properties);
   ::hz_mq::BasicProperties* unsafe_arena_release_properties();
 
+  // uint64 delivery_tag = 5;
+  void clear_delivery_tag();
+  uint64_t delivery_tag() const;
+  void set_delivery_tag(uint64_t value);
+  private:
+  uint64_t _internal_delivery_tag() const;
+  void _internal_set_delivery_tag(uint64_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:hz_mq.basicConsumeResponse)
  private:
   class _Internal;
@@ -3215,6 +3486,7 @@ class basicConsumeResponse final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr consumer_tag_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr body_;
     ::hz_mq::BasicProperties* properties_;
+    uint64_t delivery_tag_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -3270,7 +3542,7 @@ class basicQueryResponse final :
                &_basicQueryResponse_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    17;
+    18;
 
   friend void swap(basicQueryResponse& a, basicQueryResponse& b) {
     a.Swap(&b);
@@ -3375,7 +3647,7 @@ class basicQueryResponse final :
   std::string* _internal_mutable_cid();
   public:
 
-  // string body = 3;
+  // bytes body = 3;
   void clear_body();
   const std::string& body() const;
   template <typename ArgT0 = const std::string&, typename... ArgT>
@@ -3455,7 +3727,7 @@ class heartbeatRequest final :
                &_heartbeatRequest_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    18;
+    19;
 
   friend void swap(heartbeatRequest& a, heartbeatRequest& b) {
     a.Swap(&b);
@@ -3608,7 +3880,7 @@ class heartbeatResponse final :
                &_heartbeatResponse_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    19;
+    20;
 
   friend void swap(heartbeatResponse& a, heartbeatResponse& b) {
     a.Swap(&b);
@@ -3822,6 +4094,26 @@ inline void openChannelRequest::set_allocated_cid(std::string* cid) {
   // @@protoc_insertion_point(field_set_allocated:hz_mq.openChannelRequest.cid)
 }
 
+// bool compression = 3;
+inline void openChannelRequest::clear_compression() {
+  _impl_.compression_ = false;
+}
+inline bool openChannelRequest::_internal_compression() const {
+  return _impl_.compression_;
+}
+inline bool openChannelRequest::compression() const {
+  // @@protoc_insertion_point(field_get:hz_mq.openChannelRequest.compression)
+  return _internal_compression();
+}
+inline void openChannelRequest::_internal_set_compression(bool value) {
+  
+  _impl_.compression_ = value;
+}
+inline void openChannelRequest::set_compression(bool value) {
+  _internal_set_compression(value);
+  // @@protoc_insertion_point(field_set:hz_mq.openChannelRequest.compression)
+}
+
 // -------------------------------------------------------------------
 
 // closeChannelRequest
@@ -5336,7 +5628,7 @@ inline void basicPublishRequest::set_allocated_exchange_name(std::string* exchan
   // @@protoc_insertion_point(field_set_allocated:hz_mq.basicPublishRequest.exchange_name)
 }
 
-// string body = 4;
+// bytes body = 4;
 inline void basicPublishRequest::clear_body() {
   _impl_.body_.ClearToEmpty();
 }
@@ -5348,7 +5640,7 @@ template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
 void basicPublishRequest::set_body(ArgT0&& arg0, ArgT... args) {
  
- _impl_.body_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+ _impl_.body_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:hz_mq.basicPublishRequest.body)
 }
 inline std::string* basicPublishRequest::mutable_body() {
@@ -5471,6 +5763,26 @@ inline void basicPublishRequest::set_allocated_properties(::hz_mq::BasicProperti
   // @@protoc_insertion_point(field_set_allocated:hz_mq.basicPublishRequest.properties)
 }
 
+// uint64 delay_ms = 6;
+inline void basicPublishRequest::clear_delay_ms() {
+  _impl_.delay_ms_ = uint64_t{0u};
+}
+inline uint64_t basicPublishRequest::_internal_delay_ms() const {
+  return _impl_.delay_ms_;
+}
+inline uint64_t basicPublishRequest::delay_ms() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicPublishRequest.delay_ms)
+  return _internal_delay_ms();
+}
+inline void basicPublishRequest::_internal_set_delay_ms(uint64_t value) {
+  
+  _impl_.delay_ms_ = value;
+}
+inline void basicPublishRequest::set_delay_ms(uint64_t value) {
+  _internal_set_delay_ms(value);
+  // @@protoc_insertion_point(field_set:hz_mq.basicPublishRequest.delay_ms)
+}
+
 // -------------------------------------------------------------------
 
 // basicAckRequest
@@ -5675,6 +5987,210 @@ inline void basicAckRequest::set_allocated_message_id(std::string* message_id) {
   // @@protoc_insertion_point(field_set_allocated:hz_mq.basicAckRequest.message_id)
 }
 
+// uint64 delivery_tag = 5;
+inline void basicAckRequest::clear_delivery_tag() {
+  _impl_.delivery_tag_ = uint64_t{0u};
+}
+inline uint64_t basicAckRequest::_internal_delivery_tag() const {
+  return _impl_.delivery_tag_;
+}
+inline uint64_t basicAckRequest::delivery_tag() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicAckRequest.delivery_tag)
+  return _internal_delivery_tag();
+}
+inline void basicAckRequest::_internal_set_delivery_tag(uint64_t value) {
+  
+  _impl_.delivery_tag_ = value;
+}
+inline void basicAckRequest::set_delivery_tag(uint64_t value) {
+  _internal_set_delivery_tag(value);
+  // @@protoc_insertion_point(field_set:hz_mq.basicAckRequest.delivery_tag)
+}
+
+// bool multiple = 6;
+inline void basicAckRequest::clear_multiple() {
+  _impl_.multiple_ = false;
+}
+inline bool basicAckRequest::_internal_multiple() const {
+  return _impl_.multiple_;
+}
+inline bool basicAckRequest::multiple() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicAckRequest.multiple)
+  return _internal_multiple();
+}
+inline void basicAckRequest::_internal_set_multiple(bool value) {
+  
+  _impl_.multiple_ = value;
+}
+inline void basicAckRequest::set_multiple(bool value) {
+  _internal_set_multiple(value);
+  // @@protoc_insertion_point(field_set:hz_mq.basicAckRequest.multiple)
+}
+
+// -------------------------------------------------------------------
+
+// basicNackRequest
+
+// string rid = 1;
+inline void basicNackRequest::clear_rid() {
+  _impl_.rid_.ClearToEmpty();
+}
+inline const std::string& basicNackRequest::rid() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicNackRequest.rid)
+  return _internal_rid();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void basicNackRequest::set_rid(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.rid_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:hz_mq.basicNackRequest.rid)
+}
+inline std::string* basicNackRequest::mutable_rid() {
+  std::string* _s = _internal_mutable_rid();
+  // @@protoc_insertion_point(field_mutable:hz_mq.basicNackRequest.rid)
+  return _s;
+}
+inline const std::string& basicNackRequest::_internal_rid() const {
+  return _impl_.rid_.Get();
+}
+inline void basicNackRequest::_internal_set_rid(const std::string& value) {
+  
+  _impl_.rid_.Set(value, GetArenaForAllocation());
+}
+inline std::string* basicNackRequest::_internal_mutable_rid() {
+  
+  return _impl_.rid_.Mutable(GetArenaForAllocation());
+}
+inline std::string* basicNackRequest::release_rid() {
+  // @@protoc_insertion_point(field_release:hz_mq.basicNackRequest.rid)
+  return _impl_.rid_.Release();
+}
+inline void basicNackRequest::set_allocated_rid(std::string* rid) {
+  if (rid != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.rid_.SetAllocated(rid, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.rid_.IsDefault()) {
+    _impl_.rid_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:hz_mq.basicNackRequest.rid)
+}
+
+// string cid = 2;
+inline void basicNackRequest::clear_cid() {
+  _impl_.cid_.ClearToEmpty();
+}
+inline const std::string& basicNackRequest::cid() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicNackRequest.cid)
+  return _internal_cid();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void basicNackRequest::set_cid(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.cid_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:hz_mq.basicNackRequest.cid)
+}
+inline std::string* basicNackRequest::mutable_cid() {
+  std::string* _s = _internal_mutable_cid();
+  // @@protoc_insertion_point(field_mutable:hz_mq.basicNackRequest.cid)
+  return _s;
+}
+inline const std::string& basicNackRequest::_internal_cid() const {
+  return _impl_.cid_.Get();
+}
+inline void basicNackRequest::_internal_set_cid(const std::string& value) {
+  
+  _impl_.cid_.Set(value, GetArenaForAllocation());
+}
+inline std::string* basicNackRequest::_internal_mutable_cid() {
+  
+  return _impl_.cid_.Mutable(GetArenaForAllocation());
+}
+inline std::string* basicNackRequest::release_cid() {
+  // @@protoc_insertion_point(field_release:hz_mq.basicNackRequest.cid)
+  return _impl_.cid_.Release();
+}
+inline void basicNackRequest::set_allocated_cid(std::string* cid) {
+  if (cid != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.cid_.SetAllocated(cid, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.cid_.IsDefault()) {
+    _impl_.cid_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:hz_mq.basicNackRequest.cid)
+}
+
+// uint64 delivery_tag = 3;
+inline void basicNackRequest::clear_delivery_tag() {
+  _impl_.delivery_tag_ = uint64_t{0u};
+}
+inline uint64_t basicNackRequest::_internal_delivery_tag() const {
+  return _impl_.delivery_tag_;
+}
+inline uint64_t basicNackRequest::delivery_tag() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicNackRequest.delivery_tag)
+  return _internal_delivery_tag();
+}
+inline void basicNackRequest::_internal_set_delivery_tag(uint64_t value) {
+  
+  _impl_.delivery_tag_ = value;
+}
+inline void basicNackRequest::set_delivery_tag(uint64_t value) {
+  _internal_set_delivery_tag(value);
+  // @@protoc_insertion_point(field_set:hz_mq.basicNackRequest.delivery_tag)
+}
+
+// bool multiple = 4;
+inline void basicNackRequest::clear_multiple() {
+  _impl_.multiple_ = false;
+}
+inline bool basicNackRequest::_internal_multiple() const {
+  return _impl_.multiple_;
+}
+inline bool basicNackRequest::multiple() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicNackRequest.multiple)
+  return _internal_multiple();
+}
+inline void basicNackRequest::_internal_set_multiple(bool value) {
+  
+  _impl_.multiple_ = value;
+}
+inline void basicNackRequest::set_multiple(bool value) {
+  _internal_set_multiple(value);
+  // @@protoc_insertion_point(field_set:hz_mq.basicNackRequest.multiple)
+}
+
+// bool requeue = 5;
+inline void basicNackRequest::clear_requeue() {
+  _impl_.requeue_ = false;
+}
+inline bool basicNackRequest::_internal_requeue() const {
+  return _impl_.requeue_;
+}
+inline bool basicNackRequest::requeue() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicNackRequest.requeue)
+  return _internal_requeue();
+}
+inline void basicNackRequest::_internal_set_requeue(bool value) {
+  
+  _impl_.requeue_ = value;
+}
+inline void basicNackRequest::set_requeue(bool value) {
+  _internal_set_requeue(value);
+  // @@protoc_insertion_point(field_set:hz_mq.basicNackRequest.requeue)
+}
+
 // -------------------------------------------------------------------
 
 // basicConsumeRequest
@@ -6331,6 +6847,26 @@ inline void basicCommonResponse::set_ok(bool value) {
   // @@protoc_insertion_point(field_set:hz_mq.basicCommonResponse.ok)
 }
 
+// bool compression = 4;
+inline void basicCommonResponse::clear_compression() {
+  _impl_.compression_ = false;
+}
+inline bool basicCommonResponse::_internal_compression() const {
+  return _impl_.compression_;
+}
+inline bool basicCommonResponse::compression() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicCommonResponse.compression)
+  return _internal_compression();
+}
+inline void basicCommonResponse::_internal_set_compression(bool value) {
+  
+  _impl_.compression_ = value;
+}
+inline void basicCommonResponse::set_compression(bool value) {
+  _internal_set_compression(value);
+  // @@protoc_insertion_point(field_set:hz_mq.basicCommonResponse.compression)
+}
+
 // -------------------------------------------------------------------
 
 // basicConsumeResponse
@@ -6435,7 +6971,7 @@ inline void basicConsumeResponse::set_allocated_consumer_tag(std::string* consum
   // @@protoc_insertion_point(field_set_allocated:hz_mq.basicConsumeResponse.consumer_tag)
 }
 
-// string body = 3;
+// bytes body = 3;
 inline void basicConsumeResponse::clear_body() {
   _impl_.body_.ClearToEmpty();
 }
@@ -6447,7 +6983,7 @@ template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
 void basicConsumeResponse::set_body(ArgT0&& arg0, ArgT... args) {
  
- _impl_.body_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+ _impl_.body_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:hz_mq.basicConsumeResponse.body)
 }
 inline std::string* basicConsumeResponse::mutable_body() {
@@ -6570,6 +7106,26 @@ inline void basicConsumeResponse::set_allocated_properties(::hz_mq::BasicPropert
   // @@protoc_insertion_point(field_set_allocated:hz_mq.basicConsumeResponse.properties)
 }
 
+// uint64 delivery_tag = 5;
+inline void basicConsumeResponse::clear_delivery_tag() {
+  _impl_.delivery_tag_ = uint64_t{0u};
+}
+inline uint64_t basicConsumeResponse::_internal_delivery_tag() const {
+  return _impl_.delivery_tag_;
+}
+inline uint64_t basicConsumeResponse::delivery_tag() const {
+  // @@protoc_insertion_point(field_get:hz_mq.basicConsumeResponse.delivery_tag)
+  return _internal_delivery_tag();
+}
+inline void basicConsumeResponse::_internal_set_delivery_tag(uint64_t value) {
+  
+  _impl_.delivery_tag_ = value;
+}
+inline void basicConsumeResponse::set_delivery_tag(uint64_t value) {
+  _internal_set_delivery_tag(value);
+  // @@protoc_insertion_point(field_set:hz_mq.basicConsumeResponse.delivery_tag)
+}
+
 // -------------------------------------------------------------------
 
 // basicQueryResponse
@@ -6674,7 +7230,7 @@ inline void basicQueryResponse::set_allocated_cid(std::string* cid) {
   // @@protoc_insertion_point(field_set_allocated:hz_mq.basicQueryResponse.cid)
 }
 
-// string body = 3;
+// bytes body = 3;
 inline void basicQueryResponse::clear_body() {
   _impl_.body_.ClearToEmpty();
 }
@@ -6686,7 +7242,7 @@ template <typename ArgT0, typename... ArgT>
 inline PROTOBUF_ALWAYS_INLINE
 void basicQueryResponse::set_body(ArgT0&& arg0, ArgT... args) {
  
- _impl_.body_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+ _impl_.body_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:hz_mq.basicQueryResponse.body)
 }
 inline std::string* basicQueryResponse::mutable_body() {
@@ -6873,6 +7429,8 @@ inline void heartbeatResponse::set_allocated_rid(std::string* rid) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
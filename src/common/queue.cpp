@@ -41,25 +41,49 @@ std::string msg_queue::get_args() const
 }
 
 // ---------- msg_queue_mapper ----------
+// 存储格式：key = 队列名，value = "durable|exclusive|auto_delete|args"
 msg_queue_mapper::msg_queue_mapper(const std::string& dbfile)
+    : __store(meta_store::open(dbfile))
 {
-    (void)dbfile; // 真实环境可在此打开 DB、建表等
 }
 
 bool msg_queue_mapper::insert(msg_queue::ptr& q)
 {
-    (void)q;
+    std::string value = std::string(q->durable ? "1" : "0") + "|" +
+                        (q->exclusive ? "1" : "0") + "|" +
+                        (q->auto_delete ? "1" : "0") + "|" +
+                        q->get_args();
+    __store->put(meta_kind::QUEUE, q->name, value);
     return true;
 }
 
 void msg_queue_mapper::remove(const std::string& name)
 {
-    (void)name;
+    __store->erase(meta_kind::QUEUE, name);
 }
 
 queue_map msg_queue_mapper::all()
 {
-    return {}; // 示例：启动时无持久化数据
+    queue_map result;
+    for (const auto& [name, value] : __store->all(meta_kind::QUEUE)) {
+        if (value.size() < 6 || value[1] != '|' || value[3] != '|' || value[5] != '|')
+            continue;
+
+        auto q = std::make_shared<msg_queue>();
+        q->name        = name;
+        q->durable     = value[0] == '1';
+        q->exclusive   = value[2] == '1';
+        q->auto_delete = value[4] == '1';
+        q->set_args(value.substr(6));
+        result[name] = std::move(q);
+    }
+    return result;
+}
+
+bool valid_queue_name(const std::string& name)
+{
+    if (name.empty() || name == "." || name == "..") return false;
+    return name.find_first_of(std::string("/\0", 2)) == std::string::npos;
 }
 
 // ---------- msg_queue_manager ----------
@@ -67,12 +91,14 @@ msg_queue_manager::msg_queue_manager(const std::string& dbfile)
     : __mapper(dbfile)
 {
     __msg_queues = __mapper.all();
+    std::erase_if(__msg_queues, [](const auto& kv) { return !valid_queue_name(kv.first); });
 }
 
 bool msg_queue_manager::declare_queue(const std::string& qname, bool qdurable,
                                       bool qexclusive, bool qauto_delete,
                                       const std::unordered_map<std::string, std::string>& qargs)
 {
+    if (!valid_queue_name(qname)) return false;
     std::unique_lock<std::mutex> lock(__mtx);
 
     if (__msg_queues.contains(qname)) return true; // 已存在
@@ -6,6 +6,8 @@
 #include <mutex>
 #include <memory>
 
+#include "meta_store.hpp"
+
 namespace hz_mq {
 
 // ---------- 队列元数据 ----------
@@ -27,16 +29,23 @@ struct msg_queue {
     [[nodiscard]] std::string get_args() const;
 };
 
+// 队列名直接用作 <base_dir>/<队列名> 目录名：拒绝空名、"." / ".."、含 '/' 或 '\0' 的名字，
+// 否则删除队列时 remove_all 会越出数据目录
+bool valid_queue_name(const std::string& name);
+
 // 队列名 → 元数据
 using queue_map = std::unordered_map<std::string, msg_queue::ptr>;
 
-// ---------- 持久化映射层（示例省略真实持久化） ----------
+// ---------- 持久化映射层（落到 meta_store：WAL + 快照） ----------
 class msg_queue_mapper {
 public:
     explicit msg_queue_mapper(const std::string& dbfile);
     bool insert(msg_queue::ptr& q);
     void remove(const std::string& name);
     queue_map all();
+
+private:
+    meta_store::ptr __store;
 };
 
 // ---------- 内存队列管理器 ----------
@@ -21,6 +21,7 @@
 #include "consumer.hpp"
 #include "connection.hpp"
 #include "route.hpp"
+#include "../common/metrics.hpp"
 
 namespace hz_mq {
 
@@ -41,7 +42,11 @@ BrokerServer::BrokerServer(int port, const std::string& base_dir)
 
     // 2. 虚拟主机 & 管理器 -----------------------------------------------------
     std::string db_path = base_dir + DBFILE_PATH;
-    __virtual_host       = std::make_shared<virtual_host>(HOST_NAME, base_dir, db_path);
+    virtual_host::options host_opts;
+    host_opts.commit.window          = std::chrono::microseconds(GROUP_COMMIT_WINDOW_US);
+    host_opts.commit.max_batch_bytes = GROUP_COMMIT_MAX_BYTES;
+    host_opts.expiry.tick            = std::chrono::milliseconds(EXPIRY_TICK_MS);
+    __virtual_host       = std::make_shared<virtual_host>(HOST_NAME, base_dir, db_path, host_opts);
     __consumer_manager   = std::make_shared<consumer_manager>();
     __connection_manager = std::make_shared<connection_manager>();
     __thread_pool        = std::make_shared<thread_pool>();
@@ -51,6 +56,14 @@ BrokerServer::BrokerServer(int port, const std::string& base_dir)
         __consumer_manager->init_queue_consumer(qname);
     }
 
+    // 延迟消息到期入队时没有发布方通道，由这里派发消费任务给该队列的消费者
+    __virtual_host->set_ready_callback([this](const std::string& qname) {
+        __thread_pool->push([this, qname] {
+            consumer::ptr cp = __consumer_manager->choose(qname);
+            if (cp && cp->pull) cp->pull(*cp);
+        });
+    });
+
     // 4. 注册回调 --------------------------------------------------------------
 #define REG(msgType, handler) \
     __dispatcher->registerMessageCallback<msgType>( std::bind(handler, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3) )
@@ -65,6 +78,7 @@ BrokerServer::BrokerServer(int port, const std::string& base_dir)
     REG(unbindRequest,           &BrokerServer::on_unbind);
     REG(basicPublishRequest,     &BrokerServer::on_basicPublish);
     REG(basicAckRequest,         &BrokerServer::on_basicAck);
+    REG(basicNackRequest,        &BrokerServer::on_basicNack);
     REG(basicConsumeRequest,     &BrokerServer::on_basicConsume);
     REG(basicCancelRequest,      &BrokerServer::on_basicCancel);
     REG(basicQueryRequest,       &BrokerServer::on_basicQuery);
@@ -78,6 +92,15 @@ BrokerServer::BrokerServer(int port, const std::string& base_dir)
     __loop->runEvery(5.0, [this]() {
         __connection_manager->check_timeout(std::chrono::seconds(30));
     });
+
+    // 消息过期由事件循环驱动时间轮，每格只处理到期的定时器
+    __loop->runEvery(EXPIRY_TICK_MS / 1000.0, [this]() {
+        __virtual_host->expire_tick();
+    });
+
+    __loop->runEvery(METRICS_REPORT_INTERVAL, []() {
+        LOG(INFO) << "metrics:\n" << metrics::instance().dump();
+    });
 }
 
 // -----------------------------------------------------------------------------
@@ -252,6 +275,15 @@ void BrokerServer::on_basicAck(const muduo::net::TcpConnectionPtr& conn, const b
     ch->basic_ack(msg);
 }
 
+void BrokerServer::on_basicNack(const muduo::net::TcpConnectionPtr& conn, const basicNackRequestPtr& msg, muduo::Timestamp ts)
+{
+    (void)ts;
+    GET_CONN_CTX();
+    GET_CHANNEL(msg->cid());
+    LOG_REQ(basicNackRequest);
+    ch->basic_nack(msg);
+}
+
 void BrokerServer::on_basicConsume(const muduo::net::TcpConnectionPtr& conn, const basicConsumeRequestPtr& msg, muduo::Timestamp ts)
 {
     (void)ts;
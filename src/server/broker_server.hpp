@@ -45,6 +45,7 @@ using bindRequestPtr           = std::shared_ptr<bindRequest>;
 using unbindRequestPtr         = std::shared_ptr<unbindRequest>;
 using basicPublishRequestPtr   = std::shared_ptr<basicPublishRequest>;
 using basicAckRequestPtr       = std::shared_ptr<basicAckRequest>;
+using basicNackRequestPtr      = std::shared_ptr<basicNackRequest>;
 using basicConsumeRequestPtr   = std::shared_ptr<basicConsumeRequest>;
 using basicCancelRequestPtr    = std::shared_ptr<basicCancelRequest>;
 using basicQueryRequestPtr     = std::shared_ptr<basicQueryRequest>;
@@ -54,6 +55,10 @@ using MessagePtr               = std::shared_ptr<::google::protobuf::Message>;
 // 常量 -------------------------------------------------------------
 inline constexpr const char* DBFILE_PATH = "/meta.db";
 inline constexpr const char* HOST_NAME   = "MyVirtualHost";
+inline constexpr int GROUP_COMMIT_WINDOW_US      = 2000;        // 持久化批提交窗口
+inline constexpr int GROUP_COMMIT_MAX_BYTES      = 1 << 20;     // 攒够即提交的字节数
+inline constexpr double METRICS_REPORT_INTERVAL  = 60.0;        // 指标打印间隔（秒）
+inline constexpr int EXPIRY_TICK_MS              = 10;          // 消息过期时间轮一格（毫秒）
 
 // ================================================================
 // BrokerServer : 启动 TCP 服务、分发 Protobuf 消息、维护核心管理器
@@ -87,6 +92,7 @@ private:
     void on_unbind        (const muduo::net::TcpConnectionPtr&, const unbindRequestPtr&,         muduo::Timestamp);
     void on_basicPublish  (const muduo::net::TcpConnectionPtr&, const basicPublishRequestPtr&,   muduo::Timestamp);
     void on_basicAck      (const muduo::net::TcpConnectionPtr&, const basicAckRequestPtr&,       muduo::Timestamp);
+    void on_basicNack     (const muduo::net::TcpConnectionPtr&, const basicNackRequestPtr&,      muduo::Timestamp);
     void on_basicConsume  (const muduo::net::TcpConnectionPtr&, const basicConsumeRequestPtr&,   muduo::Timestamp);
     void on_basicCancel   (const muduo::net::TcpConnectionPtr&, const basicCancelRequestPtr&,    muduo::Timestamp);
     void on_basicQuery    (const muduo::net::TcpConnectionPtr&, const basicQueryRequestPtr&,     muduo::Timestamp);
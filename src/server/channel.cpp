@@ -8,12 +8,33 @@
 #include "muduo/protoc/codec.h"             
 #include "../common/logger.hpp"    // 日志
 #include "../common/message.hpp"   // message_ptr
+#include "consume_frame.hpp"         // 直接编码投递帧
+#include "../common/compress.hpp"    // 消息体压缩
+
+#include <muduo/net/Buffer.h>
+#include <muduo/net/EventLoop.h>
+#include <muduo/net/TcpConnection.h>
+
+#include <google/protobuf/arena.h>
+#include <set>
 
 #include <functional>
 #include <utility>
 
 namespace hz_mq {
 
+// 投递路径上的 protobuf 对象（出队的 Message、投递帧头部）分配在 Arena 上，
+// Arena 的初始块就是这块栈内存：一条消息处理完整体释放，常规大小的属性不再触发堆分配
+static constexpr size_t DELIVERY_ARENA_BYTES = 1024;
+
+static google::protobuf::ArenaOptions stack_arena(char* block, size_t size)
+{
+    google::protobuf::ArenaOptions opts;
+    opts.initial_block      = block;
+    opts.initial_block_size = size;
+    return opts;
+}
+
 // -----------------------------------------------------------------------------
 // 构造 / 析构
 // -----------------------------------------------------------------------------
@@ -22,8 +43,10 @@ channel::channel(const std::string& cid,
                  const consumer_manager::ptr& cmp,
                  const ProtobufCodecPtr& codec,
                  const muduo::net::TcpConnectionPtr conn,
-                 const thread_pool::ptr& pool)
-    : __cid(cid), __conn(conn), __codec(codec), __cmp(cmp), __host(host), __pool(pool)
+                 const thread_pool::ptr& pool,
+                 bool compression)
+    : __cid(cid), __conn(conn), __codec(codec), __cmp(cmp), __host(host), __pool(pool),
+      __compression(compression)
 {
     // 初始没有 consumer
 }
@@ -33,6 +56,14 @@ channel::~channel()
     if (__consumer) {
         __cmp->remove(__consumer->tag, __consumer->qname);
     }
+    // 通道关闭时未确认的投递全部退回队首（倒序退回保持原顺序）；
+    // 析构中不能 shared_from_this，经 ready 回调为每个涉及的队列派发一次，空闲队列上的消息不会卡住
+    std::set<std::string> requeued;
+    for (auto it = __unacked.rbegin(); it != __unacked.rend(); ++it) {
+        if (__host->basic_reject(it->second.qname, it->second.inflight, true))
+            requeued.insert(it->second.qname);
+    }
+    for (const auto& qname : requeued) __host->notify_ready(qname);
 }
 
 // -----------------------------------------------------------------------------
@@ -47,43 +78,121 @@ void channel::basic_response(bool ok, const std::string& rid, const std::string&
     __codec->send(__conn, resp);
 }
 
+void channel::dispatch(const std::string& qname)
+{
+    __pool->push([self = shared_from_this(), qname] { self->consume(qname); });
+}
+
 void channel::consume(const std::string& qname)
 {
-    // 1. 取出消息
+    // 1. 先选消费者：没有消费者时消息留在队列
+    consumer::ptr cp = __cmp->choose(qname);
+    if (!cp) {
+        LOG(ERROR) << "consume task: no consumer for queue [" << qname << "]" ;
+        return;
+    }
+    // 2. 由消费者所属通道取消息并投递
+    if (cp->pull) {
+        cp->pull(*cp);
+        return;
+    }
+    // 3. 进程内消费者：出队即确认
     message_ptr mp = __host->basic_consume(qname);
     if (!mp) {
         LOG(ERROR) << "consume task: no message in queue [" << qname << "]"  ;
         return;
     }
-    // 2. 选消费者
-    consumer::ptr cp = __cmp->choose(qname);
-    if (!cp) {
-        LOG(ERROR) << "consume task: no consumer for queue [" << qname << "]" ;
+    cp->callback(cp->tag, mp->mutable_payload()->mutable_properties(), mp->payload().body());
+}
+
+void channel::deliver(const consumer& c)
+{
+    // 自动确认直接出队；手动确认移入队列的 unacked 集合，等 basicAck / basicNack。
+    // 扇出共享的消息体只拿引用，直接从共享缓冲编码投递帧
+    uint64_t    inflight = 0;
+    shared_body shared;
+    alignas(8) char block[DELIVERY_ARENA_BYTES];
+    google::protobuf::Arena arena(stack_arena(block, sizeof block));
+    auto* mp = google::protobuf::Arena::CreateMessage<Message>(&arena);
+    bool  got = c.auto_ack ? __host->basic_consume(c.qname, *mp, &shared)
+                           : __host->basic_get(c.qname, inflight, *mp, &shared);
+    if (!got) {
+        LOG(ERROR) << "consume task: no message in queue [" << c.qname << "]"  ;
         return;
     }
-    // 3. 调用回调投递消息
-    cp->callback(cp->tag, mp->mutable_payload()->mutable_properties(), mp->payload().body());
-    // 4. 自动 ack
-    if (cp->auto_ack) {
-        __host->basic_ack(qname, mp->payload().properties().id());
+
+    uint64_t tag;
+    {
+        std::unique_lock<std::mutex> lock(__ack_mtx);
+        tag = ++__next_tag;
+        if (!c.auto_ack)
+            __unacked.emplace(tag, unacked_delivery{c.qname, inflight, mp->payload().properties().id()});
     }
+    consume_cb(c.tag, mp->mutable_payload()->mutable_properties(),
+               shared ? *shared : mp->payload().body(), tag);
+}
+
+std::vector<channel::unacked_delivery> channel::take_unacked(uint64_t tag, bool multiple)
+{
+    std::vector<unacked_delivery> out;
+    std::unique_lock<std::mutex> lock(__ack_mtx);
+    auto last = __unacked.upper_bound(tag);
+    auto first = multiple ? __unacked.begin() : __unacked.find(tag);
+    if (first == __unacked.end()) return out;
+    for (auto it = first; it != last; ++it) out.push_back(std::move(it->second));
+    __unacked.erase(first, last);
+    return out;
 }
 
 void channel::consume_cb(const std::string& tag,
                          const BasicProperties* bp,
-                         const std::string& body)
+                         const std::string& body,
+                         uint64_t delivery_tag)
 {
-    basicConsumeResponse resp;
-    resp.set_cid(__cid);
-    resp.set_consumer_tag(tag);
-    resp.set_body(body);
+    // 按本通道协商结果转换编码：支持则原样 / 压缩后下发，不支持则解压
+    const std::string* out      = &body;
+    ContentEncoding    encoding = bp ? bp->content_encoding() : ContentEncoding::IDENTITY;
+    std::string        converted;
+    if (encoding == ContentEncoding::ZLIB && !__compression) {
+        if (zlib_decompress(body, converted)) {
+            out      = &converted;
+            encoding = ContentEncoding::IDENTITY;
+        } else {
+            LOG(ERROR) << "consume: corrupt zlib body for consumer [" << tag << "]";
+        }
+    } else if (encoding == ContentEncoding::IDENTITY && __compression &&
+               body.size() >= COMPRESS_MIN_BYTES && zlib_compress(body, converted)) {
+        out      = &converted;
+        encoding = ContentEncoding::ZLIB;
+    }
+
+    // body 不经过 protobuf 对象，由 encode_consume_frame 直接追加；头部连同 properties 子消息都在栈上的 Arena 里
+    alignas(8) char block[DELIVERY_ARENA_BYTES];
+    google::protobuf::Arena arena(stack_arena(block, sizeof block));
+    auto* head  = google::protobuf::Arena::CreateMessage<basicConsumeResponse>(&arena);
+    auto* props = head->mutable_properties();
+    head->set_cid(__cid);
+    head->set_consumer_tag(tag);
+    head->set_delivery_tag(delivery_tag);
 
     if (bp) {
-        resp.mutable_properties()->set_id(bp->id());
-        resp.mutable_properties()->set_delivery_mode(bp->delivery_mode());
-        resp.mutable_properties()->set_routing_key(bp->routing_key());
+        props->set_id(bp->id());
+        props->set_delivery_mode(bp->delivery_mode());
+        props->set_routing_key(bp->routing_key());
+        if (bp->death_count()) {         // 死信队列的消费者需要知道死因
+            props->set_death_reason(bp->death_reason());
+            props->set_death_queue(bp->death_queue());
+            props->set_death_count(bp->death_count());
+        }
     }
-    __codec->send(__conn, resp);
+    props->set_content_encoding(encoding);
+
+    auto buf = std::make_shared<muduo::net::Buffer>();
+    encode_consume_frame(buf.get(), *head, out->data(), out->size());
+
+    // 交给连接所在 IO 线程发送：send(Buffer*) 在 loop 线程内直接写 socket，不再复制一份字符串
+    auto conn = __conn;
+    conn->getLoop()->runInLoop([conn, buf] { conn->send(buf.get()); });
 }
 
 // -----------------------------------------------------------------------------
@@ -146,39 +255,98 @@ void channel::unbind(const unbindRequestPtr& req)
 // -----------------------------------------------------------------------------
 void channel::basic_publish(const basicPublishRequestPtr& req)
 {
-    // 1. exchange 必须存在
-    auto ep = __host->select_exchange(req->exchange_name());
-    if (!ep) {
-        basic_response(false, req->rid(), req->cid());
-        return;
-    }
-
-    // 2. 路由匹配
-    msg_queue_binding_map bindings = __host->exchange_bindings(req->exchange_name());
-
+    // 1. 交换机是否存在、路由匹配都交给 virtual_host：匹配在拓扑读锁下直接遍历绑定表，
+    //    不再每条消息拷贝一份整张绑定表
     BasicProperties* properties = nullptr;
     std::string routing_key;
+    durable_span span;          // 本次发布自己的持久化追加，不看全局序号（其他连接的发布与此无关）
     if (req->has_properties()) {
         properties = req->mutable_properties();
         routing_key = properties->routing_key();
     }
 
-    for (const auto& [qname, bind_ptr] : bindings) {
-        if (router::match_route(ep->type, routing_key, bind_ptr->binding_key)) {
-            // 3. 入队
-            __host->basic_publish(qname, properties, req->body());
-            // 4. 异步派发
-            auto task = std::bind(&channel::consume, this, qname);
-            __pool->push(task);
+    if (req->delay_ms() > 0) {
+        // 延迟投递：先暂存，到期后由 virtual_host 路由并通过 ready 回调派发
+        if (!__host->publish_ex(req->exchange_name(), routing_key, properties, req->body(),
+                                req->delay_ms(), &span)) {
+            basic_response(false, req->rid(), req->cid());
+            return;
+        }
+    } else {
+        // 2. 路由并入队：多个目标队列共享一份消息体，请求里的 body 直接移入，不再逐队列拷贝；
+        //    目标队列满且策略为 reject-publish（或仍在恢复）时拒收，没有匹配的绑定照常确认
+        std::vector<std::string> queues;
+        bool unroutable = false;
+        bool ok = __host->publish_ex(req->exchange_name(), properties,
+                                     std::move(*req->mutable_body()), queues, &unroutable, &span);
+        // 3. 异步派发
+        for (const auto& qname : queues) dispatch(qname);
+        if (!ok && !unroutable) {   // 背压：发布方收到否定响应，自行降速或重试
+            basic_response(false, req->rid(), req->cid());
+            return;
         }
     }
-    basic_response(true, req->rid(), req->cid());
+
+    // 4. 有持久化写入时，等所在批次 fdatasync 完成后再确认
+    if (span.empty()) {
+        basic_response(true, req->rid(), req->cid());
+        return;
+    }
+    auto codec = __codec;
+    auto conn  = __conn;
+    // 回调在提交线程触发，回复切回连接所属的 EventLoop 发送
+    __host->when_durable(span, [codec, conn, rid = req->rid(), cid = req->cid()](bool ok) {
+        conn->getLoop()->runInLoop([codec, conn, rid, cid, ok] {
+            basicCommonResponse resp;
+            resp.set_rid(rid);
+            resp.set_cid(cid);
+            resp.set_ok(ok);            // 落盘失败：拒绝确认，由发布方重发
+            codec->send(conn, resp);
+        });
+    });
 }
 
 void channel::basic_ack(const basicAckRequestPtr& req)
 {
-    __host->basic_ack(req->queue_name(), req->message_id());
-    basic_response(true, req->rid(), req->cid());
+    if (req->delivery_tag() == 0) {
+        // 旧客户端按消息 id 确认：先找本通道的未确认投递，找不到再按 id 删除就绪消息；空 id 一律拒绝
+        if (req->message_id().empty()) {
+            basic_response(false, req->rid(), req->cid());
+            return;
+        }
+        uint64_t found = 0;
+        {
+            std::unique_lock<std::mutex> lock(__ack_mtx);
+            for (const auto& [tag, d] : __unacked) {
+                if (d.qname == req->queue_name() && d.msg_id == req->message_id()) { found = tag; break; }
+            }
+        }
+        if (found == 0) {
+            // 没有这条消息时回复失败
+            basic_response(__host->basic_ack(req->queue_name(), req->message_id()), req->rid(), req->cid());
+            return;
+        }
+        for (const auto& d : take_unacked(found, false)) __host->basic_ack_inflight(d.qname, d.inflight);
+        basic_response(true, req->rid(), req->cid());
+        return;
+    }
+
+    auto settled = take_unacked(req->delivery_tag(), req->multiple());
+    bool ok = !settled.empty();
+    for (const auto& d : settled) ok = __host->basic_ack_inflight(d.qname, d.inflight) && ok;
+    basic_response(ok, req->rid(), req->cid());
+}
+
+void channel::basic_nack(const basicNackRequestPtr& req)
+{
+    auto settled = take_unacked(req->delivery_tag(), req->multiple());
+    bool ok = !settled.empty();
+    // 倒序退回，队首恢复原顺序；退回的消息重新派发
+    for (auto it = settled.rbegin(); it != settled.rend(); ++it) {
+        ok = __host->basic_reject(it->qname, it->inflight, req->requeue()) && ok;
+        if (req->requeue()) dispatch(it->qname);
+    }
+    basic_response(ok, req->rid(), req->cid());
 }
 
 void channel::basic_consume(const basicConsumeRequestPtr& req)
@@ -188,11 +356,17 @@ void channel::basic_consume(const basicConsumeRequestPtr& req)
         return;
     }
 
-    auto cb = std::bind(&channel::consume_cb, this, std::placeholders::_1,
-                        std::placeholders::_2, std::placeholders::_3);
+    // 消费者登记在 consumer_manager 里，回调只持弱引用：通道析构时才移除消费者，强引用会成环
+    std::weak_ptr<channel> weak = weak_from_this();
+    auto cb = [weak](const std::string& tag, const BasicProperties* bp, const std::string& body) {
+        if (auto self = weak.lock()) self->consume_cb(tag, bp, body, 0);
+    };
     __consumer = __cmp->create(req->consumer_tag(), req->queue_name(),
-                               req->auto_ack(), cb);
-    basic_response(true, req->rid(), req->cid());
+                               req->auto_ack(), cb,
+                               [weak](const consumer& c) {
+                                   if (auto self = weak.lock()) self->deliver(c);
+                               });
+    basic_response(__consumer != nullptr, req->rid(), req->cid());
 }
 
 void channel::basic_cancel(const basicCancelRequestPtr& req)
@@ -219,12 +393,13 @@ bool channel_manager::open_channel(const std::string& cid,
                                    const consumer_manager::ptr& cmp,
                                    const ProtobufCodecPtr& codec,
                                    const muduo::net::TcpConnectionPtr conn,
-                                   const thread_pool::ptr& pool)
+                                   const thread_pool::ptr& pool,
+                                   bool compression)
 {
     std::unique_lock<std::mutex> lock(__mtx);
     if (__channels.count(cid) != 0) return false;
 
-    __channels[cid] = std::make_shared<channel>(cid, host, cmp, codec, conn, pool);
+    __channels[cid] = std::make_shared<channel>(cid, host, cmp, codec, conn, pool, compression);
     return true;
 }
 
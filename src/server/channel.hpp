@@ -1,9 +1,12 @@
 // ======================= channel.hpp =======================
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "../common/msg.pb.h"     // 请求/响应 Protobuf
 #include "../common/protocol.pb.h"
@@ -40,6 +43,7 @@ using bindRequestPtr           = std::shared_ptr<bindRequest>;
 using unbindRequestPtr         = std::shared_ptr<unbindRequest>;
 using basicPublishRequestPtr   = std::shared_ptr<basicPublishRequest>;
 using basicAckRequestPtr       = std::shared_ptr<basicAckRequest>;
+using basicNackRequestPtr      = std::shared_ptr<basicNackRequest>;
 using basicConsumeRequestPtr   = std::shared_ptr<basicConsumeRequest>;
 using basicCancelRequestPtr    = std::shared_ptr<basicCancelRequest>;
 using basicQueryRequestPtr     = std::shared_ptr<basicQueryRequest>;
@@ -48,7 +52,8 @@ using basicCommonResponsePtr   = std::shared_ptr<basicCommonResponse>;
 // =================================================================
 // channel : 表示一条逻辑通道（AMQP 风格）
 // =================================================================
-class channel {
+// 线程池任务持有 shared_from_this()，消费者回调持有 weak_ptr，通道关闭后不会悬空
+class channel : public std::enable_shared_from_this<channel> {
 public:
     using ptr = std::shared_ptr<channel>;
 
@@ -57,7 +62,8 @@ public:
             const consumer_manager::ptr& cmp,
             const ProtobufCodecPtr& codec,
             const muduo::net::TcpConnectionPtr conn,
-            const thread_pool::ptr& pool);
+            const thread_pool::ptr& pool,
+            bool compression = false);
     ~channel();
 
     // ------------------- Exchange -------------------
@@ -75,6 +81,7 @@ public:
     // ------------------- Message --------------------
     void basic_publish(const basicPublishRequestPtr& req);
     void basic_ack(const basicAckRequestPtr& req);
+    void basic_nack(const basicNackRequestPtr& req);
     void basic_consume(const basicConsumeRequestPtr& req);
     void basic_cancel(const basicCancelRequestPtr& req);
     void basic_query(const basicQueryRequestPtr& req);
@@ -82,8 +89,20 @@ public:
 private:
     // helpers ------------------------------------------------------
     void basic_response(bool ok, const std::string& rid, const std::string& cid);
+    void dispatch(const std::string& qname); // 向线程池派发 consume 任务
     void consume(const std::string& qname); // 在线程池中执行
-    void consume_cb(const std::string& tag, const BasicProperties* bp, const std::string& body);
+    void deliver(const consumer& c);        // 本通道的消费者取消息投递，手动确认的登记 delivery tag
+    void consume_cb(const std::string& tag, const BasicProperties* bp, const std::string& body,
+                    uint64_t delivery_tag);
+
+    // 已投递未确认：delivery tag -> 所在队列与队列内凭据
+    struct unacked_delivery {
+        std::string qname;
+        uint64_t    inflight;
+        std::string msg_id;
+    };
+    // 摘出 tag（multiple 时为 <= tag 的全部）对应的未确认投递，按 tag 递增
+    std::vector<unacked_delivery> take_unacked(uint64_t tag, bool multiple);
 
     // data ---------------------------------------------------------
     std::string                    __cid;
@@ -93,6 +112,11 @@ private:
     consumer_manager::ptr          __cmp;
     virtual_host::ptr              __host;
     thread_pool::ptr               __pool;
+    bool                           __compression{false};   // openChannel 时协商：收发 ZLIB 消息体
+
+    std::mutex                                 __ack_mtx;     // consume 在线程池，ack 在 IO 线程
+    uint64_t                                   __next_tag{0}; // 通道内单调递增的 delivery tag
+    std::map<uint64_t, unacked_delivery>       __unacked;
 };
 
 // =================================================================
@@ -107,7 +131,8 @@ public:
                       const consumer_manager::ptr& cmp,
                       const ProtobufCodecPtr& codec,
                       const muduo::net::TcpConnectionPtr conn,
-                      const thread_pool::ptr& pool);
+                      const thread_pool::ptr& pool,
+                      bool compression = false);
 
     void close_channel(const std::string& cid);
     channel::ptr select_channel(const std::string& cid);
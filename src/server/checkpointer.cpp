@@ -0,0 +1,68 @@
+// ======================= checkpointer.cpp =======================
+#include "checkpointer.hpp"
+#include "queue_message.hpp"
+#include "../common/metrics.hpp"
+
+#include <algorithm>
+
+namespace hz_mq {
+
+checkpointer::checkpointer(const meta_store::ptr& meta, const options& opts)
+    : __opts(opts), __meta(meta)
+{
+    __worker = std::thread(&checkpointer::run, this);
+}
+
+checkpointer::~checkpointer()
+{
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        __stop = true;
+    }
+    __cv.notify_all();
+    if (__worker.joinable()) __worker.join();
+}
+
+void checkpointer::watch(const std::shared_ptr<queue_message>& qm)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    __queues.push_back(qm);
+}
+
+size_t checkpointer::run_once()
+{
+    static metric& m_round = metrics::instance().get("checkpoint.round_ms");
+
+    std::vector<std::shared_ptr<queue_message>> alive;
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        auto dead = std::remove_if(__queues.begin(), __queues.end(),
+                                   [](const auto& w) { return w.expired(); });
+        __queues.erase(dead, __queues.end());
+        for (const auto& w : __queues)
+            if (auto qm = w.lock()) alive.push_back(std::move(qm));
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    if (__meta) __meta->checkpoint();
+
+    size_t done = 0;
+    for (const auto& qm : alive) {
+        if (qm->ready() && qm->checkpoint()) ++done;   // 仍在恢复的队列下一轮再写
+    }
+    m_round.observe(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - t0).count()));
+    return done;
+}
+
+void checkpointer::run()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    while (!__cv.wait_for(lock, __opts.interval, [this] { return __stop; })) {
+        lock.unlock();
+        run_once();
+        lock.lock();
+    }
+}
+
+}
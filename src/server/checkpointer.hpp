@@ -0,0 +1,52 @@
+// ======================= checkpointer.hpp =======================
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../common/meta_store.hpp"
+
+namespace hz_mq {
+
+class queue_message;                   // 前向声明
+
+// ---------- 检查点参数 ----------
+struct checkpointer_options {
+    std::chrono::milliseconds interval{30000};         // 两次检查点之间的间隔
+};
+
+// ===========================================================================
+// checkpointer : 后台线程，定期为 virtual_host 写检查点
+//   · 元数据：meta_store 写快照并清空 WAL
+//   · 每个持久化队列：有效消息的属性 + offset 与日志 tail（见 segment_log::log_checkpoint）
+// 重启时只需重放检查点之后写入的部分
+// ===========================================================================
+class checkpointer {
+public:
+    using ptr     = std::shared_ptr<checkpointer>;
+    using options = checkpointer_options;
+
+    explicit checkpointer(const meta_store::ptr& meta, const options& opts = options());
+    ~checkpointer();
+
+    void   watch(const std::shared_ptr<queue_message>& qm);   // 只持有弱引用
+    size_t run_once();                                         // 写一轮，返回成功的队列数
+
+private:
+    void run();
+
+    options                                   __opts;
+    meta_store::ptr                           __meta;
+    std::mutex                                __mtx;
+    std::condition_variable                   __cv;
+    std::vector<std::weak_ptr<queue_message>> __queues;
+    bool                                      __stop{false};
+    std::thread                               __worker;
+};
+
+}
@@ -0,0 +1,86 @@
+// ======================= compactor.cpp =======================
+#include "compactor.hpp"
+#include "queue_message.hpp"
+#include "../common/metrics.hpp"
+
+#include <algorithm>
+
+namespace hz_mq {
+
+using std::chrono::steady_clock;
+
+compactor::compactor(const options& opts)
+    : __opts(opts), __last_refill(steady_clock::now())
+{
+    __worker = std::thread(&compactor::run, this);
+}
+
+compactor::~compactor()
+{
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        __stop = true;
+    }
+    __cv.notify_all();
+    if (__worker.joinable()) __worker.join();
+}
+
+void compactor::watch(const std::shared_ptr<queue_message>& qm)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    __queues.push_back(qm);
+}
+
+uint64_t compactor::run_once()
+{
+    static metric& m_reclaimed = metrics::instance().get("compactor.reclaimed_bytes");
+
+    std::vector<std::shared_ptr<queue_message>> alive;
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        auto dead = std::remove_if(__queues.begin(), __queues.end(),
+                                   [](const auto& w) { return w.expired(); });
+        __queues.erase(dead, __queues.end());
+        for (const auto& w : __queues)
+            if (auto qm = w.lock()) alive.push_back(std::move(qm));
+    }
+
+    uint64_t reclaimed = 0;
+    for (const auto& qm : alive) {
+        qm->apply_retention();
+        reclaimed += qm->compact(__opts.garbage_ratio,
+                                 [this](uint64_t bytes) { throttle(bytes); });
+    }
+    if (reclaimed) m_reclaimed.observe(reclaimed);
+    return reclaimed;
+}
+
+void compactor::run()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    while (!__cv.wait_for(lock, __opts.interval, [this] { return __stop; })) {
+        lock.unlock();
+        run_once();
+        lock.lock();
+    }
+}
+
+void compactor::throttle(uint64_t bytes)
+{
+    if (__opts.max_bytes_per_sec == 0) return;
+
+    const double rate = static_cast<double>(__opts.max_bytes_per_sec);
+    auto now = steady_clock::now();
+    __tokens = std::min(rate, __tokens + rate * std::chrono::duration<double>(now - __last_refill).count());
+    __last_refill = now;
+
+    __tokens -= static_cast<double>(bytes);
+    if (__tokens < 0) {
+        // 令牌不足：睡到补足为止（析构时可被唤醒）
+        std::unique_lock<std::mutex> lock(__mtx);
+        __cv.wait_for(lock, std::chrono::duration<double>(-__tokens / rate),
+                      [this] { return __stop; });
+    }
+}
+
+}
@@ -0,0 +1,53 @@
+// ======================= compactor.hpp =======================
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hz_mq {
+
+class queue_message;                   // 前向声明
+
+// ---------- 压缩参数 ----------
+struct compactor_options {
+    std::chrono::milliseconds interval{1000};          // 巡检间隔
+    double                    garbage_ratio{0.5};      // 无效字节占比达到即重写
+    uint64_t                  max_bytes_per_sec{32ull << 20};   // 写盘限速，0 表示不限
+};
+
+// ===========================================================================
+// compactor : 后台线程，定期回收各队列封存段中已确认消息占用的磁盘空间，
+//             并执行各队列的保留策略（x-message-ttl / x-retention-bytes）
+// ===========================================================================
+class compactor {
+public:
+    using ptr     = std::shared_ptr<compactor>;
+    using options = compactor_options;
+
+    explicit compactor(const options& opts = options());
+    ~compactor();
+
+    void watch(const std::shared_ptr<queue_message>& qm);   // 只持有弱引用
+    uint64_t run_once();                                     // 巡检一轮，返回压缩回收字节数
+
+private:
+    void run();
+    void throttle(uint64_t bytes);     // 令牌桶，仅在压缩线程中调用
+
+    options                                   __opts;
+    std::mutex                                __mtx;
+    std::condition_variable                   __cv;
+    std::vector<std::weak_ptr<queue_message>> __queues;
+    bool                                      __stop{false};
+
+    double                                    __tokens{0};
+    std::chrono::steady_clock::time_point     __last_refill;
+    std::thread                               __worker;
+};
+
+}
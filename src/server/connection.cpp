@@ -31,8 +31,15 @@ void connection::basic_response(bool ok, const std::string& rid, const std::stri
 
 void connection::open_channel(const openChannelRequestPtr& req)
 {
-    bool ok = __channels->open_channel(req->cid(), __host, __cmp, __codec, __conn, __pool);
-    basic_response(ok, req->rid(), req->cid());
+    bool ok = __channels->open_channel(req->cid(), __host, __cmp, __codec, __conn, __pool,
+                                       req->compression());
+
+    basicCommonResponse resp;
+    resp.set_rid(req->rid());
+    resp.set_cid(req->cid());
+    resp.set_ok(ok);
+    resp.set_compression(ok && req->compression());    // 服务端总是支持 zlib，按客户端意愿开启
+    __codec->send(__conn, resp);
 }
 
 void connection::close_channel(const closeChannelRequestPtr& req)
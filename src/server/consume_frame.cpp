@@ -0,0 +1,54 @@
+// ======================= consume_frame.cpp =======================
+#include "consume_frame.hpp"
+
+#include <string>
+
+#include <muduo/net/Buffer.h>
+#include <zlib.h>
+
+namespace hz_mq {
+
+static size_t put_varint(char* out, uint64_t v)
+{
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = static_cast<char>(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = static_cast<char>(v);
+    return n;
+}
+
+void encode_consume_frame(muduo::net::Buffer* buf,
+                          const basicConsumeResponse& head,
+                          const char* body, size_t body_len)
+{
+    // 头部字段（body 必须为空，由下面单独追加）：先算好长度，再直接序列化进 buf，不经过临时字符串
+    const size_t fields_len = head.ByteSizeLong();
+
+    char     field_hdr[16];
+    size_t   hdr_len = put_varint(field_hdr,
+                                  (basicConsumeResponse::kBodyFieldNumber << 3) | 2);  // length-delimited
+    hdr_len += put_varint(field_hdr + hdr_len, body_len);
+
+    const std::string& type_name = head.GetDescriptor()->full_name();   // GetTypeName() 每次返回一份拷贝
+    const int32_t      name_len  = static_cast<int32_t>(type_name.size() + 1);
+
+    buf->ensureWritableBytes(sizeof(int32_t) * 3 + name_len + fields_len + hdr_len + body_len);
+    buf->appendInt32(name_len);
+    buf->append(type_name.c_str(), name_len);
+    head.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t*>(buf->beginWrite()));
+    buf->hasWritten(fields_len);
+    if (body_len > 0) {                                      // proto3：空串不编码
+        buf->append(field_hdr, hdr_len);
+        buf->append(body, body_len);
+    }
+
+    // 校验和覆盖 nameLen 起的全部字节（与 ProtobufCodec::fillEmptyBuffer 一致）
+    uLong check = ::adler32(1, reinterpret_cast<const Bytef*>(buf->peek()),
+                            static_cast<uInt>(buf->readableBytes()));
+    buf->appendInt32(static_cast<int32_t>(check));
+    buf->prependInt32(static_cast<int32_t>(buf->readableBytes()));
+}
+
+}
@@ -0,0 +1,26 @@
+// ======================= consume_frame.hpp =======================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../common/protocol.pb.h"   // basicConsumeResponse
+
+namespace muduo { namespace net { class Buffer; } }
+
+namespace hz_mq {
+
+// ---------------------------------------------------------------------------
+// 直接按 ProtobufCodec 的帧格式编码 basicConsumeResponse：
+//
+//   | int32 len | int32 nameLen | typeName\0 | protobuf 字节 | int32 adler32 |
+//
+// head 中除 body 外的字段直接序列化进 buf（不经临时字符串）；body 作为最后一个字段
+// （tag + varint 长度 + 原始字节）直接从调用方给出的内存追加进 buf，
+// 省掉 set_body 与整条消息序列化两次拷贝。buf 须为空。
+// ---------------------------------------------------------------------------
+void encode_consume_frame(muduo::net::Buffer* buf,
+                          const basicConsumeResponse& head,
+                          const char* body, size_t body_len);
+
+}
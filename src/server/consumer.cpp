@@ -6,11 +6,13 @@ namespace hz_mq {
 
 // --------- consumer ----------
 consumer::consumer(const std::string& ctag, const std::string& queue_name,
-                   bool ack_flag, const consumer_callback& cb)
+                   bool ack_flag, const consumer_callback& cb,
+                   const consumer_pull& pull_fn)
     : tag(ctag),
       qname(queue_name),
       auto_ack(ack_flag),
-      callback(cb) {}
+      callback(cb),
+      pull(pull_fn) {}
 
 // --------- queue_consumer ----------
 queue_consumer::queue_consumer(const std::string& qname)
@@ -19,7 +21,8 @@ queue_consumer::queue_consumer(const std::string& qname)
 consumer::ptr queue_consumer::create(const std::string& ctag,
                                      const std::string& queue_name,
                                      bool ack_flag,
-                                     const consumer_callback& cb)
+                                     const consumer_callback& cb,
+                                     const consumer_pull& pull)
 {
     std::unique_lock<std::mutex> lock(__mtx);
     for (const auto& c : __consumers) {
@@ -28,7 +31,7 @@ consumer::ptr queue_consumer::create(const std::string& ctag,
             return {};
         }
     }
-    auto new_consumer = std::make_shared<consumer>(ctag, queue_name, ack_flag, cb);
+    auto new_consumer = std::make_shared<consumer>(ctag, queue_name, ack_flag, cb, pull);
     __consumers.push_back(new_consumer);
     return new_consumer;
 }
@@ -94,7 +97,8 @@ void consumer_manager::destroy_queue_consumer(const std::string& qname)
 consumer::ptr consumer_manager::create(const std::string& ctag,
                                        const std::string& queue_name,
                                        bool ack_flag,
-                                       const consumer_callback& cb)
+                                       const consumer_callback& cb,
+                                       const consumer_pull& pull)
 {
     queue_consumer::ptr qc;
     {
@@ -106,7 +110,7 @@ consumer::ptr consumer_manager::create(const std::string& ctag,
         }
         qc = it->second;
     }
-    return qc->create(ctag, queue_name, ack_flag, cb);
+    return qc->create(ctag, queue_name, ack_flag, cb, pull);
 }
 
 void consumer_manager::remove(const std::string& ctag, const std::string& queue_name)
@@ -16,6 +16,11 @@ namespace hz_mq {
 using consumer_callback =
     std::function<void(const std::string&, const BasicProperties*, const std::string&)>;
 
+// 由消费者所属通道自己从队列取一条消息投递（分配 delivery tag、登记未确认）；
+// 未设置时由调度方取出消息后直接调用 callback（自动确认）
+struct consumer;
+using consumer_pull = std::function<void(const consumer&)>;
+
 // --------- consumer ----------
 struct consumer {
     using ptr = std::shared_ptr<consumer>;
@@ -24,10 +29,12 @@ struct consumer {
     std::string qname;    // 订阅队列
     bool auto_ack{false};
     consumer_callback callback;
+    consumer_pull pull;
 
     consumer() = default;
     consumer(const std::string& ctag, const std::string& queue_name,
-             bool ack_flag, const consumer_callback& cb);
+             bool ack_flag, const consumer_callback& cb,
+             const consumer_pull& pull_fn = {});
 };
 
 // --------- queue_consumer ----------
@@ -38,7 +45,8 @@ public:
     explicit queue_consumer(const std::string& qname);
 
     consumer::ptr create(const std::string& ctag, const std::string& queue_name,
-                         bool ack_flag, const consumer_callback& cb);
+                         bool ack_flag, const consumer_callback& cb,
+                         const consumer_pull& pull = {});
     void remove(const std::string& ctag);
     consumer::ptr rr_choose();      // 轮询选择
     bool empty();
@@ -63,7 +71,8 @@ public:
     void destroy_queue_consumer(const std::string& qname);
 
     consumer::ptr create(const std::string& ctag, const std::string& queue_name,
-                         bool ack_flag, const consumer_callback& cb);
+                         bool ack_flag, const consumer_callback& cb,
+                         const consumer_pull& pull = {});
     void remove(const std::string& ctag, const std::string& queue_name);
     consumer::ptr choose(const std::string& queue_name);
 
@@ -0,0 +1,163 @@
+// ======================= group_commit.cpp =======================
+#include "group_commit.hpp"
+#include "../common/logger.hpp"
+#include "../common/metrics.hpp"
+
+#include <future>
+#include <vector>
+
+namespace hz_mq {
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+group_commit::group_commit(const options& opts)
+    : __opts(opts), __io(storage_io::create(opts.io_uring))
+{
+    __worker = std::thread(&group_commit::run, this);
+}
+
+group_commit::~group_commit()
+{
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        __stop = true;
+    }
+    __cv.notify_all();
+    if (__worker.joinable()) __worker.join();
+}
+
+uint64_t group_commit::notify(const segment_log::ptr& log, uint64_t bytes)
+{
+    bool wake = false;
+    uint64_t seq;
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        if (__dirty.empty()) {
+            __batch_start = steady_clock::now();
+            wake = true;                               // 新一批开始，唤醒提交线程计时
+        }
+        __dirty.insert(log);
+        __dirty_bytes += bytes;
+        if (__dirty_bytes >= __opts.max_batch_bytes) wake = true;
+        seq = ++__submitted;
+    }
+    if (wake) __cv.notify_all();
+    return seq;
+}
+
+uint64_t group_commit::submitted()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    return __submitted;
+}
+
+void group_commit::when_durable(uint64_t seq, const callback& cb)
+{
+    when_durable(durable_span{seq, seq}, cb);
+}
+
+void group_commit::when_durable(const durable_span& span, const callback& cb)
+{
+    bool ok = true;
+    if (!span.empty()) {
+        std::unique_lock<std::mutex> lock(__mtx);
+        if (span.last > __committed) {
+            __waiters.emplace(span.last, std::make_pair(span.first, cb));
+            return;
+        }
+        ok = !failed_in(span.first, span.last);
+    }
+    cb(ok);
+}
+
+// 失败区间互不重叠且按序号排列：末序号 >= first 的第一段若始于 last 之前即有交集
+bool group_commit::failed_in(uint64_t first, uint64_t last) const
+{
+    auto it = __failed.lower_bound(first);
+    return it != __failed.end() && it->second <= last;
+}
+
+bool group_commit::sync()
+{
+    std::promise<bool> done;
+    when_durable(submitted(), [&done](bool ok) { done.set_value(ok); });
+    return done.get_future().get();
+}
+
+void group_commit::set_pre_commit(const hook& fn)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    __pre_commit = fn;
+}
+
+void group_commit::run()
+{
+    static metric& m_appends = metrics::instance().get("group_commit.batch_appends");
+    static metric& m_bytes   = metrics::instance().get("group_commit.batch_bytes");
+    static metric& m_wait    = metrics::instance().get("group_commit.wait_us");
+    static metric& m_sync    = metrics::instance().get("group_commit.write_sync_us");
+
+    std::unique_lock<std::mutex> lock(__mtx);
+    while (true) {
+        __cv.wait(lock, [this] { return __stop || !__dirty.empty(); });
+        if (__dirty.empty()) break;                    // __stop 且无待提交数据
+
+        // 攒批：等到窗口结束或字节预算用完
+        __cv.wait_until(lock, __batch_start + __opts.window, [this] {
+            return __stop || __dirty_bytes >= __opts.max_batch_bytes;
+        });
+
+        auto logs           = std::move(__dirty);
+        __dirty.clear();
+        __dirty_bytes       = 0;
+        uint64_t target     = __submitted;
+        uint64_t appends    = target - __committed;
+        auto     batch_from = __batch_start;
+        auto     pre_commit = __pre_commit;
+        lock.unlock();
+
+        bool meta_ok = !pre_commit || pre_commit();
+
+        // 所有脏日志的写入与 fdatasync 合成一批交给 storage_io
+        auto     t0    = steady_clock::now();
+        io_batch batch;
+        uint64_t bytes = 0;
+        for (const auto& log : logs) bytes += log->prepare_commit(batch);
+        bool ok = batch.empty() || __io->submit(batch);
+        if (!ok)
+            LOG(ERROR) << "group commit: " << __io->name() << " batch of " << bytes << " bytes failed";
+        if (!meta_ok)
+            LOG(ERROR) << "group commit: metadata flush failed, " << appends << " appends not confirmed";
+        ok = ok && meta_ok;
+        // 失败时各日志保留这批数据待下一批原位重写，其中的持久化消息从队列摘除（发布方会重发）
+        for (const auto& log : logs) log->finish_commit(ok);
+        auto     t1    = steady_clock::now();
+
+        lock.lock();
+        if (!ok && appends) __failed.emplace(target, target - appends + 1);
+        __committed = target;
+        std::vector<std::pair<callback, bool>> ready;
+        auto end = __waiters.upper_bound(target);
+        for (auto it = __waiters.begin(); it != end; ++it) {
+            auto& [first, cb] = it->second;
+            ready.emplace_back(std::move(cb), !failed_in(first, it->first));
+        }
+        __waiters.erase(__waiters.begin(), end);
+        lock.unlock();
+
+        // 失败的批不回复成功：这些追加是否在盘上未知（fdatasync 出错后脏页可能已被丢弃）；
+        // 跨批的区间只要其中一批失败也不算成功
+        for (auto& [cb, durable] : ready) cb(durable);
+
+        m_appends.observe(appends);
+        m_bytes.observe(bytes);
+        m_wait.observe(static_cast<uint64_t>(duration_cast<microseconds>(t1 - batch_from).count()));
+        m_sync.observe(static_cast<uint64_t>(duration_cast<microseconds>(t1 - t0).count()));
+
+        lock.lock();
+    }
+}
+
+}
@@ -0,0 +1,96 @@
+// ======================= group_commit.hpp =======================
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include "segment_log.hpp"
+#include "storage_io.hpp"
+
+namespace hz_mq {
+
+// ---------- 批提交参数 ----------
+struct group_commit_options {
+    std::chrono::microseconds window{2000};             // 一批最多等待多久
+    uint64_t                  max_batch_bytes{1 << 20}; // 攒够多少字节立即提交
+    bool                      io_uring{true};           // 优先 io_uring，不可用时退回 pwrite
+};
+
+// ---------- 一次发布（可能扇出到多个队列）自己的持久化追加序号区间；空表示无须等待落盘 ----------
+struct durable_span {
+    uint64_t first{0};
+    uint64_t last{0};
+
+    bool empty() const { return last == 0; }
+    void add(uint64_t seq)
+    {
+        if (seq == 0) return;
+        if (first == 0 || seq < first) first = seq;
+        if (seq > last) last = seq;
+    }
+};
+
+// ===========================================================================
+// group_commit : 汇总所有队列的持久化追加，按“时间窗口 / 字节预算”成批
+//                write + fdatasync，然后统一回调（例如回复 basicCommonResponse）；
+//                磁盘操作全部在提交线程内经 storage_io 完成。
+//                写入或 fdatasync 失败时该批的回调收到 false，调用方据此拒绝确认
+// ===========================================================================
+class group_commit {
+public:
+    using ptr      = std::shared_ptr<group_commit>;
+    using callback = std::function<void(bool durable)>;
+    using hook     = std::function<bool()>;
+
+    using options  = group_commit_options;
+
+    explicit group_commit(const options& opts = options());
+    ~group_commit();
+
+    // 某个日志刚缓冲了一条 bytes 字节的追加；返回该追加的序号
+    uint64_t notify(const segment_log::ptr& log, uint64_t bytes);
+
+    // 已缓冲（尚未必落盘）的最新序号
+    uint64_t submitted();
+
+    // 序号 seq 所在的批提交结束后回调（在提交线程中执行；已提交则立即执行），
+    // 参数为该批是否成功落盘；需要回到 EventLoop 的调用方自行 runInLoop
+    void when_durable(uint64_t seq, const callback& cb);
+    // 区间内的追加全部提交后回调，其中任一所在批失败即为 false；空区间立即回调 true
+    void when_durable(const durable_span& span, const callback& cb);
+
+    // 阻塞直到当前已缓冲的追加全部提交；其中有失败的批返回 false
+    bool sync();
+
+    // 每批提交前先执行 fn（例如元数据 WAL 落盘），保证确认的消息所属的队列声明不晚于消息持久；
+    // fn 返回 false 时该批照常写入，但回调收到 false
+    void set_pre_commit(const hook& fn);
+
+private:
+    void run();
+    bool failed_in(uint64_t first, uint64_t last) const;   // 需持有 __mtx
+
+    options                                  __opts;
+    storage_io::ptr                          __io;
+    hook                                     __pre_commit;
+    std::mutex                               __mtx;
+    std::condition_variable                  __cv;
+    std::unordered_set<segment_log::ptr>     __dirty;
+    uint64_t                                 __dirty_bytes{0};
+    uint64_t                                 __submitted{0};
+    uint64_t                                 __committed{0};
+    std::chrono::steady_clock::time_point    __batch_start;
+    std::multimap<uint64_t, std::pair<uint64_t, callback>> __waiters;   // 末序号 -> (首序号, 回调)
+    std::map<uint64_t, uint64_t>             __failed;       // 失败的批：末序号 -> 首序号
+    bool                                     __stop{false};
+    std::thread                              __worker;
+};
+
+}
@@ -0,0 +1,111 @@
+// ======================= mpsc_ring.hpp =======================
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace hz_mq {
+
+// ===========================================================================
+// mpsc_ring : 有界无锁多生产者 / 单消费者环（每个槽位带序号，Vyukov 有界队列）
+//   · 生产者 CAS 推进 __tail 占到槽位，就地写入后把槽位序号置为 pos + 1 发布
+//   · 唯一消费者按 __head 顺序取出，取完把序号推进一圈（pos + 容量）还给生产者
+//   · 满了 try_push 立即返回 false，由调用方退回别的路径，不会阻塞生产者
+//   · 槽位里的对象一直复用：消费者可以与它交换内容，把已分配的容量留给下一次写入
+//   · “单消费者”由调用方保证（例如只在持有某把锁时调用 drain）
+// ===========================================================================
+template <typename T>
+class mpsc_ring {
+public:
+    static constexpr std::size_t MAX_CAPACITY = 1u << 20;
+
+    // 容量向上取整为 2 的幂
+    explicit mpsc_ring(std::size_t capacity)
+    {
+        std::size_t n = 2;
+        while (n < std::min(capacity, MAX_CAPACITY)) n <<= 1;
+        __mask  = n - 1;
+        __cells = std::make_unique<cell[]>(n);
+        for (std::size_t i = 0; i < n; ++i) __cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const { return __mask + 1; }
+
+    // 生产者：占到槽位后调用 fill(T&) 就地写入再发布；环满返回 false
+    template <typename F>
+    bool try_push(F&& fill)
+    {
+        uint64_t pos = __tail.load(std::memory_order_relaxed);
+        cell*    c;
+        for (;;) {
+            c = &__cells[pos & __mask];
+            uint64_t seq = c->seq.load(std::memory_order_acquire);
+            int64_t  dif = static_cast<int64_t>(seq - pos);
+            if (dif == 0) {
+                if (__tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;                                    // 落后一整圈的槽位还没被取走：满
+            } else {
+                pos = __tail.load(std::memory_order_relaxed);    // 被别的生产者抢先
+            }
+        }
+        fill(c->value);
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者：按顺序取出已发布的槽位，交给 take(T&)，返回条数。
+    // 遇到已占位但还在写入的槽位即停下，不等它（消费者通常持着锁，生产者可能被切走）：
+    // 那条及其后的槽位留给下一次 drain，由其生产者发布后负责触发
+    template <typename F>
+    std::size_t drain(F&& take)
+    {
+        uint64_t       head = __head.load(std::memory_order_relaxed);
+        const uint64_t end  = __tail.load(std::memory_order_acquire);
+        std::size_t    n    = 0;
+        for (; head != end; ++head, ++n) {
+            cell& c = __cells[head & __mask];
+            if (c.seq.load(std::memory_order_acquire) != head + 1) break;
+            take(c.value);
+            c.seq.store(head + __mask + 1, std::memory_order_release);
+        }
+        __head.store(head, std::memory_order_relaxed);
+        return n;
+    }
+
+    // 任意线程：等调用前已被占用的槽位全部发布（或已取走）。不要持着消费者的锁调用。
+    // 之后的 drain 就能一路取到调用时的 __tail，供需要跟在环里已有写入之后的调用方使用
+    void wait_published() const
+    {
+        const uint64_t end = __tail.load(std::memory_order_acquire);
+        for (uint64_t pos = __head.load(std::memory_order_relaxed); pos < end; ++pos) {
+            // 已占位未发布的槽位序号仍等于 pos；发布后为 pos + 1，取走后至少 pos + 容量
+            const cell& c = __cells[pos & __mask];
+            while (c.seq.load(std::memory_order_acquire) == pos) std::this_thread::yield();
+        }
+    }
+
+    // 已占用未取出的槽位数（含还在写入的）；只在消费者一侧调用
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(__tail.load(std::memory_order_acquire) -
+                                        __head.load(std::memory_order_relaxed));
+    }
+
+private:
+    struct alignas(64) cell {                                    // 各占一条缓存行，生产者之间不伪共享
+        std::atomic<uint64_t> seq{0};
+        T                     value{};
+    };
+
+    std::unique_ptr<cell[]>            __cells;
+    std::size_t                        __mask{0};
+    alignas(64) std::atomic<uint64_t>  __tail{0};                // 生产者共享
+    alignas(64) std::atomic<uint64_t>  __head{0};                // 只有消费者写；wait_published 读作下界
+};
+
+}
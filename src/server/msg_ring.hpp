@@ -0,0 +1,319 @@
+// ======================= msg_ring.hpp =======================
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/message.hpp"   // Message / BasicProperties / message_ptr / shared_body
+
+namespace hz_mq {
+
+// ---------- 就绪列表中的一条消息：属性与消息体按值内联在环形槽里 ----------
+struct msg_desc {
+    BasicProperties props;
+    std::string     body;          // 独占的消息体；lazy 换出后为空
+    shared_body     shared;        // 扇出入队时与其他队列共享的消息体（与 body 二选一）
+    uint64_t        offset{0};     // 段日志中的逻辑偏移
+    uint64_t        length{0};     // 记录 payload 长度，0 表示只在内存中
+    uint64_t        bytes{0};      // 计入 x-max-length-bytes 的消息体字节（入队时定下，换出后不变）
+    uint64_t        timer{0};      // 过期定时器句柄（timer_wheel::handle），0 表示没有
+    bool            live{false};   // 按 id 删除后留下空位，推进队首时跳过
+
+    const std::string& data() const { return shared ? *shared : body; }
+    bool has_body() const           { return shared || !body.empty(); }
+
+    // 消息体移交给 out：独占的直接交换；共享的只有最后一个持有者能接管，否则拷贝
+    void move_body(std::string& out)
+    {
+        if (!shared) {
+            out.swap(body);
+            return;
+        }
+        if (shared.use_count() == 1) out.swap(*shared);
+        else out.assign(*shared);
+        shared.reset();
+    }
+
+    // 拷贝进调用方给出的 Message（可以分配在 Arena 上）；
+    // share 非空且消息体共享时只交出引用，Message 不带消息体
+    void copy_to(Message& m, shared_body* share = nullptr) const
+    {
+        m.mutable_payload()->mutable_properties()->CopyFrom(props);
+        if (share && shared) *share = shared;
+        else m.mutable_payload()->set_body(data());
+        m.set_offset(offset);
+        m.set_length(length);
+    }
+
+    // 属性与消息体移交给 m（出队），不拷贝消息体；share 的含义同 copy_to()。
+    // m 在 Arena 上时属性改为拷贝：跨 Arena 的 Swap 本来也是深拷贝，
+    // 拷贝还能让槽里的属性字符串保留容量，留给下一条消息复用
+    void move_to(Message& m, shared_body* share = nullptr)
+    {
+        auto* p = m.mutable_payload()->mutable_properties();
+        if (m.GetArena()) p->CopyFrom(props);
+        else p->Swap(&props);
+        if (share && shared) *share = std::move(shared);
+        else move_body(*m.mutable_payload()->mutable_body());
+        m.set_offset(offset);
+        m.set_length(length);
+    }
+
+    // 拷贝成独立的 Message（只读查看队首）
+    message_ptr to_message(shared_body* share = nullptr) const
+    {
+        auto m = std::make_shared<Message>();
+        copy_to(*m, share);
+        return m;
+    }
+
+    // 从恢复出的 Message 接管属性与消息体
+    void take(Message& m)
+    {
+        props.Swap(m.mutable_payload()->mutable_properties());
+        body.swap(*m.mutable_payload()->mutable_body());
+        offset = m.offset();
+        length = m.length();
+    }
+
+    // 只含 offset / length，供 segment_log::read / invalidate 定位记录
+    Message locator() const
+    {
+        Message m;
+        m.set_offset(offset);
+        m.set_length(length);
+        return m;
+    }
+};
+
+// ===========================================================================
+// msg_ring : 就绪消息的环形数组（容量 2 的幂，满则翻倍）
+//   · 每条消息由单调递增的序号 seq 定位，槽位 = seq & mask，入队 / 出队只移动头尾序号
+//   · 中间删除只把槽位置空，空位推进到队首时回收；头尾之间的空位也占容量
+//   · 槽位循环复用：erase 只清空内容（Clear / clear 保留已分配的字符串），
+//     稳定深度的队列入队时属性与较小的消息体不再申请内存
+//   · 队列排空且容量过大时缩回初始大小，序号保持连续；槽位在第一次入队时才分配
+// ===========================================================================
+class msg_ring {
+public:
+    static constexpr std::size_t MIN_SLOTS       = 64;
+    static constexpr std::size_t IDLE_MAX_SLOTS  = 1 << 16;   // 排空后保留的最大容量
+    static constexpr std::size_t BODY_KEEP_BYTES = 1024;      // 空位保留的消息体容量上限
+
+    msg_ring() = default;
+
+    std::size_t size() const  { return __live; }
+    bool        empty() const { return __live == 0; }
+
+    // 头尾序号：[head, tail) 内的槽位可能是空位，遍历时检查 live
+    uint64_t head() const { return __head; }
+    uint64_t tail() const { return __tail; }
+
+    msg_desc&       slot(uint64_t seq)       { return __slots[seq & (__slots.size() - 1)]; }
+    const msg_desc& slot(uint64_t seq) const { return __slots[seq & (__slots.size() - 1)]; }
+
+    // 已删除或不在 [head, tail) 内返回 nullptr
+    msg_desc* get(uint64_t seq)
+    {
+        if (seq - __head >= __tail - __head) return nullptr;
+        msg_desc& d = slot(seq);
+        return d.live ? &d : nullptr;
+    }
+
+    // 队首存活消息（erase 总会把队首推进到存活槽位）
+    msg_desc*       front()       { return __live ? &slot(__head) : nullptr; }
+    const msg_desc* front() const { return __live ? &slot(__head) : nullptr; }
+
+    // 在队尾取一个空槽由调用方就地填写；返回的引用在下次 emplace / push 前有效
+    msg_desc& emplace_back()
+    {
+        if (__tail - __head == __slots.size()) grow();
+        msg_desc& d = slot(__tail++);
+        d.live = true;
+        ++__live;
+        return d;
+    }
+
+    // 撤销刚 emplace_back 的槽位（例如落盘失败）
+    void pop_back()
+    {
+        recycle(slot(--__tail));
+        --__live;
+    }
+
+    void push_front(msg_desc&& d)
+    {
+        if (__tail - __head == __slots.size()) grow();
+        msg_desc& s = slot(--__head);
+        s      = std::move(d);
+        s.live = true;
+        ++__live;
+    }
+
+    void erase(uint64_t seq)
+    {
+        msg_desc& d = slot(seq);
+        if (!d.live) return;
+        recycle(d);
+        --__live;
+        while (__head != __tail && !slot(__head).live) ++__head;
+        if (__live == 0 && __slots.size() > IDLE_MAX_SLOTS) {
+            std::vector<msg_desc>(MIN_SLOTS).swap(__slots);
+            __head = __tail;
+        }
+    }
+
+    void clear()
+    {
+        std::vector<msg_desc>().swap(__slots);
+        __head = __tail = 0;
+        __live = 0;
+    }
+
+private:
+    static void recycle(msg_desc& d)
+    {
+        d.live = false;
+        d.props.Clear();
+        if (d.body.capacity() > BODY_KEEP_BYTES) std::string().swap(d.body);
+        else d.body.clear();
+        d.shared.reset();
+        d.offset = d.length = d.bytes = d.timer = 0;
+    }
+
+    void grow()
+    {
+        std::vector<msg_desc> bigger(std::max(MIN_SLOTS, __slots.size() * 2));
+        for (uint64_t s = __head; s != __tail; ++s)
+            bigger[s & (bigger.size() - 1)] = std::move(slot(s));
+        __slots.swap(bigger);
+    }
+
+    std::vector<msg_desc> __slots;
+    uint64_t              __head{0};
+    uint64_t              __tail{0};
+    std::size_t           __live{0};
+};
+
+// 就绪列表中的位置：优先级层 + 该层环内的序号
+struct msg_pos {
+    uint8_t  level{0};
+    uint64_t seq{0};
+};
+
+// ===========================================================================
+// prio_ring : 按优先级分层的就绪列表（x-max-priority）
+//   · 每个优先级一条 msg_ring，层内 FIFO；非空层记在位图里
+//   · 队首 = 位图最高置位层的队首：入队 / 出队 O(1)，取最高层只扫常数个 64 位字
+//   · 普通队列只有一层，行为与单条 msg_ring 相同
+//   · 直接通过 ring(level) 修改槽位内容可以，增删必须走本类以维护位图与计数
+// ===========================================================================
+class prio_ring {
+public:
+    static constexpr unsigned MAX_LEVELS = 256;          // x-max-priority 上限 255
+
+    explicit prio_ring(unsigned levels = 1)
+        : __rings(std::min(std::max(levels, 1u), MAX_LEVELS)),
+          __words((__rings.size() + 63) / 64) {}
+
+    unsigned    levels() const { return static_cast<unsigned>(__rings.size()); }
+    std::size_t size() const   { return __size; }
+    bool        empty() const  { return __size == 0; }
+
+    // 超过最高优先级的按最高处理（与 AMQP 约定一致）
+    unsigned level_of(const BasicProperties& props) const
+    {
+        return std::min<unsigned>(props.priority(), levels() - 1);
+    }
+
+    msg_ring&       ring(unsigned level)       { return __rings[level]; }
+    const msg_ring& ring(unsigned level) const { return __rings[level]; }
+
+    msg_desc&       slot(msg_pos p)       { return __rings[p.level].slot(p.seq); }
+    const msg_desc& slot(msg_pos p) const { return __rings[p.level].slot(p.seq); }
+
+    // 最高非空层；为空时返回 0
+    unsigned top() const
+    {
+        for (unsigned w = __words; w-- > 0; )
+            if (__bits[w]) return w * 64 + 63 - static_cast<unsigned>(__builtin_clzll(__bits[w]));
+        return 0;
+    }
+
+    // 最低非空层（超长挤出时从这里取最旧的消息）；为空时返回 0
+    unsigned bottom() const
+    {
+        for (unsigned w = 0; w < __words; ++w)
+            if (__bits[w]) return w * 64 + static_cast<unsigned>(__builtin_ctzll(__bits[w]));
+        return 0;
+    }
+
+    msg_pos front_pos() const
+    {
+        unsigned l = top();
+        return {static_cast<uint8_t>(l), __rings[l].head()};
+    }
+
+    msg_desc*       front()       { return __size ? __rings[top()].front() : nullptr; }
+    const msg_desc* front() const { return __size ? __rings[top()].front() : nullptr; }
+
+    // 在 level 层队尾取空槽；pos 回填其位置
+    msg_desc& emplace_back(unsigned level, msg_pos& pos)
+    {
+        msg_ring& r = __rings[level];
+        pos = {static_cast<uint8_t>(level), r.tail()};
+        msg_desc& d = r.emplace_back();
+        mark(level);
+        ++__size;
+        return d;
+    }
+
+    void pop_back(unsigned level)
+    {
+        __rings[level].pop_back();
+        --__size;
+        if (__rings[level].empty()) unmark(level);
+    }
+
+    // 按消息自身的优先级放回对应层的队首
+    msg_pos push_front(msg_desc&& d)
+    {
+        unsigned  level = level_of(d.props);
+        msg_ring& r     = __rings[level];
+        r.push_front(std::move(d));
+        mark(level);
+        ++__size;
+        return {static_cast<uint8_t>(level), r.head()};
+    }
+
+    void erase(msg_pos p)
+    {
+        msg_ring& r = __rings[p.level];
+        if (!r.slot(p.seq).live) return;
+        r.erase(p.seq);
+        --__size;
+        if (r.empty()) unmark(p.level);
+    }
+
+    void clear()
+    {
+        for (auto& r : __rings) r.clear();
+        std::fill(std::begin(__bits), std::end(__bits), 0);
+        __size = 0;
+    }
+
+private:
+    void mark(unsigned level)   { __bits[level / 64] |= uint64_t(1) << (level % 64); }
+    void unmark(unsigned level) { __bits[level / 64] &= ~(uint64_t(1) << (level % 64)); }
+
+    std::vector<msg_ring> __rings;
+    unsigned              __words;
+    uint64_t              __bits[MAX_LEVELS / 64] = {};
+    std::size_t           __size{0};
+};
+
+}
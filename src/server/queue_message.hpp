@@ -1,11 +1,26 @@
-
 #pragma once
-#include <deque>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include <algorithm>            // 新增
+#include <atomic>
+#include <thread>
 #include "../common/msg.pb.h"      // BasicProperties
 #include "../common/message.hpp"   // 若已有真正定义则直接用它
+#include "segment_log.hpp"         // 持久化：分段追加日志
+#include "msg_ring.hpp"            // 就绪列表：环形数组
+#include "mpsc_ring.hpp"           // x-ingress-ring：无锁入队环
+#include "group_commit.hpp"        // 持久化：成批 fdatasync
+#include "timer_wheel.hpp"         // 消息过期
+#include "../common/compress.hpp"  // x-compression = zlib
+#include "../common/metrics.hpp"
 
 namespace hz_mq {
 
@@ -20,46 +35,1016 @@ namespace hz_mq {
 
 using message_ptr = std::shared_ptr<Message>;
 
-class queue_message {
+// 队列参数：x-queue-mode = lazy 时消息体换出到段文件，内存只保留队首窗口
+inline constexpr const char* QUEUE_MODE_ARG  = "x-queue-mode";
+inline constexpr const char* QUEUE_MODE_LAZY = "lazy";
+
+// 消息 TTL：每条消息入队时定下 expire_at，到期由时间轮逐条丢弃（见 timer_wheel）
+// 保留策略：按整段删除段日志中的消息（只作用于写入段日志的消息：持久化消息 / lazy 队列）
+inline constexpr const char* MESSAGE_TTL_ARG     = "x-message-ttl";         // 毫秒
+inline constexpr const char* RETENTION_BYTES_ARG = "x-retention-bytes";     // 段文件总字节
+
+// 长度上限：就绪消息条数 / 消息体总字节（未确认的不计），入队时检查，超出按 x-overflow 处理
+inline constexpr const char* MAX_LENGTH_ARG       = "x-max-length";
+inline constexpr const char* MAX_LENGTH_BYTES_ARG = "x-max-length-bytes";
+inline constexpr const char* OVERFLOW_ARG               = "x-overflow";
+inline constexpr const char* OVERFLOW_DROP_HEAD         = "drop-head";            // 缺省：挤出最旧的消息
+inline constexpr const char* OVERFLOW_REJECT_PUBLISH    = "reject-publish";       // 拒收新消息
+inline constexpr const char* OVERFLOW_REJECT_PUBLISH_DLX = "reject-publish-dlx";  // 拒收并转投死信
+
+enum class overflow_policy : uint8_t { drop_head, reject_publish, reject_publish_dlx };
+
+// 优先级队列：BasicProperties.priority 取 0..x-max-priority（最大 255），高优先级先出
+inline constexpr const char* MAX_PRIORITY_ARG = "x-max-priority";
+
+// 死信：被拒绝（不退回）/ 过期 / 超长挤出的消息经该交换机重新路由；
+// 交换机可以是 ""（默认直连），路由键缺省时沿用原消息的 routing_key
+inline constexpr const char* DEAD_LETTER_EXCHANGE_ARG    = "x-dead-letter-exchange";
+inline constexpr const char* DEAD_LETTER_ROUTING_KEY_ARG = "x-dead-letter-routing-key";
+
+// 无锁入队：值为环的槽位数（向上取整为 2 的幂，0 / 缺省为关闭）。
+// 开启后非持久化消息由发布方无锁写入 ingress 环，持有队列锁的一方（消费 / 加锁入队）先把环并入就绪列表
+inline constexpr const char* INGRESS_RING_ARG = "x-ingress-ring";
+
+// BasicProperties.death_reason 的取值（与 AMQP x-death 一致）
+inline constexpr const char* DEATH_REJECTED = "rejected";
+inline constexpr const char* DEATH_EXPIRED  = "expired";
+inline constexpr const char* DEATH_MAXLEN   = "maxlen";
+
+// ---------------------------------------------------------------------------
+// queue_message : 单个队列的内存就绪列表 + 磁盘段日志
+//   · 持久化队列 && delivery_mode == DURABLE 的消息追加到 <base_dir>/<queue_name>/*.mqd
+//   · remove() 在日志中把记录置为无效；recovery() 顺序扫描段文件重建就绪列表
+//   · 就绪列表为 prio_ring（每个优先级一条 msg_ring，消息描述按值存放在连续槽位中）
+//     + id -> 位置索引，按 id 删除 / ack 为 O(1)；无 id 的消息入队时补发；
+//     pop_front() 出队时才生成 Message
+//   · x-max-priority：同优先级 FIFO，front() 总是最高优先级的就绪消息；普通队列只有一层
+//   · 手动确认：deliver() 把队首移入 unacked 集合并返回凭据，ack() 才真正删除，
+//     requeue() 放回队首；未确认的持久化消息在段日志中仍有效，重启后重新就绪
+//   · 给定 committer 时追加只进缓冲，由 group_commit 成批落盘
+//   · compact() 由后台 compactor 调用，重写无效占比高的封存段
+//   · 启动时可先 mark_recovering()，recovery() 完成前 ready() 为 false
+//   · checkpoint() 由 checkpointer 定期调用；recovery() 有检查点时只扫描其后的日志尾部
+//   · lazy 模式：所有消息都写入段日志（非持久的标 RECORD_TRANSIENT），
+//     只有队首 LAZY_WINDOW 条保留消息体，其余只留属性与 offset；
+//     常驻数降到一半时顺序换入下一批（预读）；出队时队首未换入（高优先级插队）则同步读回
+//   · x-compression = zlib：较大的明文消息体入队前压缩，内存与段文件中都存压缩形式
+//   · x-message-ttl / BasicProperties.expiration：入队时取两者较小值写入 expire_at（随记录落盘），
+//     并在 timers 时间轮上登记；到期由 expire() 按位置丢弃，无需扫描队列。
+//     消息先离开就绪列表（消费 / 投递 / 删除）时取消其定时器，轮上只留仍就绪的消息
+//     出队时队首已过期（时间轮还没走到）也直接丢弃；未确认的消息不过期
+//   · 延迟投递暂存（virtual_host 内部队列）：消息带 deliver_at，以其为截止时间登记时间轮；
+//     到期由 take_due() 移入 unacked 交给调用方路由，路由结果落盘后再 ack()
+//   · x-dead-letter-exchange：过期 / reject(不退回) 的消息不直接丢弃，连同消息体移入死信列表
+//     并标上 death_reason，由 virtual_host 取走（take_dead()）后重新路由；未配置时照旧丢弃
+//   · x-max-length / x-max-length-bytes：就绪条数与字节数随增删 O(1) 维护，insert() 时比较；
+//     超出时 drop-head 挤出最低优先级层最旧的消息（有死信交换机则以 maxlen 转投），
+//     reject-publish(-dlx) 拒收新消息（-dlx 另将其转投死信），insert() 返回 false 并置 *full
+//   · x-message-ttl / x-retention-bytes：apply_retention() 由 compactor 定期调用，
+//     整段删除过期或超量的最旧段，并移除内存中对应的消息（粒度为段，回收磁盘）
+//   · x-ingress-ring：不落盘的消息（非持久化、非 lazy、溢出策略为 drop-head）由 insert() 写入
+//     mpsc_ring 后立即返回，不碰队列锁；任何 lock_ready() 的调用方（出队 / 查看 / 加锁入队）
+//     即环的唯一消费者，先按发布顺序把环并入就绪列表，长度上限、TTL 登记都在并入时处理。
+//     并入止于第一个还在写入的槽位，不在锁内等；那条的发布方返回后照常通知就绪，由下一次并入取走。
+//     需要同步结论的（落盘、reject-publish）以及环满时走原来的加锁路径
+// ---------------------------------------------------------------------------
+class queue_message : public std::enable_shared_from_this<queue_message> {
 public:
-    using ptr = std::shared_ptr<queue_message>;
+    using ptr  = std::shared_ptr<queue_message>;
+    using args = std::unordered_map<std::string, std::string>;
 
-    queue_message(const std::string&, const std::string&) {}   // base_dir / queue_name
+    static constexpr std::size_t LAZY_WINDOW = 256;     // lazy 队列常驻内存的消息体条数
 
+    queue_message(const std::string& base_dir, const std::string& queue_name,
+                  const group_commit::ptr& committer = nullptr,
+                  uint64_t segment_bytes = segment_log::DEFAULT_SEGMENT_BYTES,
+                  const args& qargs = {},
+                  const timer_wheel::ptr& timers = nullptr)
+        : name_(queue_name), dir_(base_dir + "/" + queue_name), committer_(committer),
+          segment_bytes_(segment_bytes), timers_(timers), ring_(priority_levels(qargs))
+    {
+        auto it = qargs.find(QUEUE_MODE_ARG);
+        lazy_ = it != qargs.end() && it->second == QUEUE_MODE_LAZY;
+        it = qargs.find(COMPRESSION_ARG);
+        compress_ = it != qargs.end() && it->second == COMPRESSION_ZLIB;
+        it = qargs.find(MESSAGE_TTL_ARG);
+        if (it != qargs.end()) ttl_ms_ = std::strtoll(it->second.c_str(), nullptr, 10);
+        it = qargs.find(RETENTION_BYTES_ARG);
+        if (it != qargs.end()) retain_bytes_ = std::strtoull(it->second.c_str(), nullptr, 10);
+        it = qargs.find(MAX_LENGTH_ARG);
+        if (it != qargs.end()) max_len_ = std::strtoull(it->second.c_str(), nullptr, 10);
+        it = qargs.find(MAX_LENGTH_BYTES_ARG);
+        if (it != qargs.end()) max_bytes_ = std::strtoull(it->second.c_str(), nullptr, 10);
+        it = qargs.find(OVERFLOW_ARG);
+        if (it != qargs.end()) {
+            if (it->second == OVERFLOW_REJECT_PUBLISH)     overflow_ = overflow_policy::reject_publish;
+            if (it->second == OVERFLOW_REJECT_PUBLISH_DLX) overflow_ = overflow_policy::reject_publish_dlx;
+        }
+        it = qargs.find(INGRESS_RING_ARG);
+        if (it != qargs.end()) {
+            std::size_t slots = std::strtoull(it->second.c_str(), nullptr, 10);
+            if (slots) ingress_ = std::make_unique<mpsc_ring<msg_desc>>(slots);
+        }
+        it = qargs.find(DEAD_LETTER_EXCHANGE_ARG);
+        if (it != qargs.end()) {
+            dead_letter_ = true;
+            dlx_ = it->second;
+            it = qargs.find(DEAD_LETTER_ROUTING_KEY_ARG);
+            if (it != qargs.end()) dlx_key_ = it->second;
+        }
+    }
+
+    const std::string& name() const { return name_; }
+    bool lazy() const { return lazy_; }
+    unsigned max_priority() const { return ring_.levels() - 1; }
+
+    // 构造后不变，读取无需加锁
+    bool dead_letters() const { return dead_letter_; }
+    const std::string& dead_letter_exchange() const    { return dlx_; }
+    const std::string& dead_letter_routing_key() const { return dlx_key_; }
+
+    // full 非空时回填：因超出长度上限被拒收（区别于落盘失败）；
+    // span 非空时并入本次持久化追加在 group_commit 中的序号，调用方只等自己的这几条落盘
     bool insert(BasicProperties* bp,
                 const std::string& body,
-                bool /*durable_unused*/)
+                bool durable,
+                bool* full = nullptr,
+                durable_span* span = nullptr)
+    {
+        return enqueue(bp, body, nullptr, nullptr, durable, full, span);
+    }
+
+    // 接管消息体（死信 / 延迟到期等 broker 内部转投），省去一次拷贝
+    bool insert(BasicProperties* bp,
+                std::string&& body,
+                bool durable,
+                bool* full = nullptr,
+                durable_span* span = nullptr)
+    {
+        return enqueue(bp, body, &body, nullptr, durable, full, span);
+    }
+
+    // 扇出：多个队列共同引用同一份消息体，每个队列只多一个描述（压缩队列仍各自保存压缩结果）
+    bool insert(BasicProperties* bp,
+                const shared_body& body,
+                bool durable,
+                bool* full = nullptr,
+                durable_span* span = nullptr)
+    {
+        return enqueue(bp, *body, nullptr, &body, durable, full, span);
+    }
+
+    // 队首消息的拷贝，不出队（会顺带丢弃已过期的队首）
+    message_ptr front()
+    {
+        auto lock = lock_ready();
+        auto* d = live_front();
+        if (!d) return nullptr;
+        auto msg = d->to_message();
+        if (!resident(*d) && log_) log_->read(*msg);
+        return msg;
+    }
+
+    // 取出并删除队首（自动确认的消费路径），消息体直接移交不拷贝；
+    // share 非空时共享的消息体只交出引用（Message 不带消息体），调用方从 *share 读取
+    message_ptr pop_front(shared_body* share = nullptr)
     {
         auto msg = std::make_shared<Message>();
+        return pop_front(*msg, share) ? msg : nullptr;
+    }
 
-        if (bp)
-            *msg->mutable_payload()->mutable_properties() = *bp;   // 复制属性
+    // 同上，但填进调用方给出的 Message（投递热路径用 Arena 上的对象，免去每条消息的堆分配）；队列为空返回 false
+    bool pop_front(Message& out, shared_body* share = nullptr)
+    {
+        auto lock = lock_ready();
+        auto* d = live_front();
+        if (!d) return false;
+        msg_pos pos = ring_.front_pos();
+        fetch(*d);
+        unlink(pos);
+        d->move_to(out, share);
+        retire(pos);
+        page_in();
+        return true;
+    }
+
+    // 投递给手动确认的消费者：队首移出就绪列表，暂存到 unacked；inflight 回填确认凭据；share 同 pop_front()
+    message_ptr deliver(uint64_t& inflight, shared_body* share = nullptr)
+    {
+        auto msg = std::make_shared<Message>();
+        return deliver(inflight, *msg, share) ? msg : nullptr;
+    }
 
-        msg->mutable_payload()->set_body(body);
-        msgs_.push_back(std::move(msg));
+    bool deliver(uint64_t& inflight, Message& out, shared_body* share = nullptr)
+    {
+        auto lock = lock_ready();
+        auto* d = live_front();
+        if (!d) return false;
+        msg_pos pos = ring_.front_pos();
+        fetch(*d);
+        unindex(pos);
+        if (resident(*d)) --resident_;
+        d->copy_to(out, share);
+        inflight = ++next_inflight_;
+        unacked_.emplace(inflight, std::move(*d));
+        retire(pos);
+        page_in();
         return true;
     }
 
-    message_ptr front() const
-    {   return msgs_.empty() ? nullptr : msgs_.front(); }
+    // 确认：从 unacked 删除，持久化记录置无效；凭据未知返回 false
+    bool ack(uint64_t inflight)
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        auto it = unacked_.find(inflight);
+        if (it == unacked_.end()) return false;
+        drop(it->second);
+        unacked_.erase(it);
+        return true;
+    }
 
-    void remove(const std::string& id)      // id 为空 ⇒ 删除队首
+    // 拒绝且不退回：配置了死信交换机时移入死信列表，否则同 ack()
+    bool reject(uint64_t inflight)
     {
-        if (id.empty()) { if (!msgs_.empty()) msgs_.pop_front(); return; }
+        std::unique_lock<std::mutex> lock(mtx_);
+        auto it = unacked_.find(inflight);
+        if (it == unacked_.end()) return false;
+        if (dead_letter_) bury(it->second, DEATH_REJECTED);
+        drop(it->second);
+        unacked_.erase(it);
+        return true;
+    }
 
-        msgs_.erase(std::remove_if(msgs_.begin(), msgs_.end(),
-                    [&](const message_ptr& m){
-                        return m && m->payload().properties().id() == id;
-                    }),
-                    msgs_.end());
+    // 取走待转投的死信（调用方在锁外重新路由）
+    std::vector<message_ptr> take_dead()
+    {
+        std::vector<message_ptr> out;
+        if (!dead_pending_.load(std::memory_order_acquire)) return out;   // 常见情况不加锁
+        std::unique_lock<std::mutex> lock(mtx_);
+        out.swap(dead_);
+        dead_pending_.store(false, std::memory_order_relaxed);
+        return out;
     }
 
-    std::size_t getable_count() const { return msgs_.size(); }
+    // 退回：放回所属优先级层的队首（多条时按投递倒序调用即保持原顺序）
+    bool requeue(uint64_t inflight)
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        auto it = unacked_.find(inflight);
+        if (it == unacked_.end()) return false;
+        if (resident(it->second)) ++resident_;
+        msg_pos pos = ring_.push_front(std::move(it->second));
+        unacked_.erase(it);
+        const msg_desc& d = ring_.slot(pos);
+        ready_bytes_ += d.bytes;
+        index_.emplace(id_hash(d.props.id()), pos);
+        if (d.props.expire_at()) schedule(pos, d.props.expire_at());   // 投递时已取消旧定时器
+        return true;
+    }
 
-    void recovery() {}   // TODO: 以后实现磁盘恢复
+    std::size_t unacked_count() const
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        return unacked_.size();
+    }
+
+    // 时间轮到期：逐个核对位置上的消息确实已过期（交出与出队可能并发，位置上的消息可能已换过），返回丢弃条数；
+    // 配置了死信交换机时移入死信列表
+    std::size_t expire(const std::vector<msg_pos>& positions, int64_t now)
+    {
+        static metric& m_expired = metrics::instance().get("ttl.expired_messages");
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        std::size_t n = 0;
+        for (msg_pos pos : positions) {
+            if (pos.level >= ring_.levels()) continue;
+            msg_desc* d = ring_.ring(pos.level).get(pos.seq);
+            if (!d || !expired(*d, now)) continue;
+            if (dead_letter_) bury(pos, DEATH_EXPIRED);
+            erase(pos);
+            ++n;
+        }
+        if (n) {
+            page_in();
+            m_expired.observe(n);
+        }
+        return n;
+    }
+
+    // 延迟投递暂存队列用：到期消息移入 unacked（记录在日志中仍有效），返回凭据与消息。
+    // 调用方路由出去并等落盘后再 ack()；期间崩溃最多重复投递，不会丢
+    std::vector<std::pair<uint64_t, message_ptr>> take_due(const std::vector<msg_pos>& positions,
+                                                           int64_t now)
+    {
+        std::vector<std::pair<uint64_t, message_ptr>> out;
+        std::unique_lock<std::mutex> lock(mtx_);
+        for (msg_pos pos : positions) {
+            if (pos.level >= ring_.levels()) continue;
+            msg_desc* d = ring_.ring(pos.level).get(pos.seq);
+            if (!d || !expired(*d, now)) continue;
+            fetch(*d);
+            unindex(pos);
+            if (resident(*d)) --resident_;
+            uint64_t inflight = ++next_inflight_;
+            auto msg = std::make_shared<Message>();     // 消息体移交；unacked 里只需属性与 offset
+            *msg->mutable_payload()->mutable_properties() = d->props;
+            d->move_body(*msg->mutable_payload()->mutable_body());
+            msg->set_offset(d->offset);
+            msg->set_length(d->length);
+            unacked_.emplace(inflight, std::move(*d));
+            retire(pos);
+            out.emplace_back(inflight, std::move(msg));
+        }
+        if (!out.empty()) page_in();
+        return out;
+    }
+
+    // 到期项暂时处理不了（如目标队列还在恢复）：改到 deadline 重新挂上时间轮。
+    // 句柄照旧记在槽位里，消息离开时能取消；位置上已换成未到期的消息则不动
+    void defer(const std::vector<msg_pos>& positions, int64_t now, int64_t deadline)
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        for (msg_pos pos : positions) {
+            if (pos.level >= ring_.levels()) continue;
+            msg_desc* d = ring_.ring(pos.level).get(pos.seq);
+            if (!d || !expired(*d, now)) continue;
+            cancel_timer(*d);
+            schedule(pos, deadline);
+        }
+    }
+
+    // id 为空 ⇒ 删除队首（仅供内部 / 测试直接调用，网络确认路径在 virtual_host 拒绝空 id）；
+    // 返回是否删除了消息
+    bool remove(const std::string& id)
+    {
+        auto lock = lock_ready();
+        bool removed = false;
+        if (id.empty()) {
+            removed = !ring_.empty();
+            if (removed) erase(ring_.front_pos());
+            page_in();
+            return removed;
+        }
+
+        auto [first, last] = index_.equal_range(id_hash(id));
+        while (first != last) {
+            msg_pos   pos = first->second;
+            msg_desc& d   = ring_.slot(pos);
+            if (d.props.id() != id) { ++first; continue; }   // 哈希碰撞
+            first = index_.erase(first);
+            if (resident(d)) --resident_;
+            drop(d);
+            retire(pos);
+            removed = true;
+        }
+        page_in();
+        return removed;
+    }
+
+    // 含 ingress 环中已写入、尚未并入的消息
+    std::size_t getable_count() const
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        return ring_.size() + (ingress_ ? ingress_->size() : 0);
+    }
+
+    // 就绪消息计入 x-max-length-bytes 的字节数（不含 ingress 环中尚未并入的）
+    uint64_t getable_bytes() const
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        return ready_bytes_;
+    }
+
+    // 内存中持有消息体的条数（非 lazy 队列等于 getable_count）
+    std::size_t resident_count() const
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        return resident_;
+    }
+
+    // 扫描段文件，把仍有效的持久化消息按写入顺序放回就绪列表，返回恢复条数
+    std::size_t recovery()
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        std::size_t n = 0;
+        if (open_log()) {
+            log_checkpoint cp;
+            bool have_cp   = log_->load_checkpoint(cp);
+            auto recovered = log_->recover(!lazy_, have_cp ? &cp : nullptr);   // lazy：只恢复属性
+            n = recovered.size();
+            // 排在恢复期间已入队的同优先级消息之前：倒序插到各自层的队首
+            for (auto it = recovered.rbegin(); it != recovered.rend(); ++it) {
+                msg_desc d;
+                d.take(**it);
+                d.bytes = resident(d) ? d.body.size() : d.length;   // lazy 只恢复属性：按记录长度计
+                ready_bytes_ += d.bytes;
+                if (resident(d)) ++resident_;
+                msg_pos pos = ring_.push_front(std::move(d));
+                const msg_desc& m = ring_.slot(pos);
+                index_.emplace(id_hash(m.props.id()), pos);
+                if (m.props.expire_at()) schedule(pos, m.props.expire_at());
+            }
+            page_in();
+        }
+        ready_.store(true, std::memory_order_release);
+        return n;
+    }
+
+    void mark_recovering() { ready_.store(false, std::memory_order_release); }
+    bool ready() const     { return ready_.load(std::memory_order_acquire); }
+
+    // 删除队列时清理磁盘文件；之后的入队一律拒绝（并发的发布方可能仍持有本对象），不会重建段文件
+    void destroy()
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        destroyed_.store(true);
+        if (ingress_) {
+            while (pushing_.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+            ingress_->drain([](msg_desc& d) { d.body.clear(); d.shared.reset(); });
+        }
+        for (unsigned l = 0; l < ring_.levels(); ++l) {
+            msg_ring& r = ring_.ring(l);
+            for (uint64_t seq = r.head(); seq != r.tail(); ++seq) cancel_timer(r.slot(seq));
+        }
+        ring_.clear();
+        index_.clear();
+        unacked_.clear();
+        resident_ = 0;
+        ready_bytes_ = 0;
+        if (log_) { log_->destroy(); log_.reset(); }
+    }
+
+    // 压缩无效字节占比 >= ratio 的封存段，返回回收的字节数。
+    // 拷贝阶段不持队列锁；替换段文件并修正内存 offset 时才加锁。
+    uint64_t compact(double ratio, const std::function<void(uint64_t)>& throttle)
+    {
+        segment_log::ptr log;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            log = log_;
+        }
+        if (!log) return 0;
+
+        uint64_t reclaimed = 0;
+        for (uint64_t base : log->compaction_candidates(ratio)) {
+            segment_rewrite rw;
+            if (!log->rewrite(base, rw, throttle)) continue;
+
+            std::unique_lock<std::mutex> lock(mtx_);
+            if (log_ != log) return reclaimed;          // 队列已被删除
+            if (!log->install(rw)) continue;
+            relocate(rw);
+            reclaimed += rw.reclaimed;
+        }
+        return reclaimed;
+    }
+
+    // 写检查点：已落盘的持久化消息的属性与 offset（不含消息体），供下次启动跳过全量扫描。
+    // 队列锁内只拷贝描述，序列化与写文件在锁外
+    bool checkpoint()
+    {
+        log_checkpoint cp;
+        segment_log::ptr log;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            if (!log_) return false;
+            log = log_;
+            cp  = log_->begin_checkpoint();
+            for (unsigned l = 0; l < ring_.levels(); ++l) {
+                const msg_ring& r = ring_.ring(l);
+                for (uint64_t seq = r.head(); seq != r.tail(); ++seq) {
+                    const msg_desc& m = r.slot(seq);
+                    if (!m.live || m.length == 0 || m.offset >= cp.tail ||
+                        m.props.delivery_mode() != DeliveryMode::DURABLE)
+                        continue;
+                    auto d = std::make_shared<Message>();
+                    *d->mutable_payload()->mutable_properties() = m.props;
+                    d->set_offset(m.offset);
+                    d->set_length(m.length);
+                    cp.live.push_back(std::move(d));
+                }
+            }
+            // 多个优先级层、未确认的消息（仍是有效记录）打乱了顺序；快照要求按 offset 递增
+            std::size_t ready = cp.live.size();
+            for (const auto& [_, m] : unacked_) {
+                if (m.length == 0 || m.offset >= cp.tail ||
+                    m.props.delivery_mode() != DeliveryMode::DURABLE)
+                    continue;
+                auto d = std::make_shared<Message>();
+                *d->mutable_payload()->mutable_properties() = m.props;
+                d->set_offset(m.offset);
+                d->set_length(m.length);
+                cp.live.push_back(std::move(d));
+            }
+            if (ring_.levels() > 1 || cp.live.size() > ready)
+                std::sort(cp.live.begin(), cp.live.end(),
+                          [](const message_ptr& a, const message_ptr& b) { return a->offset() < b->offset(); });
+        }
+        return log->save_checkpoint(cp);
+    }
+
+    // 执行保留策略，返回移除的消息条数
+    std::size_t apply_retention()
+    {
+        static metric& m_dropped = metrics::instance().get("retention.dropped_messages");
+
+        if (ttl_ms_ <= 0 && retain_bytes_ == 0) return 0;
+        std::unique_lock<std::mutex> lock(mtx_);
+        if (!log_) return 0;
+
+        int64_t cutoff = 0;
+        if (ttl_ms_ > 0) {
+            using namespace std::chrono;
+            cutoff = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() - ttl_ms_;
+        }
+        // 已投递未确认的消息确认 / 退回时还要用到段里的记录：从其中最小的 offset 起不删
+        uint64_t hold = UINT64_MAX;
+        for (const auto& [_, d] : unacked_)
+            if (d.length) hold = std::min(hold, d.offset);
+        uint64_t floor = log_->retain(retain_bytes_, cutoff, hold);
+        if (floor == 0) return 0;
+
+        // 写入段日志的消息在每个优先级层内按 offset 递增，删掉的段总是各层最旧的一段前缀
+        std::size_t n = 0;
+        for (unsigned l = 0; l < ring_.levels(); ++l) {
+            const msg_ring& r = ring_.ring(l);
+            for (uint64_t seq = r.head(), end = r.tail(); seq != end; ++seq) {
+                const msg_desc& m = r.slot(seq);
+                if (!m.live || m.length == 0) continue;      // 只在内存中的消息不受影响
+                if (m.offset >= floor) break;
+                erase({static_cast<uint8_t>(l), seq});
+                ++n;
+            }
+        }
+        page_in();
+        if (n) m_dropped.observe(n);
+        return n;
+    }
 
 private:
-    std::deque<message_ptr> msgs_;
+    // owned 非空时（与 body 为同一对象）消息体直接换入槽位；share 非空时（*share 即 body）只记引用；
+    // 否则拷贝
+    bool enqueue(BasicProperties* bp, const std::string& body, std::string* owned,
+                 const shared_body* share, bool durable, bool* full, durable_span* span)
+    {
+        // 压缩在加锁前完成；压缩不划算时保留原文
+        std::string packed;
+        bool zipped = compress_ && body.size() >= COMPRESS_MIN_BYTES &&
+                      (!bp || bp->content_encoding() == ContentEncoding::IDENTITY) &&
+                      zlib_compress(body, packed);
+
+        unsigned level    = bp ? ring_.level_of(*bp) : 0;
+        int64_t  deadline = expire_deadline(bp);
+        uint64_t bytes    = zipped ? packed.size() : body.size();
+
+        // x-ingress-ring：不落盘、也不需要同步拒收的消息无锁写入环，由下一个持锁者并入；环满退回加锁路径
+        bool persist = durable && bp && bp->delivery_mode() == DeliveryMode::DURABLE;
+        if (ingress_ && !persist && !lazy_ && overflow_ == overflow_policy::drop_head &&
+            push_ingress([&](msg_desc& d) {
+                fill(d, bp, deadline, zipped ? &packed : nullptr, body, owned, share, bytes);
+            }))
+            return true;
+
+        // 先并入环中更早发布的消息，保持先后顺序；还在写入的槽位不持锁等它们发布
+        if (ingress_) ingress_->wait_published();
+        auto lock = lock_ready();
+        if (destroyed_.load(std::memory_order_relaxed)) return false;
+        // 未设上限时两者都是最大值，这里恒不成立
+        if (ring_.size() >= max_len_ || ready_bytes_ + bytes > max_bytes_) {
+            if (!make_room(bytes)) {
+                if (overflow_ == overflow_policy::reject_publish_dlx && dead_letter_) {
+                    std::string copy;
+                    if (!owned) copy = body;
+                    bury(bp ? *bp : BasicProperties(), owned ? *owned : copy, DEATH_MAXLEN);
+                }
+                if (full) *full = true;
+                return false;
+            }
+        }
+        msg_pos   pos;
+        msg_desc& d = ring_.emplace_back(level, pos);   // 就地填写，复用槽位里已有的字符串
+        fill(d, bp, deadline, zipped ? &packed : nullptr, body, owned, share, bytes);
+
+        if (persist || lazy_) {
+            if (!open_log() || !append(d, persist ? RECORD_VALID : RECORD_TRANSIENT)) {
+                ring_.pop_back(level);
+                return false;                                       // 落盘失败则拒绝入队
+            }
+            if (committer_) {
+                uint64_t seq = committer_->notify(log_, d.length + sizeof(record_header));
+                if (persist && span) span->add(seq);      // lazy 换出的非持久消息不用等
+            }
+        }
+        // lazy：窗口已满或前面已有换出的消息 ⇒ 只留属性，消息体留在段文件
+        if (lazy_ && (resident_ >= LAZY_WINDOW || resident_ + 1 < ring_.size())) {
+            std::string().swap(d.body);
+            d.shared.reset();
+        }
+        if (resident(d)) ++resident_;
+        ready_bytes_ += bytes;
+        index_.emplace(id_hash(d.props.id()), pos);
+        if (deadline) schedule(pos, deadline);
+        return true;
+    }
+
+    // 填写新消息的描述：复制属性，过期时刻由 broker 决定（覆盖客户端带来的值），
+    // 消息体依次取压缩结果 / 接管 / 共享 / 拷贝，没有 id 的补发一个
+    static void fill(msg_desc& d, const BasicProperties* bp, int64_t deadline, std::string* packed,
+                     const std::string& body, std::string* owned, const shared_body* share,
+                     uint64_t bytes)
+    {
+        if (bp) d.props.CopyFrom(*bp);
+        else d.props.Clear();
+        d.props.set_expire_at(deadline);
+        if (packed) {
+            d.body.swap(*packed);
+            d.props.set_content_encoding(ContentEncoding::ZLIB);
+        } else if (owned) {
+            d.body.swap(*owned);
+        } else if (share) {
+            d.shared = *share;
+        } else {
+            d.body.assign(body);
+        }
+        if (d.props.id().empty()) d.props.set_id(next_id());
+        d.bytes = bytes;
+    }
+
+    // 无锁写入 ingress 环。pushing_ 与 destroyed_ 成对（均为 seq_cst）：destroy() 置位后
+    // 要么这里看到已删除而拒绝，要么 destroy() 看到计数、等这次写入发布完再清空环
+    template <typename F>
+    bool push_ingress(F&& fill_slot)
+    {
+        pushing_.fetch_add(1);
+        bool ok = !destroyed_.load() && ingress_->try_push(std::forward<F>(fill_slot));
+        pushing_.fetch_sub(1, std::memory_order_release);
+        return ok;
+    }
+
+    // 加队列锁，并先把 ingress 环里已发布的消息并入就绪列表：持锁者就是环的唯一消费者
+    std::unique_lock<std::mutex> lock_ready()
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        if (ingress_) drain_ingress();
+        return lock;
+    }
+
+    // 按发布顺序并入：长度上限（drop-head）与 TTL 登记在这里处理，与加锁入队一致
+    void drain_ingress()                                 // 需持有 mtx_
+    {
+        ingress_->drain([this](msg_desc& in) {
+            if (ring_.size() >= max_len_ || ready_bytes_ + in.bytes > max_bytes_) {
+                if (!make_room(in.bytes)) {              // drop-head 下只有单条就超出字节上限才放不下：丢弃
+                    in.body.clear();
+                    in.shared.reset();
+                    return;
+                }
+            }
+            msg_pos   pos;
+            msg_desc& d = ring_.emplace_back(ring_.level_of(in.props), pos);
+            d.props.Swap(&in.props);                     // 交换：就绪槽位里原有的字符串容量留给环的下一次写入
+            d.body.swap(in.body);
+            d.shared = std::move(in.shared);
+            d.bytes  = in.bytes;
+            if (resident(d)) ++resident_;
+            ready_bytes_ += d.bytes;
+            index_.emplace(id_hash(d.props.id()), pos);
+            if (int64_t deadline = d.props.expire_at()) schedule(pos, deadline);
+        });
+    }
+
+    // 超出长度上限：drop-head 从最低优先级层的队首挤出，直到放得下；
+    // 拒收策略或单条消息本身就超出字节上限时返回 false
+    bool make_room(uint64_t bytes)                       // 需持有 mtx_
+    {
+        static metric& m_dropped  = metrics::instance().get("overflow.dropped_messages");
+        static metric& m_rejected = metrics::instance().get("overflow.rejected_publishes");
+
+        auto over = [&] { return ring_.size() >= max_len_ || ready_bytes_ + bytes > max_bytes_; };
+        std::size_t n = 0;
+        if (overflow_ == overflow_policy::drop_head) {
+            while (!ring_.empty() && over()) {
+                unsigned l = ring_.bottom();
+                msg_pos  pos{static_cast<uint8_t>(l), ring_.ring(l).head()};
+                if (dead_letter_) bury(pos, DEATH_MAXLEN);
+                erase(pos);
+                ++n;
+            }
+            if (n) {
+                page_in();
+                m_dropped.observe(n);
+            }
+        }
+        if (!over()) return true;
+        m_rejected.observe(1);
+        return false;
+    }
+
+    static constexpr uint64_t ID_BLOCK = 1024;
+
+    // 进程内唯一：启动时间戳 + 递增序号，避免与重启前落盘的 id 冲突。
+    // 每个线程一次领 ID_BLOCK 个序号，多线程向不同队列发布时不再争同一个计数器
+    static std::string next_id()
+    {
+        static const std::string prefix = std::to_string(
+            std::chrono::system_clock::now().time_since_epoch().count()) + "-";
+        static std::atomic<uint64_t> seq{0};
+        thread_local uint64_t next = 0, end = 0;
+        if (next == end) {
+            next = seq.fetch_add(ID_BLOCK, std::memory_order_relaxed);
+            end  = next + ID_BLOCK;
+        }
+        return prefix + std::to_string(++next);
+    }
+
+    static std::size_t id_hash(const std::string& id) { return std::hash<std::string>{}(id); }
+
+    static bool expired(const msg_desc& d, int64_t now)
+    {
+        return d.props.expire_at() != 0 && d.props.expire_at() <= now;
+    }
+
+    // 入队时的过期时刻：x-message-ttl 与消息自带 expiration 取较小者，都没有则为 0；
+    // 延迟投递暂存的消息以 deliver_at 为准
+    int64_t expire_deadline(const BasicProperties* bp) const
+    {
+        if (bp && bp->deliver_at()) return bp->deliver_at();
+        int64_t ttl = ttl_ms_ > 0 ? ttl_ms_ : 0;
+        if (bp && bp->expiration()) {
+            auto own = static_cast<int64_t>(std::min<uint64_t>(bp->expiration(), INT64_MAX / 2));
+            ttl = ttl ? std::min(ttl, own) : own;
+        }
+        return ttl ? timer_wheel::now() + ttl : 0;
+    }
+
+    // 句柄记在槽位里，消息离开就绪列表（retire）时取消
+    void schedule(msg_pos pos, int64_t deadline)        // 需持有 mtx_
+    {
+        if (timers_) ring_.slot(pos).timer = timers_->schedule(weak_from_this(), pos, deadline);
+    }
+
+    void cancel_timer(msg_desc& d)                       // 需持有 mtx_
+    {
+        if (d.timer && timers_) timers_->cancel(d.timer);
+        d.timer = 0;
+    }
+
+    // 跳过并丢弃（或移入死信列表）已过期的队首；只有带 expire_at 的队首才读时钟
+    msg_desc* live_front()                               // 需持有 mtx_
+    {
+        static metric& m_expired = metrics::instance().get("ttl.expired_messages");
+
+        msg_desc* d;
+        int64_t   now = 0;
+        std::size_t n = 0;
+        while ((d = ring_.front()) && d->props.expire_at()) {
+            if (!now) now = timer_wheel::now();
+            if (!expired(*d, now)) break;
+            if (dead_letter_) bury(ring_.front_pos(), DEATH_EXPIRED);
+            erase(ring_.front_pos());
+            ++n;
+        }
+        if (n) m_expired.observe(n);
+        return d;
+    }
+
+    // x-max-priority 缺省或非法时只有一层
+    static unsigned priority_levels(const args& qargs)
+    {
+        auto it = qargs.find(MAX_PRIORITY_ARG);
+        if (it == qargs.end()) return 1;
+        long max = std::strtol(it->second.c_str(), nullptr, 10);
+        return max > 0 ? static_cast<unsigned>(std::min<long>(max, prio_ring::MAX_LEVELS - 1)) + 1 : 1;
+    }
+
+    // 移入死信列表：属性与消息体移交（换出的先读回），随后由调用方 erase / drop
+    void bury(msg_pos pos, const char* reason)           // 需持有 mtx_
+    {
+        msg_desc& d = ring_.slot(pos);
+        fetch(d);
+        if (resident(d) && lazy_ && d.length) --resident_;    // 消息体被取走，不再计入常驻
+        bury(d, reason);
+    }
+
+    void bury(msg_desc& d, const char* reason)           // 需持有 mtx_
+    {
+        std::string body;
+        d.move_body(body);
+        bury(d.props, body, reason);
+    }
+
+    void bury(const BasicProperties& props, std::string& body, const char* reason)   // 需持有 mtx_
+    {
+        auto msg = std::make_shared<Message>();
+        msg->mutable_payload()->mutable_properties()->CopyFrom(props);
+        msg->mutable_payload()->mutable_properties()->set_death_reason(reason);
+        msg->mutable_payload()->mutable_body()->swap(body);
+        dead_.push_back(std::move(msg));
+        dead_pending_.store(true, std::memory_order_release);
+    }
+
+    // 已换出：记录在段文件中而内存里没有消息体
+    bool resident(const msg_desc& m) const
+    {
+        return !lazy_ || m.length == 0 || m.has_body();
+    }
+
+    // 借 scratch_ 序列化追加：属性与消息体换入、写完再换回，不拷贝；共享的消息体由 segment_log 直接写入
+    bool append(msg_desc& d, uint8_t flag)               // 需持有 mtx_
+    {
+        auto* payload = scratch_.mutable_payload();
+        payload->mutable_properties()->Swap(&d.props);
+        payload->mutable_body()->swap(d.body);
+        bool ok = log_->append(scratch_, flag, d.shared.get());
+        payload->mutable_properties()->Swap(&d.props);
+        payload->mutable_body()->swap(d.body);
+        d.offset = scratch_.offset();
+        d.length = scratch_.length();
+        return ok;
+    }
+
+    // lazy 预读：常驻条数降到窗口一半以下时，按出队顺序（高优先级层在前）换入直到窗口填满
+    void page_in()                                       // 需持有 mtx_
+    {
+        if (!lazy_ || !log_ || resident_ >= LAZY_WINDOW / 2 || resident_ == ring_.size())
+            return;
+
+        for (unsigned l = ring_.levels(); l-- > 0; ) {
+            msg_ring& r = ring_.ring(l);
+            for (uint64_t seq = r.head(); seq != r.tail(); ++seq) {
+                if (resident_ >= LAZY_WINDOW) return;
+                msg_desc& d = r.slot(seq);
+                if (!d.live || resident(d)) continue;
+                if (!fetch(d)) return;
+            }
+        }
+    }
+
+    // 换入单条消息体
+    bool fetch(msg_desc& d)                              // 需持有 mtx_
+    {
+        if (resident(d)) return true;
+        Message m = d.locator();
+        if (!log_ || !log_->read(m)) return false;
+        d.body.swap(*m.mutable_payload()->mutable_body());
+        if (resident(d)) ++resident_;
+        return true;
+    }
+
+    void unindex(msg_pos pos)                            // 需持有 mtx_
+    {
+        auto [first, last] = index_.equal_range(id_hash(ring_.slot(pos).props.id()));
+        for (; first != last; ++first) {
+            if (first->second.level == pos.level && first->second.seq == pos.seq) {
+                index_.erase(first);
+                break;
+            }
+        }
+    }
+
+    // 出队前的簿记：摘掉 id 索引、更新常驻计数、日志中置无效
+    void unlink(msg_pos pos)                             // 需持有 mtx_
+    {
+        msg_desc& d = ring_.slot(pos);
+        unindex(pos);
+        if (resident(d)) --resident_;
+        drop(d);
+    }
+
+    void erase(msg_pos pos)                              // 需持有 mtx_
+    {
+        unlink(pos);
+        retire(pos);
+    }
+
+    // 移出就绪列表并扣减字节计数（unacked 中的消息不计入上限）；过期定时器随之取消
+    void retire(msg_pos pos)                             // 需持有 mtx_
+    {
+        msg_desc& d = ring_.slot(pos);
+        cancel_timer(d);
+        ready_bytes_ -= d.bytes;
+        ring_.erase(pos);
+    }
+
+    bool open_log()                                      // 需持有 mtx_
+    {
+        if (!log_) {
+            auto log = std::make_shared<segment_log>(dir_, segment_bytes_,
+                                                     committer_ != nullptr);
+            if (!log->open()) return false;
+            // 批提交失败时丢弃的持久化记录：回调在提交线程、不持日志锁时执行
+            log->set_lost_callback([weak = weak_from_this()](const std::vector<uint64_t>& offsets) {
+                if (auto self = weak.lock()) self->drop_lost(offsets);
+            });
+            log_ = std::move(log);
+        }
+        return true;
+    }
+
+    // 所在批提交失败的持久化消息：记录已在日志中置无效，发布方收到失败后会重发，
+    // 就绪 / 未确认集合里都不再保留，避免重发后重复投递
+    void drop_lost(const std::vector<uint64_t>& offsets)
+    {
+        static metric& m_lost = metrics::instance().get("queue.commit_failed_dropped");
+
+        std::unordered_set<uint64_t> lost(offsets.begin(), offsets.end());
+        auto lock = lock_ready();
+        std::size_t n = 0;
+        for (unsigned l = 0; l < ring_.levels(); ++l) {
+            msg_ring& r = ring_.ring(l);
+            for (uint64_t seq = r.head(); seq != r.tail(); ++seq) {
+                const msg_desc& m = r.slot(seq);
+                if (!m.live || m.length == 0 || !lost.count(m.offset)) continue;
+                msg_pos pos{static_cast<uint8_t>(l), seq};
+                unindex(pos);
+                if (resident(m)) --resident_;
+                retire(pos);
+                ++n;
+            }
+        }
+        for (auto it = unacked_.begin(); it != unacked_.end(); ) {
+            if (it->second.length > 0 && lost.count(it->second.offset)) {
+                it = unacked_.erase(it);
+                ++n;
+            } else {
+                ++it;
+            }
+        }
+        page_in();
+        if (n) m_lost.observe(n);
+    }
+
+    // 持久化消息出队：在日志中懒删除（length > 0 即表示已落盘）
+    void drop(const msg_desc& m)                         // 需持有 mtx_
+    {
+        if (log_ && m.length > 0) log_->invalidate(m.locator());
+    }
+
+    // 段重写后修正内存消息的 offset；拷贝期间被删除的消息在新段中补标无效
+    void relocate(const segment_rewrite& rw)             // 需持有 mtx_
+    {
+        if (rw.moved.empty()) return;
+
+        std::unordered_map<uint64_t, const moved_record*> moved;
+        moved.reserve(rw.moved.size());
+        for (const auto& r : rw.moved) moved.emplace(r.from, &r);
+
+        for (unsigned l = 0; l < ring_.levels(); ++l) {
+            msg_ring& r = ring_.ring(l);
+            for (uint64_t seq = r.head(); seq != r.tail(); ++seq) {
+                msg_desc& m = r.slot(seq);
+                if (!m.live || m.length == 0) continue;
+                auto it = moved.find(m.offset);
+                if (it == moved.end()) continue;
+                m.offset = it->second->to;
+                moved.erase(it);
+            }
+        }
+        for (auto& [_, m] : unacked_) {
+            if (m.length == 0) continue;
+            auto it = moved.find(m.offset);
+            if (it == moved.end()) continue;
+            m.offset = it->second->to;
+            moved.erase(it);
+        }
+        for (const auto& [_, r] : moved) {
+            Message stale;
+            stale.set_offset(r->to);
+            stale.set_length(r->length);
+            log_->invalidate(stale);
+        }
+    }
+
+    std::string             name_;
+    std::string             dir_;
+    group_commit::ptr       committer_;
+    uint64_t                segment_bytes_;
+    timer_wheel::ptr        timers_;            // 为空时只在出队时检查队首是否过期
+    mutable std::mutex      mtx_;
+    segment_log::ptr        log_;
+    prio_ring               ring_;
+    std::unordered_multimap<std::size_t, msg_pos> index_;    // hash(id) -> 就绪列表位置，命中后再比对 id
+    Message                 scratch_;           // append() 序列化用，避免每条消息构造 Message
+    std::unordered_map<uint64_t, msg_desc> unacked_;   // inflight -> 已投递未确认的消息
+    uint64_t                next_inflight_{0};
+    std::atomic<bool>       ready_{true};       // 恢复完成前拒绝读写
+    std::atomic<bool>       destroyed_{false};  // destroy() 之后拒绝入队（ingress 路径无锁读取）
+    std::atomic<int>        pushing_{0};        // 正在写入 ingress 环的生产者数，destroy() 等它归零
+    std::unique_ptr<mpsc_ring<msg_desc>> ingress_;  // x-ingress-ring，未开启为空；槽位只在持 mtx_ 时取出
+    bool                    lazy_{false};
+    bool                    compress_{false};
+    int64_t                 ttl_ms_{0};         // x-message-ttl，0 表示不限
+    uint64_t                retain_bytes_{0};   // x-retention-bytes，0 表示不限
+    std::size_t             max_len_{SIZE_MAX};         // x-max-length
+    uint64_t                max_bytes_{UINT64_MAX};     // x-max-length-bytes
+    uint64_t                ready_bytes_{0};    // 就绪消息的 bytes 之和
+    overflow_policy         overflow_{overflow_policy::drop_head};
+    std::size_t             resident_{0};       // 持有消息体的条数
+    bool                    dead_letter_{false};    // 配置了 x-dead-letter-exchange
+    std::string             dlx_;
+    std::string             dlx_key_;           // 空则沿用原 routing_key
+    std::vector<message_ptr> dead_;             // 待 virtual_host 转投的死信
+    std::atomic<bool>       dead_pending_{false};   // dead_ 非空；take_dead() 无锁预检
 };
 
-}   
+}
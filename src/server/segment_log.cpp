@@ -0,0 +1,857 @@
+// ======================= segment_log.cpp =======================
+#include "segment_log.hpp"
+#include "../common/logger.hpp"
+#include "../common/crc32c.hpp"
+#include "../common/file_io.hpp"
+#include "../common/metrics.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hz_mq {
+
+namespace fs = std::filesystem;
+
+// -----------------------------------------------------------------------------
+// helpers
+// -----------------------------------------------------------------------------
+static bool pwrite_all(int fd, const char* data, size_t len, uint64_t pos)
+{
+    while (len > 0) {
+        ssize_t n = fio().pwrite(fd, data, len, static_cast<off_t>(pos));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        pos  += static_cast<uint64_t>(n);
+        len  -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static bool pread_all(int fd, char* data, size_t len, uint64_t pos)
+{
+    while (len > 0) {
+        ssize_t n = ::pread(fd, data, len, static_cast<off_t>(pos));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) return false;        // 读到文件尾，记录不完整
+        data += n;
+        pos  += static_cast<uint64_t>(n);
+        len  -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// 记录校验：MessagePayload.valid = 其余字段序列化字节的 CRC32C（8 位十六进制）。
+// valid 是 payload 的最后一个字段，序列化后固定占记录末尾 CRC_FIELD_BYTES 字节，
+// 因此无需解析即可在原始字节上校验。
+// -----------------------------------------------------------------------------
+static constexpr size_t CRC_HEX_BYTES   = 8;
+static constexpr size_t CRC_FIELD_BYTES = 2 + CRC_HEX_BYTES;                     // tag + len + hex
+static constexpr char   CRC_FIELD_TAG   = (MessagePayload::kValidFieldNumber << 3) | 2;
+
+static void crc_hex(uint32_t crc, char* out)
+{
+    static const char digits[] = "0123456789abcdef";
+    for (int i = CRC_HEX_BYTES - 1; i >= 0; --i, crc >>= 4) out[i] = digits[crc & 0xF];
+}
+
+// 每条记录写入时都带 valid 字段：缺失或 tag / 长度字节不对同样算校验失败
+static bool verify_record(const char* payload, size_t len)
+{
+    const char* field = len >= CRC_FIELD_BYTES ? payload + len - CRC_FIELD_BYTES : nullptr;
+    if (field && field[0] == CRC_FIELD_TAG && field[1] == static_cast<char>(CRC_HEX_BYTES)) {
+        char expect[CRC_HEX_BYTES];
+        crc_hex(crc32c(payload, len - CRC_FIELD_BYTES), expect);
+        if (std::memcmp(expect, field + 2, CRC_HEX_BYTES) == 0) return true;
+    }
+
+    static metric& m_errors = metrics::instance().get("segment.crc_errors");
+    m_errors.observe(1);
+    return false;
+}
+
+static size_t put_varint(char* out, uint64_t v)
+{
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = static_cast<char>(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = static_cast<char>(v);
+    return n;
+}
+
+static int64_t now_ms()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+static std::string segment_name(uint64_t base)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof buf, "%020" PRIu64 ".mqd", base);
+    return buf;
+}
+
+// -----------------------------------------------------------------------------
+// segment
+// -----------------------------------------------------------------------------
+segment::~segment()
+{
+    if (map) ::munmap(const_cast<char*>(map), map_len);
+    if (fd >= 0) ::close(fd);
+}
+
+// -----------------------------------------------------------------------------
+// segment_log
+// -----------------------------------------------------------------------------
+segment_log::segment_log(const std::string& dir, uint64_t segment_bytes, bool buffered)
+    : __dir(dir), __segment_bytes(segment_bytes), __buffered(buffered) {}
+
+bool segment_log::open()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    if (__active) return true;
+
+    std::error_code ec;
+    fs::create_directories(__dir, ec);
+    if (ec) {
+        LOG(ERROR) << "create queue dir [" << __dir << "] failed: " << ec.message();
+        return false;
+    }
+
+    for (const auto& entry : fs::directory_iterator(__dir, ec)) {
+        if (entry.path().extension() == ".compact") {       // 压缩中途退出留下的临时文件
+            fs::remove(entry.path(), ec);
+            continue;
+        }
+        if (entry.path().extension() != ".mqd") continue;
+        uint64_t base = std::strtoull(entry.path().stem().c_str(), nullptr, 10);
+        if (!open_segment(base, false)) return false;
+    }
+
+    if (__segments.empty() && !open_segment(0, true)) return false;
+    __active = __segments.rbegin()->second;
+    return true;
+}
+
+segment::ptr segment_log::open_segment(uint64_t base, bool create)
+{
+    auto seg  = std::make_shared<segment>();
+    seg->base = base;
+    seg->path = __dir + "/" + segment_name(base);
+    seg->fd   = ::open(seg->path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT : 0), 0644);
+    if (seg->fd < 0) {
+        LOG(ERROR) << "open segment [" << seg->path << "] failed: " << std::strerror(errno);
+        return nullptr;
+    }
+
+    struct stat st {};
+    if (::fstat(seg->fd, &st) != 0) return nullptr;
+    seg->size     = static_cast<uint64_t>(st.st_size);
+    seg->first_ms = seg->last_ms = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000 +
+                                   st.st_mtim.tv_nsec / 1000000;
+
+    __segments[base] = seg;
+    return seg;
+}
+
+segment::ptr segment_log::locate(uint64_t offset)
+{
+    auto it = __segments.upper_bound(offset);
+    if (it == __segments.begin()) return nullptr;
+    --it;
+    const auto& seg = it->second;
+    return offset < seg->base + seg->size ? seg : nullptr;
+}
+
+bool segment_log::roll()
+{
+    // 封存当前段：此后它只会被改写 flag，不再追加
+    if (__buffered) {
+        __unsynced.push_back(__active);            // 缓冲留给下一次提交一并写出并 fdatasync
+    } else {
+        fio().fdatasync(__active->fd);
+    }
+
+    auto seg = open_segment(__active->base + __active->size, true);
+    if (!seg) return false;
+    __active = std::move(seg);
+    return true;
+}
+
+bool segment_log::append(Message& msg, uint8_t flag, const std::string* body)
+{
+    std::string data;
+    data.resize(sizeof(record_header));
+    msg.mutable_payload()->clear_valid();
+    if (!msg.payload().AppendToString(&data)) return false;
+
+    // 消息体在 msg 之外（扇出共享）：按 body 字段的线格式接在属性之后，与 set_body 后序列化的字节一致
+    if (body && !body->empty()) {
+        char   field_hdr[16];
+        size_t hdr_len = put_varint(field_hdr, (MessagePayload::kBodyFieldNumber << 3) | 2);
+        hdr_len += put_varint(field_hdr + hdr_len, body->size());
+        data.reserve(data.size() + hdr_len + body->size() + CRC_FIELD_BYTES);
+        data.append(field_hdr, hdr_len);
+        data.append(*body);
+    }
+
+    // 追加 valid 字段：CRC32C 覆盖 payload 其余全部字节
+    char field[CRC_FIELD_BYTES] = {CRC_FIELD_TAG, static_cast<char>(CRC_HEX_BYTES)};
+    crc_hex(crc32c(data.data() + sizeof(record_header), data.size() - sizeof(record_header)),
+            field + 2);
+    data.append(field, CRC_FIELD_BYTES);
+    msg.mutable_payload()->set_valid(field + 2, CRC_HEX_BYTES);
+
+    record_header hdr{};
+    hdr.length = static_cast<uint32_t>(data.size() - sizeof(record_header));
+    hdr.flag   = flag;
+    std::memcpy(data.data(), &hdr, sizeof hdr);
+
+    std::unique_lock<std::mutex> lock(__mtx);
+    if (!__active) return false;
+
+    if (__active->size > 0 && __active->size + data.size() > __segment_bytes && !roll())
+        return false;
+
+    if (__buffered) {
+        __active->pending += data;
+    } else if (!pwrite_all(__active->fd, data.data(), data.size(), __active->size)) {
+        LOG(ERROR) << "append to [" << __active->path << "] failed: " << std::strerror(errno);
+        return false;
+    }
+
+    msg.set_offset(__active->base + __active->size);
+    msg.set_length(hdr.length);
+    __active->last_ms = now_ms();
+    if (__active->size == 0) __active->first_ms = __active->last_ms;
+    __active->size       += data.size();
+    __active->live_bytes += data.size();
+    return true;
+}
+
+bool segment_log::invalidate(const Message& msg)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    auto seg = locate(msg.offset());
+    if (!seg) return false;
+
+    uint64_t rec_bytes = sizeof(record_header) + msg.length();
+    seg->live_bytes -= std::min(seg->live_bytes, rec_bytes);
+    seg->dead_bytes += rec_bytes;
+
+    uint64_t pos     = msg.offset() - seg->base + offsetof(record_header, flag);
+    uint64_t written = seg->size - seg->pending.size();
+    if (pos >= written) {                            // 记录仍在缓冲中
+        seg->pending[pos - written] = static_cast<char>(RECORD_INVALID);
+        return true;
+    }
+    if (pos >= written - seg->flushing.size()) {     // 正在写出：提交线程读着 flushing，写完后再补
+        seg->flips.push_back(pos);
+        return true;
+    }
+    const char flag = static_cast<char>(RECORD_INVALID);
+    return pwrite_all(seg->fd, &flag, 1, pos);
+}
+
+bool segment_log::read(Message& msg)
+{
+    segment::ptr seg;
+    uint64_t     pos;
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        seg = locate(msg.offset());
+        if (!seg) return false;
+
+        pos = msg.offset() - seg->base + sizeof(record_header);
+        uint64_t buffered = seg->flushing.size() + seg->pending.size();
+        uint64_t written  = seg->size - buffered;
+        if (pos >= written) {                        // 尚未写完，直接从缓冲读
+            uint64_t at = pos - written;
+            if (at + msg.length() <= seg->flushing.size())
+                return parse_payload(msg, seg->flushing.data() + at);
+            at -= std::min<uint64_t>(at, seg->flushing.size());
+            if (at + msg.length() > seg->pending.size()) return false;
+            return parse_payload(msg, seg->pending.data() + at);
+        }
+
+        // 封存段不再追加：整段映射一次，之后的换入直接从页缓存解析，省去 pread 到临时缓冲
+        if (seg != __active && !seg->map && buffered == 0) {
+            void* addr = ::mmap(nullptr, seg->size, PROT_READ, MAP_SHARED, seg->fd, 0);
+            if (addr != MAP_FAILED) {
+                ::madvise(addr, seg->size, MADV_SEQUENTIAL);
+                seg->map     = static_cast<const char*>(addr);
+                seg->map_len = seg->size;
+            }
+        }
+    }
+
+    if (seg->map && pos + msg.length() <= seg->map_len)
+        return parse_payload(msg, seg->map + pos);
+
+    std::string data(msg.length(), '\0');
+    if (!pread_all(seg->fd, data.data(), data.size(), pos))
+        return false;
+    return parse_payload(msg, data.data());
+}
+
+bool segment_log::parse_payload(Message& msg, const char* data)
+{
+    if (!verify_record(data, msg.length())) {
+        LOG(ERROR) << "queue log [" << __dir << "] checksum mismatch at offset " << msg.offset();
+        return false;
+    }
+    return msg.mutable_payload()->ParseFromArray(data, static_cast<int>(msg.length()));
+}
+
+std::vector<message_ptr> segment_log::recover(bool with_body, const log_checkpoint* cp)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    std::vector<message_ptr> result;
+
+    if (cp && !restore_checkpoint(*cp, with_body, result)) {   // 快照与段文件对不上：整体重扫
+        LOG(WARNING) << "queue log [" << __dir << "] checkpoint is stale, scanning all segments";
+        result.clear();
+        for (auto& [_, seg] : __segments) seg->live_bytes = seg->dead_bytes = 0;
+        cp = nullptr;
+    }
+
+    uint64_t tail = cp ? cp->tail : 0;
+    for (auto& [base, seg] : __segments) {
+        if (seg->size == 0 || base + seg->size <= tail) continue;
+        scan_segment(seg, tail > base ? tail - base : 0, with_body, result);
+    }
+    return result;
+}
+
+// 从 from 起顺序扫描一个段：收集有效记录，截掉残缺 / 损坏的尾部
+void segment_log::scan_segment(const segment::ptr& seg, uint64_t from, bool with_body,
+                               std::vector<message_ptr>& result)
+{
+    const uint64_t base = seg->base;
+    void* addr = ::mmap(nullptr, seg->size, PROT_READ, MAP_PRIVATE, seg->fd, 0);
+    if (addr == MAP_FAILED) {
+        LOG(ERROR) << "mmap segment [" << seg->path << "] failed: " << std::strerror(errno);
+        return;
+    }
+    ::madvise(addr, seg->size, MADV_SEQUENTIAL);
+
+    const char* data = static_cast<const char*>(addr);
+    uint64_t pos = from;
+    std::vector<uint64_t> stale;                 // 上次运行留下的非持久记录及中间坏记录
+    std::vector<std::pair<uint64_t, uint64_t>> corrupt;   // 校验失败的记录 [pos, end)
+    while (pos + sizeof(record_header) <= seg->size) {
+        record_header hdr;
+        std::memcpy(&hdr, data + pos, sizeof hdr);
+        uint64_t end = pos + sizeof hdr + hdr.length;
+        if (end > seg->size || hdr.flag > RECORD_TRANSIENT) break;   // 残缺尾记录
+
+        if (hdr.flag != RECORD_INVALID && !verify_record(data + pos + sizeof hdr, hdr.length)) {
+            corrupt.emplace_back(pos, end);
+            pos = end;
+            continue;
+        }
+        // 其后还有完好的记录 ⇒ 之前的坏记录不是残缺尾部，只丢弃这几条
+        for (const auto& [bad, bad_end] : corrupt) {
+            LOG(ERROR) << "segment [" << seg->path << "] record at " << bad
+                       << " failed checksum, dropped";
+            stale.push_back(bad);
+            seg->dead_bytes += bad_end - bad;
+        }
+        corrupt.clear();
+
+        if (hdr.flag == RECORD_VALID) {
+            auto msg = std::make_shared<Message>();
+            if (!msg->mutable_payload()->ParseFromArray(data + pos + sizeof hdr,
+                                                        static_cast<int>(hdr.length)))
+                break;
+            if (!with_body) msg->mutable_payload()->clear_body();
+            msg->set_offset(base + pos);
+            msg->set_length(hdr.length);
+            result.push_back(std::move(msg));
+            seg->live_bytes += end - pos;
+        } else {
+            if (hdr.flag == RECORD_TRANSIENT) stale.push_back(pos);
+            seg->dead_bytes += end - pos;
+        }
+        pos = end;
+    }
+    ::munmap(addr, seg->size);
+    if (!corrupt.empty()) pos = corrupt.front().first;     // 段尾连续坏记录：视为残缺写入截掉
+
+    // 非持久记录与中间的坏记录落盘置无效，压缩时不再搬移
+    const char invalid = static_cast<char>(RECORD_INVALID);
+    for (uint64_t p : stale)
+        pwrite_all(seg->fd, &invalid, 1, p + offsetof(record_header, flag));
+
+    if (pos < seg->size) {
+        LOG(WARNING) << "segment [" << seg->path << "] truncated from "
+                     << seg->size << " to " << pos << " bytes (torn or corrupt tail)";
+        if (fio().ftruncate(seg->fd, static_cast<off_t>(pos)) == 0) seg->size = pos;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// checkpoint
+// 文件格式：| u32 len | u32 crc32c | QueueCheckpoint 序列化字节 |
+// -----------------------------------------------------------------------------
+static constexpr const char* CHECKPOINT_FILE = "/checkpoint";
+
+// 快照中的记录只核对记录头：flag 已被置无效的是快照之后确认的消息；
+// 长度对不上说明快照已过期，返回 false 由调用方整体重扫
+bool segment_log::restore_checkpoint(const log_checkpoint& cp, bool with_body,
+                                     std::vector<message_ptr>& result)
+{
+    segment::ptr seg;
+    const char*  data = nullptr;
+    auto unmap = [&] {
+        if (data) ::munmap(const_cast<char*>(data), seg->size);
+        data = nullptr;
+    };
+
+    std::vector<std::pair<segment::ptr, uint64_t>> bad;   // 校验失败的记录
+    bool ok = true;
+    for (const auto& d : cp.live) {
+        if (d->offset() >= cp.tail) { ok = false; break; }
+        if (!seg || d->offset() < seg->base || d->offset() >= seg->base + seg->size) {
+            unmap();
+            seg = locate(d->offset());
+            if (!seg) continue;                                  // 所在段已被保留策略删除
+            void* addr = ::mmap(nullptr, seg->size, PROT_READ, MAP_PRIVATE, seg->fd, 0);
+            if (addr == MAP_FAILED) { ok = false; break; }
+            ::madvise(addr, seg->size, with_body ? MADV_SEQUENTIAL : MADV_RANDOM);
+            data = static_cast<const char*>(addr);
+        }
+
+        uint64_t pos = d->offset() - seg->base;
+        record_header hdr;
+        if (pos + sizeof hdr > seg->size) { ok = false; break; }
+        std::memcpy(&hdr, data + pos, sizeof hdr);
+        if (hdr.length != d->length() || pos + sizeof hdr + hdr.length > seg->size ||
+            hdr.flag > RECORD_TRANSIENT) {
+            ok = false;
+            break;
+        }
+        if (hdr.flag == RECORD_INVALID) continue;
+
+        auto msg = std::make_shared<Message>();
+        if (with_body) {
+            const char* payload = data + pos + sizeof hdr;
+            if (!verify_record(payload, hdr.length) ||
+                !msg->mutable_payload()->ParseFromArray(payload, static_cast<int>(hdr.length))) {
+                LOG(ERROR) << "segment [" << seg->path << "] record at " << pos
+                           << " failed checksum, dropped";
+                bad.emplace_back(seg, pos);
+                continue;
+            }
+        } else {
+            *msg->mutable_payload()->mutable_properties() = d->payload().properties();
+        }
+        msg->set_offset(d->offset());
+        msg->set_length(hdr.length);
+        result.push_back(std::move(msg));
+        seg->live_bytes += sizeof hdr + hdr.length;
+    }
+    unmap();
+    if (!ok) return false;
+
+    const char invalid = static_cast<char>(RECORD_INVALID);
+    for (const auto& [s, pos] : bad)
+        pwrite_all(s->fd, &invalid, 1, pos + offsetof(record_header, flag));
+
+    // tail 之前除快照中仍有效的记录外都是无效字节
+    for (auto& [base, s] : __segments) {
+        if (base >= cp.tail) break;
+        uint64_t covered = std::min(s->size, cp.tail - base);
+        s->dead_bytes = covered - std::min(covered, s->live_bytes);
+    }
+    static metric& m_restored = metrics::instance().get("checkpoint.restored_records");
+    m_restored.observe(result.size());
+    LOG(INFO) << "queue log [" << __dir << "] restored " << result.size()
+              << " records from checkpoint, scanning from offset " << cp.tail;
+    return true;
+}
+
+log_checkpoint segment_log::begin_checkpoint()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    log_checkpoint cp;
+    cp.generation = __generation;
+    if (!__active) return cp;
+
+    if (!__buffered) {                               // 直写模式：先把当前段刷盘
+        fio().fdatasync(__active->fd);
+        cp.tail = __active->base + __active->size;
+        return cp;
+    }
+    // 第一个还有未写出缓冲的段决定上界（prepare_commit 之后、finish 之前的数据也不算）
+    cp.tail = __active->base + __active->size;
+    for (const auto& [base, seg] : __segments) {
+        uint64_t buffered = seg->pending.size() + seg->flushing.size();
+        if (buffered) {
+            cp.tail = base + seg->size - buffered;
+            break;
+        }
+    }
+    return cp;
+}
+
+bool segment_log::save_checkpoint(const log_checkpoint& cp)
+{
+    static metric& m_write = metrics::instance().get("checkpoint.write_us");
+    auto t0 = std::chrono::steady_clock::now();
+
+    QueueCheckpoint pb;
+    pb.set_tail(cp.tail);
+    pb.mutable_messages()->Reserve(static_cast<int>(cp.live.size()));
+    for (const auto& m : cp.live) *pb.add_messages() = *m;
+
+    std::string data(8, '\0');
+    if (!pb.AppendToString(&data)) return false;
+    uint32_t len = static_cast<uint32_t>(data.size() - 8);
+    uint32_t crc = crc32c(data.data() + 8, len);
+    std::memcpy(data.data(), &len, 4);
+    std::memcpy(data.data() + 4, &crc, 4);
+
+    std::string path = __dir + CHECKPOINT_FILE;
+    std::string tmp  = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool ok = pwrite_all(fd, data.data(), data.size(), 0) && fio().fdatasync(fd) == 0;
+    ::close(fd);
+
+    // 落盘期间若有段被压缩重写，offset 已变，丢弃这份快照
+    std::unique_lock<std::mutex> lock(__mtx);
+    if (!ok || cp.generation != __generation || !__active ||
+        fio().rename(tmp.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp.c_str());
+        return false;
+    }
+    m_write.observe(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - t0).count()));
+    return true;
+}
+
+bool segment_log::load_checkpoint(log_checkpoint& cp)
+{
+    std::string path = __dir + CHECKPOINT_FILE;
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st {};
+    std::string data;
+    bool ok = ::fstat(fd, &st) == 0 && st.st_size >= 8;
+    if (ok) {
+        data.resize(static_cast<size_t>(st.st_size));
+        ok = pread_all(fd, data.data(), data.size(), 0);
+    }
+    ::close(fd);
+
+    uint32_t len = 0, crc = 0;
+    if (ok) {
+        std::memcpy(&len, data.data(), 4);
+        std::memcpy(&crc, data.data() + 4, 4);
+        ok = len == data.size() - 8 && crc == crc32c(data.data() + 8, len);
+    }
+    QueueCheckpoint pb;
+    if (!ok || !pb.ParseFromArray(data.data() + 8, static_cast<int>(len))) {
+        LOG(WARNING) << "checkpoint [" << path << "] is corrupt, ignored";
+        return false;
+    }
+
+    cp.tail = pb.tail();
+    cp.live.clear();
+    cp.live.reserve(static_cast<size_t>(pb.messages_size()));
+    for (auto& m : *pb.mutable_messages())
+        cp.live.push_back(std::make_shared<Message>(std::move(m)));
+    return true;
+}
+
+uint64_t segment_log::prepare_commit(io_batch& batch)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    if (!__active || !__flushing.empty()) return 0;
+
+    // 已滚动的段（只剩缓冲待写）+ 当前段：缓冲整体移入 flushing，追加继续写新缓冲
+    auto to_write = std::move(__unsynced);
+    __unsynced.clear();
+    if (!__active->pending.empty()) to_write.push_back(__active);
+
+    uint64_t bytes = 0;
+    for (const auto& seg : to_write) {
+        seg->flushing.swap(seg->pending);
+        uint64_t pos = seg->size - seg->flushing.size();
+        if (!seg->flushing.empty())
+            batch.writes.push_back({seg->fd, pos, seg->flushing.data(), seg->flushing.size()});
+        batch.syncs.push_back(seg->fd);
+        bytes += seg->flushing.size();
+    }
+    __flushing = std::move(to_write);
+    return bytes;
+}
+
+void segment_log::finish_commit(bool ok)
+{
+    std::vector<uint64_t> lost;
+    lost_callback         on_lost;
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        const char invalid = static_cast<char>(RECORD_INVALID);
+        std::vector<segment::ptr> retry;
+        for (const auto& seg : __flushing) {
+            if (ok) {
+                seg->flushing.clear();
+                for (uint64_t pos : seg->flips) pwrite_all(seg->fd, &invalid, 1, pos);
+                seg->flips.clear();
+                continue;
+            }
+
+            // 写出期间已确认的先在缓冲里置无效（字节计数 invalidate 时已调整），其余持久化记录算丢失
+            uint64_t start = seg->size - seg->pending.size() - seg->flushing.size();
+            for (uint64_t pos : seg->flips) seg->flushing[pos - start] = invalid;
+            seg->flips.clear();
+            for (size_t at = 0; at + sizeof(record_header) <= seg->flushing.size(); ) {
+                record_header hdr;
+                std::memcpy(&hdr, seg->flushing.data() + at, sizeof hdr);
+                uint64_t rec = sizeof hdr + hdr.length;
+                if (hdr.flag == RECORD_VALID) {
+                    seg->flushing[at + offsetof(record_header, flag)] = invalid;
+                    seg->live_bytes -= std::min(seg->live_bytes, rec);
+                    seg->dead_bytes += rec;
+                    lost.push_back(seg->base + start + at);
+                }
+                at += rec;
+            }
+            seg->pending.insert(0, seg->flushing);
+            seg->flushing.clear();
+            if (seg != __active) retry.push_back(seg);     // 已封存的段：重新登记，下一批一并写出
+        }
+        __unsynced.insert(__unsynced.begin(), retry.begin(), retry.end());
+        __flushing.clear();
+        on_lost = __on_lost;
+    }
+    if (!lost.empty() && on_lost) on_lost(lost);
+}
+
+void segment_log::set_lost_callback(const lost_callback& cb)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    __on_lost = cb;
+}
+
+uint64_t segment_log::commit()
+{
+    static storage_io::ptr s_io = storage_io::create(false);
+
+    io_batch batch;
+    uint64_t bytes = prepare_commit(batch);
+    bool ok = batch.empty() || s_io->submit(batch);
+    if (!ok) LOG(ERROR) << "commit queue log [" << __dir << "] failed";
+    finish_commit(ok);
+    return bytes;
+}
+
+// -----------------------------------------------------------------------------
+// compaction
+// -----------------------------------------------------------------------------
+std::vector<uint64_t> segment_log::compaction_candidates(double ratio)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    std::vector<uint64_t> result;
+    for (const auto& [base, seg] : __segments) {
+        if (seg == __active || seg->size == 0) continue;
+        if (!seg->pending.empty() || !seg->flushing.empty()) continue;   // 尚未写完
+        if (seg->live_bytes == 0 ||
+            static_cast<double>(seg->dead_bytes) >= ratio * static_cast<double>(seg->size))
+            result.push_back(base);
+    }
+    return result;
+}
+
+bool segment_log::rewrite(uint64_t base, segment_rewrite& out,
+                          const std::function<void(uint64_t)>& throttle)
+{
+    static constexpr size_t WRITE_CHUNK = 1 << 20;
+
+    segment::ptr seg;
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        auto it = __segments.find(base);
+        if (it == __segments.end() || it->second == __active) return false;
+        seg = it->second;
+
+        out.base = base;
+        if (seg->live_bytes == 0) {                  // 全部已确认：整段删除
+            ::unlink(seg->path.c_str());
+            out.removed   = true;
+            out.reclaimed = seg->size;
+            __segments.erase(it);
+            return true;
+        }
+    }
+
+    // 封存段只会被翻转 flag，可不持锁顺序读取
+    void* addr = ::mmap(nullptr, seg->size, PROT_READ, MAP_SHARED, seg->fd, 0);
+    if (addr == MAP_FAILED) return false;
+    ::madvise(addr, seg->size, MADV_SEQUENTIAL);
+
+    out.tmp_path = seg->path + ".compact";
+    int fd = ::open(out.tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        ::munmap(addr, seg->size);
+        return false;
+    }
+
+    const char* data    = static_cast<const char*>(addr);
+    uint64_t    pos     = 0;
+    uint64_t    written = 0;
+    bool        ok      = true;
+    std::string buf;
+
+    auto flush = [&] {
+        if (buf.empty()) return;
+        if (throttle) throttle(buf.size());
+        ok = ok && pwrite_all(fd, buf.data(), buf.size(), written);
+        written += buf.size();
+        buf.clear();
+    };
+
+    while (ok && pos + sizeof(record_header) <= seg->size) {
+        record_header hdr;
+        std::memcpy(&hdr, data + pos, sizeof hdr);
+        uint64_t end = pos + sizeof hdr + hdr.length;
+        if (end > seg->size) break;
+
+        if (hdr.flag == RECORD_VALID || hdr.flag == RECORD_TRANSIENT) {
+            out.moved.push_back({base + pos, base + written + buf.size(), hdr.length});
+            buf.append(data + pos, end - pos);
+            if (buf.size() >= WRITE_CHUNK) flush();
+        }
+        pos = end;
+    }
+    flush();
+    ::munmap(addr, seg->size);
+
+    ok = ok && fio().fdatasync(fd) == 0;
+    ::close(fd);
+    if (!ok) {
+        ::unlink(out.tmp_path.c_str());
+        return false;
+    }
+
+    out.size      = written;
+    out.reclaimed = seg->size - written;
+    return true;
+}
+
+bool segment_log::install(const segment_rewrite& rw)
+{
+    if (rw.removed) return true;
+
+    std::unique_lock<std::mutex> lock(__mtx);
+    auto it = __segments.find(rw.base);
+    if (it == __segments.end()) {
+        ::unlink(rw.tmp_path.c_str());
+        return false;
+    }
+
+    // 改名前先打开新文件（fd 跟随 inode 过去）：打不开或改名失败时旧段原样保留，内存与磁盘不会错开
+    int fd = ::open(rw.tmp_path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0 || fio().rename(rw.tmp_path.c_str(), it->second->path.c_str()) != 0) {
+        if (fd >= 0) ::close(fd);
+        ::unlink(rw.tmp_path.c_str());
+        return false;
+    }
+
+    // 换成新的 segment 对象：仍持有旧对象的读者继续用旧 fd，读完自然释放
+    auto seg        = std::make_shared<segment>();
+    seg->base       = rw.base;
+    seg->path       = it->second->path;
+    seg->fd         = fd;
+    seg->size       = rw.size;
+    seg->live_bytes = rw.size;
+
+    it->second = std::move(seg);
+
+    // 记录 offset 已变：旧检查点作废，进行中的检查点在 save 时丢弃
+    ++__generation;
+    ::unlink((__dir + CHECKPOINT_FILE).c_str());
+    return true;
+}
+
+void segment_log::destroy()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    __active.reset();
+    __segments.clear();
+    __unsynced.clear();
+
+    std::error_code ec;
+    fs::remove_all(__dir, ec);
+}
+
+// -----------------------------------------------------------------------------
+// retention
+// -----------------------------------------------------------------------------
+uint64_t segment_log::retain(uint64_t max_bytes, int64_t cutoff_ms, uint64_t hold)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    if (!__active) return 0;
+
+    // 慢队列的当前段可能很久写不满：首条已过期就封存，等整段过期后删除
+    if (cutoff_ms > 0 && __active->size > 0 && __active->first_ms < cutoff_ms) roll();
+
+    uint64_t total = 0;
+    for (const auto& [_, seg] : __segments) total += seg->size;
+
+    uint64_t floor = 0;
+    for (auto it = __segments.begin(); it != __segments.end(); ) {
+        const auto& seg = it->second;
+        if (seg == __active || !seg->pending.empty() || !seg->flushing.empty()) break;
+        if (seg->base + seg->size > hold) break;
+        bool over_size = max_bytes > 0 && total > max_bytes;
+        bool expired   = cutoff_ms > 0 && seg->last_ms < cutoff_ms;
+        if (!over_size && !expired) break;
+
+        // 正在换入的读者各自持有 segment::ptr，fd 与映射在它们读完后才释放，删路径不影响
+        ::unlink(seg->path.c_str());
+        total -= seg->size;
+        floor  = seg->base + seg->size;
+        it     = __segments.erase(it);
+    }
+    return floor;
+}
+
+uint64_t segment_log::segment_count()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    return __segments.size();
+}
+
+uint64_t segment_log::total_bytes()
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    uint64_t total = 0;
+    for (const auto& [_, seg] : __segments) total += seg->size;
+    return total;
+}
+
+}
@@ -0,0 +1,170 @@
+// ======================= segment_log.hpp =======================
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../common/msg.pb.h"      // Message / MessagePayload
+#include "../common/message.hpp"   // message_ptr
+#include "storage_io.hpp"          // io_batch
+
+namespace hz_mq {
+
+// ---------------------------------------------------------------------------
+// 磁盘记录格式（每条消息一条记录，顺序追加）：
+//
+//   | record_header (8B) | MessagePayload 序列化字节 (length B) |
+//
+// MessagePayload.valid 存其余字段的 CRC32C，恢复与换入时校验；
+// 段尾校验失败的记录视为残缺写入并截断。
+// Message.offset 为记录头在整个队列日志中的“逻辑偏移”，
+// Message.length 为 payload 长度。确认后仅把 flag 置为 RECORD_INVALID（懒删除）。
+// RECORD_TRANSIENT：lazy 队列换出到磁盘的非持久消息，运行期视为有效，重启后丢弃。
+// ---------------------------------------------------------------------------
+struct record_header {
+    uint32_t length;        // payload 字节数
+    uint8_t  flag;          // RECORD_VALID / RECORD_INVALID / RECORD_TRANSIENT
+    uint8_t  reserved[3];
+};
+static_assert(sizeof(record_header) == 8, "record_header must be 8 bytes");
+
+inline constexpr uint8_t RECORD_INVALID   = 0;
+inline constexpr uint8_t RECORD_VALID     = 1;
+inline constexpr uint8_t RECORD_TRANSIENT = 2;
+
+// ---------- 单个段文件：<dir>/<起始逻辑偏移, 20 位>.mqd ----------
+struct segment {
+    using ptr = std::shared_ptr<segment>;
+
+    uint64_t    base{0};    // 段首字节对应的逻辑偏移
+    uint64_t    size{0};    // 已追加字节数（含尚在 pending 中的部分）
+    int         fd{-1};
+    std::string path;
+    std::string pending;    // 缓冲模式下尚未提交的尾部数据
+    std::string flushing;   // 正由提交线程写出的数据，紧接在 pending 之前
+    std::vector<uint64_t> flips;   // 写出期间被确认的记录：写完后再补写 flag
+    uint64_t    live_bytes{0};  // 有效记录字节（含记录头）
+    uint64_t    dead_bytes{0};  // 已置无效记录字节，压缩时回收
+    const char* map{nullptr};   // 封存段的只读映射（首次 read 时建立），换入时直接从页缓存解析
+    uint64_t    map_len{0};
+    int64_t     first_ms{0};    // 段内首条 / 最后一条记录的写入时间（墙钟毫秒）；
+    int64_t     last_ms{0};     // 启动时打开的已有段取文件 mtime
+
+    ~segment();
+};
+
+// ---------- 一次段压缩的结果：有效记录已拷入临时文件，等待 install ----------
+struct moved_record {
+    uint64_t from;          // 旧逻辑偏移
+    uint64_t to;            // 新逻辑偏移
+    uint32_t length;        // payload 长度
+};
+
+struct segment_rewrite {
+    uint64_t                  base{0};
+    std::string               tmp_path;
+    uint64_t                  size{0};        // 新文件长度
+    uint64_t                  reclaimed{0};   // 回收的字节数
+    bool                      removed{false}; // 段内已无有效记录，直接删除
+    std::vector<moved_record> moved;          // 被搬移的有效记录
+};
+
+// ---------- 检查点：<dir>/checkpoint ----------
+// tail 之前仍有效的持久化记录（只含属性与 offset / length）。恢复时这部分只核对记录头，
+// tail 之后照常顺序扫描，重启耗时取决于检查点间隔而不是积压总量
+struct log_checkpoint {
+    uint64_t                 tail{0};         // 逻辑偏移：之前的数据都已落盘
+    uint64_t                 generation{0};   // 段被压缩重写后旧快照作废
+    std::vector<message_ptr> live;            // 按 offset 递增
+};
+
+// ===========================================================================
+// segment_log : 单个队列的分段追加日志
+// ===========================================================================
+class segment_log {
+public:
+    using ptr           = std::shared_ptr<segment_log>;
+    using lost_callback = std::function<void(const std::vector<uint64_t>& offsets)>;
+
+    static constexpr uint64_t DEFAULT_SEGMENT_BYTES = 64ull << 20;   // 64 MiB
+
+    // buffered = true 时 append 只写入内存缓冲，由 group_commit 线程经 storage_io
+    // 统一 write + fdatasync（调用方线程不碰磁盘）；否则每次 append 直接 pwrite
+    explicit segment_log(const std::string& dir,
+                         uint64_t segment_bytes = DEFAULT_SEGMENT_BYTES,
+                         bool buffered = false);
+
+    bool open();                                 // 建目录并打开已有段
+    // 追加并回填 offset / length；body 非空时消息体不在 msg 中（须为空），由 body 直接写入
+    bool append(Message& msg, uint8_t flag = RECORD_VALID, const std::string* body = nullptr);
+    bool invalidate(const Message& msg);         // 置无效标志（懒删除）
+    bool read(Message& msg);                     // 按 offset / length 读回 payload
+    // 顺序扫描所有段，返回有效消息；with_body = false 时只保留属性（lazy 队列按需换入）。
+    // 给定检查点时 tail 之前的部分以快照为准，快照过期则退回全量扫描
+    std::vector<message_ptr> recover(bool with_body = true, const log_checkpoint* cp = nullptr);
+    void destroy();                              // 删除全部段文件及目录
+    uint64_t commit();                           // 用 pwrite 同步写出缓冲并 fdatasync，返回写出字节数
+
+    // ---------- 批提交（group_commit 线程）：prepare → storage_io::submit → finish ----------
+    // 把缓冲移入 flushing 并登记写入 / fdatasync；上一批未 finish 时不登记
+    uint64_t prepare_commit(io_batch& batch);
+    // ok = true：释放 flushing，补写期间的确认 flag。
+    // ok = false（写入或 fdatasync 失败）：盘上这段内容未知。flushing 放回 pending 最前面，
+    // 下一批连同其后的新追加原位重写，段内不留空洞；其中的持久化记录置无效（发布方已收到失败，
+    // 会重发），逻辑偏移经 lost 回调交给队列从内存中摘除
+    void     finish_commit(bool ok = true);
+    void     set_lost_callback(const lost_callback& cb);
+
+    // ---------- 压缩：只处理已封存段 ----------
+    // 无效字节占比 >= ratio 的封存段起始偏移
+    std::vector<uint64_t> compaction_candidates(double ratio);
+    // 把段内有效记录拷贝到临时文件（不持锁，throttle 在每次写出前调用以限速）；
+    // 段内已无有效记录时直接删除段文件
+    bool rewrite(uint64_t base, segment_rewrite& out,
+                 const std::function<void(uint64_t)>& throttle);
+    // 用临时文件替换原段；调用方负责据 out.moved 更新内存中消息的 offset
+    bool install(const segment_rewrite& rw);
+
+    // ---------- 保留策略：整段删除，不逐条过期 ----------
+    // 从最旧的封存段起删除：总字节数超过 max_bytes（0 不限）或最后写入早于 cutoff_ms（0 不限）。
+    // 当前段首条记录已早于 cutoff_ms 时先封存，下一轮即可整段删除。
+    // hold 所在的段及其后各段一律保留（调用方用它护住已投递未确认的记录）。
+    // 返回删除后最小的逻辑偏移：小于它的记录都已不在磁盘上（未删除任何段时返回 0）
+    uint64_t retain(uint64_t max_bytes, int64_t cutoff_ms, uint64_t hold = UINT64_MAX);
+
+    // ---------- 检查点 ----------
+    log_checkpoint begin_checkpoint();           // 填好 tail 与 generation，调用方再填 live
+    bool save_checkpoint(const log_checkpoint& cp);   // 写临时文件后 rename；期间段被重写则放弃
+    bool load_checkpoint(log_checkpoint& cp);
+
+    uint64_t segment_count();
+    uint64_t total_bytes();
+
+private:
+    segment::ptr open_segment(uint64_t base, bool create);
+    segment::ptr locate(uint64_t offset);        // 需持有 __mtx
+    bool roll();                                 // 需持有 __mtx
+    bool parse_payload(Message& msg, const char* data);   // 校验后解析
+    void scan_segment(const segment::ptr& seg, uint64_t from, bool with_body,
+                      std::vector<message_ptr>& result);     // 需持有 __mtx
+    bool restore_checkpoint(const log_checkpoint& cp, bool with_body,
+                            std::vector<message_ptr>& result);   // 需持有 __mtx
+
+    std::string                        __dir;
+    uint64_t                           __segment_bytes;
+    bool                               __buffered;
+    std::mutex                         __mtx;
+    std::map<uint64_t, segment::ptr>   __segments;   // base -> segment
+    segment::ptr                       __active;     // 当前写入段（最后一个）
+    std::vector<segment::ptr>          __unsynced;   // 已滚动封存、缓冲待提交的段
+    std::vector<segment::ptr>          __flushing;   // prepare_commit 登记、尚未 finish 的段
+    lost_callback                      __on_lost;     // 提交失败丢弃的持久化记录
+    uint64_t                           __generation{0};   // install() 一次加一
+};
+
+}
@@ -0,0 +1,341 @@
+// ======================= storage_io.cpp =======================
+#include "storage_io.hpp"
+#include "../common/logger.hpp"
+#include "../common/file_io.hpp"
+#include "../common/metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define HZ_MQ_HAVE_IO_URING 1
+#endif
+
+namespace hz_mq {
+
+uint64_t io_batch::bytes() const
+{
+    uint64_t total = 0;
+    for (const auto& w : writes) total += w.len;
+    return total;
+}
+
+// -----------------------------------------------------------------------------
+// helpers
+// -----------------------------------------------------------------------------
+static bool pwrite_all(int fd, const char* data, size_t len, uint64_t pos)
+{
+    while (len > 0) {
+        ssize_t n = fio().pwrite(fd, data, len, static_cast<off_t>(pos));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        pos  += static_cast<uint64_t>(n);
+        len  -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// pwrite 后端
+// -----------------------------------------------------------------------------
+class pwrite_io : public storage_io {
+public:
+    bool submit(const io_batch& batch) override
+    {
+        bool ok = true;
+        for (const auto& w : batch.writes) {
+            if (!pwrite_all(w.fd, w.data, w.len, w.pos)) {
+                LOG(ERROR) << "pwrite fd " << w.fd << " failed: " << std::strerror(errno);
+                ok = false;
+            }
+        }
+        for (int fd : batch.syncs) {
+            if (fio().fdatasync(fd) != 0) {
+                LOG(ERROR) << "fdatasync fd " << fd << " failed: " << std::strerror(errno);
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    const char* name() const override { return "pwrite"; }
+};
+
+#ifdef HZ_MQ_HAVE_IO_URING
+// -----------------------------------------------------------------------------
+// io_uring 后端（直接走系统调用，不依赖 liburing）
+// -----------------------------------------------------------------------------
+class uring_io : public storage_io {
+public:
+    static constexpr unsigned RING_ENTRIES = 64;
+    static constexpr size_t   MAX_OP_BYTES = 1u << 30;    // 单个 sqe 的 len 是 u32，大写入拆开
+
+    ~uring_io() override
+    {
+        if (__sq_ring && __sq_ring != MAP_FAILED) ::munmap(__sq_ring, __sq_ring_len);
+        if (__cq_ring && __cq_ring != __sq_ring && __cq_ring != MAP_FAILED)
+            ::munmap(__cq_ring, __cq_ring_len);
+        if (__sqes && __sqes != MAP_FAILED) ::munmap(__sqes, __sqes_len);
+        if (__fd >= 0) ::close(__fd);
+    }
+
+    bool init();
+    bool submit(const io_batch& batch) override;
+    const char* name() const override { return "io_uring"; }
+
+private:
+    // 本轮中的一个操作；user_data = 下标
+    struct op {
+        int         fd;
+        uint64_t    pos;
+        const char* data;   // 直接指向调用方的缓冲（segment 的 flushing 区），submit 返回前有效
+        uint32_t    len;    // 0 表示 fsync
+    };
+
+    void          prep(const op& o, unsigned idx, bool link);
+    void          prep_sqe(io_uring_sqe* sqe, const op& o, unsigned idx, bool link);
+    bool          run_round(std::vector<op>& ops, std::vector<uint8_t>& links);
+
+    int       __fd{-1};
+    bool      __broken{false};
+    pwrite_io __fallback;
+
+    void*     __sq_ring{nullptr};
+    size_t    __sq_ring_len{0};
+    void*     __cq_ring{nullptr};
+    size_t    __cq_ring_len{0};
+    void*     __sqes{nullptr};
+    size_t    __sqes_len{0};
+
+    unsigned*      __sq_tail{nullptr};
+    unsigned*      __sq_mask{nullptr};
+    unsigned*      __sq_array{nullptr};
+    unsigned*      __cq_head{nullptr};
+    unsigned*      __cq_tail{nullptr};
+    unsigned*      __cq_mask{nullptr};
+    io_uring_cqe*  __cqes{nullptr};
+};
+
+static int sys_io_uring_setup(unsigned entries, io_uring_params* p)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int sys_io_uring_enter(int fd, unsigned submit, unsigned min_complete, unsigned flags)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, submit, min_complete, flags,
+                                      nullptr, 0));
+}
+
+bool uring_io::init()
+{
+    io_uring_params p;
+    std::memset(&p, 0, sizeof p);
+    __fd = sys_io_uring_setup(RING_ENTRIES, &p);
+    if (__fd < 0) {
+        LOG(WARNING) << "io_uring_setup failed: " << std::strerror(errno);
+        return false;
+    }
+
+    __sq_ring_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    __cq_ring_len = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single   = p.features & IORING_FEAT_SINGLE_MMAP;
+    if (single) __sq_ring_len = __cq_ring_len = std::max(__sq_ring_len, __cq_ring_len);
+
+    __sq_ring = ::mmap(nullptr, __sq_ring_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       __fd, IORING_OFF_SQ_RING);
+    if (__sq_ring == MAP_FAILED) return false;
+    __cq_ring = single ? __sq_ring
+                       : ::mmap(nullptr, __cq_ring_len, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, __fd, IORING_OFF_CQ_RING);
+    if (__cq_ring == MAP_FAILED) return false;
+    __sqes_len = p.sq_entries * sizeof(io_uring_sqe);
+    __sqes = ::mmap(nullptr, __sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    __fd, IORING_OFF_SQES);
+    if (__sqes == MAP_FAILED) return false;
+
+    auto sq = static_cast<char*>(__sq_ring);
+    auto cq = static_cast<char*>(__cq_ring);
+    __sq_tail  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    __sq_mask  = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    __sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    __cq_head  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    __cq_tail  = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    __cq_mask  = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    __cqes     = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+    return true;
+}
+
+void uring_io::prep(const op& o, unsigned idx, bool link)
+{
+    unsigned tail = *__sq_tail;
+    unsigned slot = tail & *__sq_mask;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(__sqes) + slot;
+    prep_sqe(sqe, o, idx, link);
+    __sq_array[slot] = slot;
+    __atomic_store_n(__sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+void uring_io::prep_sqe(io_uring_sqe* sqe, const op& o, unsigned idx, bool link)
+{
+    std::memset(sqe, 0, sizeof *sqe);
+    sqe->fd        = o.fd;
+    sqe->user_data = idx;
+    if (link) sqe->flags |= IOSQE_IO_LINK;
+
+    if (o.len == 0) {
+        sqe->opcode      = IORING_OP_FSYNC;
+        sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+        return;
+    }
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->off    = o.pos;
+    sqe->addr   = reinterpret_cast<uint64_t>(o.data);
+    sqe->len    = o.len;
+}
+
+// 提交一轮并等待全部完成。链中某步失败（含短写）时内核取消其后各步，
+// 这里按提交顺序同步重做未完整完成的操作（写同一位置同一内容，幂等）
+bool uring_io::run_round(std::vector<op>& ops, std::vector<uint8_t>& links)
+{
+    if (ops.empty()) return true;
+    for (unsigned i = 0; i < ops.size(); ++i) prep(ops[i], i, links[i]);
+
+    std::vector<int> res(ops.size(), -ECANCELED);
+    unsigned to_submit = static_cast<unsigned>(ops.size());
+    unsigned reaped    = 0;
+    auto reap = [&] {
+        unsigned head = *__cq_head;
+        unsigned tail = __atomic_load_n(__cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head, ++reaped) {
+            const io_uring_cqe& cqe = __cqes[head & *__cq_mask];
+            if (cqe.user_data < res.size()) res[cqe.user_data] = cqe.res;
+        }
+        __atomic_store_n(__cq_head, head, __ATOMIC_RELEASE);
+    };
+    while (reaped < ops.size()) {
+        int n = sys_io_uring_enter(__fd, to_submit, 1, IORING_ENTER_GETEVENTS);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // 之后改走 pwrite。已提交的请求还在读 flushing 缓冲：必须全部收割后才能返回
+            // （返回后缓冲即被释放），它们的结果也决定下面要重做哪些，避免同一位置写两遍且乱序。
+            // 未被内核取走的 sqe 留在环里，不再 enter 就不会执行
+            LOG(ERROR) << "io_uring_enter failed, switching to pwrite: " << std::strerror(errno);
+            __broken = true;
+            unsigned inflight = static_cast<unsigned>(ops.size()) - to_submit;
+            bool     logged   = false;
+            while (reap(), reaped < inflight) {
+                if (sys_io_uring_enter(__fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                    if (!logged) LOG(ERROR) << "io_uring wait failed, retrying: " << std::strerror(errno);
+                    logged = true;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            break;
+        }
+        to_submit -= std::min<unsigned>(to_submit, static_cast<unsigned>(n));
+        reap();
+    }
+
+    static metric& m_redo = metrics::instance().get("storage_io.redo_ops");
+    bool ok = true;
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const op& o = ops[i];
+        if (o.len == 0 ? res[i] == 0 : res[i] == static_cast<int>(o.len)) continue;
+
+        m_redo.observe(1);
+        bool redo = o.len == 0 ? fio().fdatasync(o.fd) == 0
+                               : pwrite_all(o.fd, o.data, o.len, o.pos);
+        if (!redo) {
+            LOG(ERROR) << "io_uring " << (o.len ? "write" : "fsync") << " on fd " << o.fd
+                       << " failed: " << std::strerror(res[i] < 0 ? -res[i] : errno);
+            ok = false;
+        }
+    }
+    ops.clear();
+    links.clear();
+    return ok;
+}
+
+bool uring_io::submit(const io_batch& batch)
+{
+    if (__broken) return __fallback.submit(batch);
+
+    // 按 fd 分组：每个文件一条 “写 ... 写 → fsync” 链
+    struct chain {
+        int                         fd;
+        std::vector<const io_write*> writes;
+        bool                        sync{false};
+    };
+    std::vector<chain> chains;
+    auto chain_of = [&](int fd) -> chain& {
+        for (auto& c : chains) if (c.fd == fd) return c;
+        chains.push_back({fd, {}, false});
+        return chains.back();
+    };
+    for (const auto& w : batch.writes) if (w.len) chain_of(w.fd).writes.push_back(&w);
+    for (int fd : batch.syncs) chain_of(fd).sync = true;
+
+    std::vector<op>      ops;
+    std::vector<uint8_t> links;
+    bool     ok   = true;
+    auto     flush_round = [&] {
+        if (!links.empty()) links.back() = 0;          // 本轮末尾断链，未写完的部分下一轮接着写
+        ok = run_round(ops, links) && ok;
+    };
+
+    // 写入直接引用调用方的缓冲（io_write::data 在 submit 返回前有效）
+    for (const auto& c : chains) {
+        for (const io_write* w : c.writes) {
+            for (size_t done = 0; done < w->len; ) {
+                if (ops.size() + 2 > RING_ENTRIES) flush_round();
+                uint32_t len = static_cast<uint32_t>(std::min(MAX_OP_BYTES, w->len - done));
+                ops.push_back({c.fd, w->pos + done, w->data + done, len});
+                links.push_back(1);
+                done += len;
+            }
+        }
+        if (c.sync) {
+            if (ops.size() + 1 > RING_ENTRIES) flush_round();
+            ops.push_back({c.fd, 0, nullptr, 0});
+            links.push_back(0);
+        } else if (!links.empty()) {
+            links.back() = 0;
+        }
+    }
+    flush_round();
+    return ok;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+storage_io::ptr storage_io::create(bool prefer_uring)
+{
+#ifdef HZ_MQ_HAVE_IO_URING
+    if (prefer_uring && !file_io_intercepted()) {         // io_uring 绕过 file_io，测试注入时不用
+        auto io = std::make_shared<uring_io>();
+        if (io->init()) {
+            LOG(INFO) << "storage io backend: " << io->name();
+            return io;
+        }
+        LOG(WARNING) << "io_uring unavailable, falling back to pwrite";
+    }
+#endif
+    return std::make_shared<pwrite_io>();
+}
+
+}
@@ -0,0 +1,51 @@
+// ======================= storage_io.hpp =======================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hz_mq {
+
+// ---------- 一次批提交要做的磁盘操作 ----------
+struct io_write {
+    int         fd;
+    uint64_t    pos;
+    const char* data;       // 调用方保证 submit 返回前有效
+    size_t      len;
+};
+
+struct io_batch {
+    std::vector<io_write> writes;   // 同一 fd 的写按文件顺序排列
+    std::vector<int>      syncs;    // 对应 fd 的写全部完成后 fdatasync
+
+    bool     empty() const { return writes.empty() && syncs.empty(); }
+    uint64_t bytes() const;
+};
+
+// ===========================================================================
+// storage_io : 持久化写入后端，只在 group_commit 提交线程里调用，
+//              muduo IO 线程不会碰到磁盘写与 fdatasync
+//
+//   · io_uring：同步的批量提交器。写入直接引用调用方缓冲（IORING_OP_WRITE，不拷贝、
+//               不注册缓冲），每个文件 “write → ... → fsync” 组成一条 IOSQE_IO_LINK 链，
+//               多个文件的链并发执行；一次 io_uring_enter 提交并阻塞等待全部完成，
+//               完成事件不回到事件循环。收益只来自多个文件的写与 fdatasync 并发
+//   · pwrite  ：内核不支持 / 被禁用时的退路，逐个 pwrite + fdatasync
+// ===========================================================================
+class storage_io {
+public:
+    using ptr = std::shared_ptr<storage_io>;
+
+    virtual ~storage_io() = default;
+
+    // 执行整批操作，全部完成后返回；任何一步失败返回 false
+    virtual bool submit(const io_batch& batch) = 0;
+    virtual const char* name() const = 0;
+
+    // prefer_uring = true 时优先 io_uring，初始化失败自动退回 pwrite
+    static ptr create(bool prefer_uring);
+};
+
+}
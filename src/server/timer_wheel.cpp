@@ -0,0 +1,165 @@
+// ======================= timer_wheel.cpp =======================
+#include "timer_wheel.hpp"
+
+#include <utility>
+
+namespace hz_mq {
+
+timer_wheel::timer_wheel(const options& opts, int64_t now_ms)
+    : __opts(opts)
+{
+    if (__opts.tick.count() <= 0) __opts.tick = std::chrono::milliseconds(1);
+    __tick = now_ms > 0 ? static_cast<uint64_t>(now_ms) / __opts.tick.count() : 0;
+}
+
+int64_t timer_wheel::now()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// 句柄：高 32 位代号，低 32 位节点下标 + 1
+timer_wheel::handle timer_wheel::schedule(const std::weak_ptr<queue_message>& queue, msg_pos pos,
+                                          int64_t deadline)
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    uint32_t n = __free;
+    if (n != NIL) {
+        __free = __nodes[n].next;
+    } else {
+        n = static_cast<uint32_t>(__nodes.size());
+        __nodes.emplace_back();
+    }
+    __nodes[n].timer = expiry_timer{queue, pos, deadline};
+    place(n);
+    ++__count;
+    return (static_cast<handle>(__nodes[n].gen) << 32) | (n + 1);
+}
+
+void timer_wheel::cancel(handle h)
+{
+    if (!h) return;
+    uint32_t n   = static_cast<uint32_t>(h & UINT32_MAX) - 1;
+    uint32_t gen = static_cast<uint32_t>(h >> 32);
+    std::unique_lock<std::mutex> lock(__mtx);
+    if (n >= __nodes.size() || __nodes[n].gen != gen || __nodes[n].list == NIL) return;
+    unlink(n);
+    release(n);
+    --__count;
+}
+
+// 截止时间向上取整到 tick，宁晚勿早；超出总跨度的先挂在最高层最远一格，降级时重新计算
+void timer_wheel::place(uint32_t n)
+{
+    const uint64_t ms = static_cast<uint64_t>(__opts.tick.count());
+    const int64_t  deadline = __nodes[n].timer.deadline;
+    uint64_t at = deadline > 0 ? (static_cast<uint64_t>(deadline) + ms - 1) / ms : 0;
+    if (at <= __tick) {
+        link(DUE, n);
+        return;
+    }
+
+    uint64_t delta = at - __tick;
+    unsigned level = 0;
+    while (level + 1 < LEVELS && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) ++level;
+    const uint64_t span = uint64_t(1) << (SLOT_BITS * LEVELS);
+    if (delta >= span) at = __tick + span - 1;
+    link(level * SLOTS + ((at >> (SLOT_BITS * level)) & (SLOTS - 1)), n);
+}
+
+// 挂到链表尾：同一格内按挂入顺序到期
+void timer_wheel::link(uint32_t l, uint32_t n)
+{
+    node& x = __nodes[n];
+    if (l == DUE) ++__due;
+    x.list = l;
+    x.prev = __lists[l].tail;
+    x.next = NIL;
+    if (x.prev != NIL) __nodes[x.prev].next = n;
+    else               __lists[l].head = n;
+    __lists[l].tail = n;
+}
+
+void timer_wheel::unlink(uint32_t n)
+{
+    node& x = __nodes[n];
+    if (x.list == DUE) --__due;
+    list& l = __lists[x.list];
+    if (x.prev != NIL) __nodes[x.prev].next = x.next;
+    else               l.head = x.next;
+    if (x.next != NIL) __nodes[x.next].prev = x.prev;
+    else               l.tail = x.prev;
+    x.list = NIL;
+}
+
+void timer_wheel::release(uint32_t n)
+{
+    node& x = __nodes[n];
+    x.timer.queue.reset();
+    ++x.gen;
+    x.list = NIL;
+    x.next = __free;
+    __free = n;
+}
+
+// 第 level 层当前格整体降级：其中的定时器都落在接下来 SLOTS^level 个 tick 内
+void timer_wheel::cascade(unsigned level)
+{
+    list& slot = __lists[level * SLOTS + ((__tick >> (SLOT_BITS * level)) & (SLOTS - 1))];
+    uint32_t n = slot.head;
+    slot = list{};
+    while (n != NIL) {
+        uint32_t next = __nodes[n].next;
+        place(n);
+        n = next;
+    }
+}
+
+std::vector<expiry_timer> timer_wheel::advance(int64_t now_ms)
+{
+    std::vector<expiry_timer> out;
+    std::unique_lock<std::mutex> lock(__mtx);
+
+    uint64_t target = now_ms > 0 ? static_cast<uint64_t>(now_ms) / __opts.tick.count() : 0;
+    if (__count == __due && target > __tick) __tick = target;          // 轮上是空的：直接跳过去
+    while (__tick < target) {
+        ++__tick;
+        for (unsigned l = LEVELS; --l > 0; ) {
+            if ((__tick & ((uint64_t(1) << (SLOT_BITS * l)) - 1)) == 0) cascade(l);
+        }
+        list& slot = __lists[__tick & (SLOTS - 1)];
+        if (slot.head == NIL) continue;
+        for (uint32_t n = slot.head; n != NIL; n = __nodes[n].next) {
+            __nodes[n].list = DUE;
+            ++__due;
+        }
+        list& due = __lists[DUE];                      // 整条链接到 DUE 尾部
+        if (due.tail != NIL) {
+            __nodes[due.tail].next  = slot.head;
+            __nodes[slot.head].prev = due.tail;
+        } else {
+            due.head = slot.head;
+        }
+        due.tail = slot.tail;
+        slot = list{};
+    }
+
+    for (uint32_t n = __lists[DUE].head; n != NIL; ) {
+        uint32_t next = __nodes[n].next;
+        out.push_back(std::move(__nodes[n].timer));
+        release(n);
+        n = next;
+    }
+    __lists[DUE] = list{};
+    __due    = 0;
+    __count -= out.size();
+    return out;
+}
+
+std::size_t timer_wheel::pending() const
+{
+    std::unique_lock<std::mutex> lock(__mtx);
+    return __count;
+}
+
+}
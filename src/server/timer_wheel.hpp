@@ -0,0 +1,93 @@
+// ======================= timer_wheel.hpp =======================
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "msg_ring.hpp"                // msg_pos
+
+namespace hz_mq {
+
+class queue_message;                   // 前向声明
+
+// ---------- 定时轮参数 ----------
+struct timer_wheel_options {
+    std::chrono::milliseconds tick{10};                // 一格的时长，即过期精度
+};
+
+// 到期的一条消息：所在队列（弱引用）+ 就绪列表位置 + 截止时间（unix ms）
+struct expiry_timer {
+    std::weak_ptr<queue_message> queue;
+    msg_pos                      pos;
+    int64_t                      deadline;
+};
+
+// ===========================================================================
+// timer_wheel : 分层时间轮，驱动消息过期（x-message-ttl / expiration）
+//   · LEVELS 层、每层 SLOTS 格；第 l 层一格覆盖 SLOTS^l 个 tick，总跨度约 497 天（10 ms 一格）
+//   · schedule() O(1)：按距离选层，挂到截止 tick 所在的格，返回取消用的句柄
+//   · cancel() O(1)：定时器放在节点池里，每格是节点的双向链表，取消即摘链并归还节点；
+//     句柄带代号，节点复用后旧句柄自动失效。消息被消费 / 确认 / 删除时取消，
+//     轮上只保留仍在就绪列表中的消息，内存随待过期消息数而不是发布速率 × TTL 增长
+//   · advance() 每走一格只处理第 0 层当前格；低层转完一圈时把上一层对应格降级重挂，
+//     每个定时器最多降级 LEVELS - 1 次，摊还 O(1)
+//   · 线程安全；advance() 返回到期项后由调用方在锁外处理，避免与队列锁嵌套
+// ===========================================================================
+class timer_wheel {
+public:
+    using ptr     = std::shared_ptr<timer_wheel>;
+    using options = timer_wheel_options;
+    using handle  = uint64_t;                          // 0 表示没有定时器
+
+    static constexpr unsigned LEVELS    = 4;
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr unsigned SLOTS     = 1u << SLOT_BITS;
+
+    explicit timer_wheel(const options& opts = options(), int64_t now_ms = now());
+
+    handle schedule(const std::weak_ptr<queue_message>& queue, msg_pos pos, int64_t deadline);
+
+    // 取消尚未交出的定时器；已到期交出或已取消的句柄直接忽略
+    void cancel(handle h);
+
+    // 推进到 now_ms，取出截止时间已到的定时器
+    std::vector<expiry_timer> advance(int64_t now_ms);
+
+    std::size_t pending() const;                       // 轮上的定时器数
+
+    static int64_t now();                              // unix 毫秒，与 BasicProperties.expire_at 同一时钟
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr uint32_t DUE = LEVELS * SLOTS;    // 截止 tick 已过、下次 advance 交出的链表
+
+    struct node {
+        expiry_timer timer;
+        uint32_t     gen{0};                           // 每次归还加一，使旧句柄失效
+        uint32_t     list{NIL};                        // 所在链表，NIL 表示空闲
+        uint32_t     prev{NIL};
+        uint32_t     next{NIL};                        // 空闲时串成空闲链表
+    };
+    struct list { uint32_t head{NIL}, tail{NIL}; };
+
+    void place(uint32_t n);                            // 需持有 __mtx
+    void link(uint32_t l, uint32_t n);                 // 需持有 __mtx
+    void unlink(uint32_t n);                           // 需持有 __mtx
+    void release(uint32_t n);                          // 需持有 __mtx
+    void cascade(unsigned level);                      // 需持有 __mtx
+
+    options                                  __opts;
+    mutable std::mutex                       __mtx;
+    uint64_t                                 __tick;   // 已处理到的 tick
+    std::vector<node>                        __nodes;
+    uint32_t                                 __free{NIL};
+    list                                     __lists[LEVELS * SLOTS + 1];   // 各格 + DUE
+    std::size_t                              __count{0};
+    std::size_t                              __due{0};     // DUE 链表长度
+};
+
+}
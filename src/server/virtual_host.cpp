@@ -4,7 +4,12 @@
 #include "route.hpp"                // 若 queue_message 里需要路由，可引
 
 #include "queue_message.hpp"        // 假设有该头（持久化实现）
+#include "../common/compress.hpp"   // basic_query 返回明文
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <utility>
+#include <vector>
 
 namespace hz_mq {
 
@@ -23,23 +28,140 @@ std::string virtual_host::generate_id()
 // -----------------------------------------------------------------------------
 virtual_host::virtual_host(const std::string& name,
                            const std::string& base_dir,
-                           const std::string& meta_db_path)
+                           const std::string& meta_db_path,
+                           const options& opts)
     : __name(name),
       __base_dir(base_dir),
+      __segment_bytes(opts.segment_bytes),
+      __committer(std::make_shared<group_commit>(opts.commit)),
+      __compactor(std::make_shared<compactor>(opts.compact)),
+      __checkpointer(std::make_shared<checkpointer>(meta_store::open(meta_db_path), opts.checkpoint)),
+      __timers(std::make_shared<timer_wheel>(opts.expiry)),
       __exchange_mgr(meta_db_path),
-      __queue_mgr(meta_db_path)
+      __queue_mgr(meta_db_path),
+      __binding_mapper(meta_db_path)
 {
+    // 消息确认落盘之前，其所属队列 / 绑定的声明必须已写进元数据 WAL
+    __committer->set_pre_commit([store = meta_store::open(meta_db_path)] { return store->flush(); });
+
     // 若默认 direct exchange 不存在，则创建
     if (!__exchange_mgr.exists("")) {
         __exchange_mgr.declare_exchange("", ExchangeType::DIRECT, false, false, {});
     }
 
-    // 为恢复的所有队列创建 queue_message 容器并恢复持久化消息
-    for (const auto& [qname, _] : __queue_mgr.all()) {
-        auto qm = std::make_shared<queue_message>(__base_dir, qname);
-        qm->recovery();
-        __queue_messages[qname] = std::move(qm);
+    for (const auto& [ename, ex] : __exchange_mgr.all()) __exchanges[ename] = ex;
+
+    // 为恢复的所有队列创建 queue_message 容器，持久化消息交给线程池并行恢复
+    for (const auto& [qname, qinfo] : __queue_mgr.all()) {
+        auto qm = std::make_shared<queue_message>(__base_dir, qname, __committer,
+                                                  __segment_bytes, qinfo->args, __timers);
+        qm->mark_recovering();
+        __queue_messages[qname] = hosted_queue{std::move(qm), qinfo->durable};
+        __exchange_bindings[""][qname] = std::make_shared<binding>("", qname, qname);
+    }
+
+    // 延迟投递暂存：到期时间（deliver_at）随记录落盘；有段文件时与持久化队列一起并行恢复
+    __delayed = std::make_shared<queue_message>(__base_dir, DELAYED_STORE, __committer,
+                                                __segment_bytes, queue_message::args{}, __timers);
+    if (std::filesystem::exists(__base_dir + "/" + DELAYED_STORE)) {
+        __delayed->mark_recovering();
+    } else {
+        __delayed->recovery();
+        __compactor->watch(__delayed);
+        __checkpointer->watch(__delayed);
+    }
+
+    // 恢复持久化绑定（两端都已恢复才生效）
+    for (const auto& bd : __binding_mapper.all()) {
+        if (__exchange_mgr.exists(bd->exchange_name) && __queue_mgr.exists(bd->queue_name))
+            __exchange_bindings[bd->exchange_name][bd->queue_name] = bd;
     }
+
+    start_recovery();
+}
+
+// 先等已缓冲的持久化写入落盘：挂在 committer 上的回调（如延迟消息的暂存确认）要在队列析构前执行
+virtual_host::~virtual_host()
+{
+    __committer->sync();
+}
+
+// -----------------------------------------------------------------------------
+// 并行恢复：每个队列一个任务，逐队列打印进度
+// -----------------------------------------------------------------------------
+void virtual_host::start_recovery()
+{
+    std::vector<std::pair<std::string, queue_message_ptr>> stores;
+    for (const auto& [qname, hq] : __queue_messages) stores.emplace_back(qname, hq.store);
+    if (!__delayed->ready()) stores.emplace_back(DELAYED_STORE, __delayed);
+    const size_t total = stores.size();
+    if (total == 0) return;
+
+    __recovering = total;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    __recovery_pool = std::make_shared<thread_pool>(std::min(threads, total));
+
+    auto start = std::chrono::steady_clock::now();
+    LOG(INFO) << "vhost [" << __name << "] recovering " << total << " queues on "
+              << std::min(threads, total) << " threads";
+
+    for (const auto& [qname, qm] : stores) {
+        __recovery_pool->push([this, qname = qname, qm = qm, total, start] {
+            auto t0 = std::chrono::steady_clock::now();
+            size_t n = qm->recovery();
+            __compactor->watch(qm);
+            __checkpointer->watch(qm);
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - t0).count();
+
+            size_t left;
+            {
+                std::unique_lock<std::mutex> lock(__recovery_mtx);
+                left = --__recovering;
+            }
+            LOG(INFO) << "queue [" << qname << "] recovered " << n << " messages in "
+                      << ms << " ms (" << total - left << "/" << total << ")";
+            if (left == 0) {
+                LOG(INFO) << "vhost [" << __name << "] recovery finished in "
+                          << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - start).count() << " ms";
+                __recovery_cv.notify_all();
+            }
+        });
+    }
+}
+
+bool virtual_host::queue_ready(const std::string& queue_name)
+{
+    auto hq = find_queue(queue_name);
+    return hq && hq.store->ready();
+}
+
+hosted_queue virtual_host::find_queue(const std::string& queue_name)
+{
+    std::shared_lock<std::shared_mutex> lock(__topology_mtx);
+    auto it = __queue_messages.find(queue_name);
+    return it == __queue_messages.end() ? hosted_queue{} : it->second;
+}
+
+void virtual_host::wait_recovered()
+{
+    std::unique_lock<std::mutex> lock(__recovery_mtx);
+    __recovery_cv.wait(lock, [this] { return __recovering == 0; });
+}
+
+bool virtual_host::recovered()
+{
+    std::unique_lock<std::mutex> lock(__recovery_mtx);
+    return __recovering == 0;
+}
+
+// 仅当交换机与队列都持久化时，绑定才需要落盘
+bool virtual_host::durable_binding(const std::string& exchange_name, const std::string& queue_name)
+{
+    auto ex = __exchange_mgr.select_exchange(exchange_name);
+    auto q  = __queue_mgr.select_queue(queue_name);
+    return ex && q && ex->durable && q->durable;
 }
 
 // -----------------------------------------------------------------------------
@@ -49,18 +171,38 @@ bool virtual_host::declare_exchange(const std::string& exchange_name, ExchangeTy
                                     bool durable, bool auto_delete,
                                     const std::unordered_map<std::string, std::string>& args)
 {
-    return __exchange_mgr.declare_exchange(exchange_name, type, durable, auto_delete, args);
+    std::unique_lock<std::mutex> admin(__admin_mtx);
+    if (!__exchange_mgr.declare_exchange(exchange_name, type, durable, auto_delete, args))
+        return false;
+    auto ex = __exchange_mgr.select_exchange(exchange_name);
+    std::unique_lock<std::shared_mutex> lock(__topology_mtx);
+    __exchanges[exchange_name] = std::move(ex);
+    return true;
 }
 
 void virtual_host::delete_exchange(const std::string& exchange_name)
 {
-    __exchange_bindings.erase(exchange_name);
+    std::unique_lock<std::mutex> admin(__admin_mtx);
+    msg_queue_binding_map removed;
+    {
+        std::unique_lock<std::shared_mutex> lock(__topology_mtx);
+        auto bit = __exchange_bindings.find(exchange_name);
+        if (bit != __exchange_bindings.end()) {
+            removed.swap(bit->second);
+            __exchange_bindings.erase(bit);
+        }
+        __exchanges.erase(exchange_name);
+    }
+    for (const auto& [qname, _] : removed)
+        if (durable_binding(exchange_name, qname)) __binding_mapper.remove(exchange_name, qname);
     __exchange_mgr.delete_exchange(exchange_name);
 }
 
 exchange::ptr virtual_host::select_exchange(const std::string& exchange_name)
 {
-    return __exchange_mgr.select_exchange(exchange_name);
+    std::shared_lock<std::shared_mutex> lock(__topology_mtx);
+    auto it = __exchanges.find(exchange_name);
+    return it == __exchanges.end() ? nullptr : it->second;
 }
 
 // -----------------------------------------------------------------------------
@@ -70,27 +212,47 @@ bool virtual_host::declare_queue(const std::string& queue_name, bool durable, bo
                                  bool auto_delete,
                                  const std::unordered_map<std::string, std::string>& args)
 {
+    if (queue_name == DELAYED_STORE) return false;           // 与延迟投递暂存共用目录
+    std::unique_lock<std::mutex> admin(__admin_mtx);
     if (!__queue_mgr.declare_queue(queue_name, durable, exclusive, auto_delete, args))
         return false;
 
-    if (!__queue_messages.count(queue_name)) {
-        auto qm = std::make_shared<queue_message>(__base_dir, queue_name);
+    if (!find_queue(queue_name)) {
+        // 恢复段文件可能较慢：只持管理锁，建好后再挂进拓扑
+        auto qm = std::make_shared<queue_message>(__base_dir, queue_name, __committer,
+                                                  __segment_bytes, args, __timers);
         if (durable) qm->recovery();
-        __queue_messages[queue_name] = std::move(qm);
+        if (durable || qm->lazy()) __compactor->watch(qm);   // lazy 队列的换出记录同样需要回收
+        if (durable) __checkpointer->watch(qm);
+        std::unique_lock<std::shared_mutex> lock(__topology_mtx);
+        __queue_messages[queue_name] = hosted_queue{std::move(qm), durable};
     }
        /* 与 AMQP 默认直连交换机 "" 建立 <队列名> 绑定，避免显式 bind 的麻烦 */
-    bind("", queue_name, queue_name);
+    add_binding("", queue_name, queue_name);
     return true;
 }
 
+// 先摘出拓扑再销毁：已查到该队列的发布 / 消费仍持有共享指针，destroy() 之后的写入会被拒绝
 void virtual_host::delete_queue(const std::string& queue_name)
 {
-    __queue_messages.erase(queue_name);
-    __queue_mgr.delete_queue(queue_name);
-
-    for (auto& [ex, bind_map] : __exchange_bindings) {
-        bind_map.erase(queue_name);
+    std::unique_lock<std::mutex> admin(__admin_mtx);
+    hosted_queue        removed;
+    std::vector<std::string> bound;              // 曾绑定该队列的交换机
+    {
+        std::unique_lock<std::shared_mutex> lock(__topology_mtx);
+        auto qit = __queue_messages.find(queue_name);
+        if (qit != __queue_messages.end()) {
+            removed = std::move(qit->second);
+            __queue_messages.erase(qit);
+        }
+        for (auto& [ex, bind_map] : __exchange_bindings) {
+            if (bind_map.erase(queue_name)) bound.push_back(ex);
+        }
     }
+    if (removed) removed.store->destroy();       // 连同段文件一起删除
+    for (const auto& ex : bound)
+        if (durable_binding(ex, queue_name)) __binding_mapper.remove(ex, queue_name);
+    __queue_mgr.delete_queue(queue_name);
 }
 
 bool virtual_host::exists_queue(const std::string& queue_name)
@@ -109,22 +271,38 @@ queue_map virtual_host::all_queues()
 bool virtual_host::bind(const std::string& exchange_name, const std::string& queue_name,
                         const std::string& binding_key)
 {
+    std::unique_lock<std::mutex> admin(__admin_mtx);
     if (!__exchange_mgr.exists(exchange_name) || !__queue_mgr.exists(queue_name))
         return false;
+    add_binding(exchange_name, queue_name, binding_key);
+    return true;
+}
+
+void virtual_host::add_binding(const std::string& exchange_name, const std::string& queue_name,
+                               const std::string& binding_key)
+{
+    auto bd = std::make_shared<binding>(exchange_name, queue_name, binding_key);
+    if (durable_binding(exchange_name, queue_name)) __binding_mapper.insert(bd);
 
+    std::unique_lock<std::shared_mutex> lock(__topology_mtx);
     auto& binding_map = __exchange_bindings[exchange_name];
-    binding_map[queue_name] = std::make_shared<binding>(exchange_name, queue_name, binding_key);
-    return true;
+    binding_map[queue_name] = std::move(bd);
 }
 
 void virtual_host::unbind(const std::string& exchange_name, const std::string& queue_name)
 {
-    auto it = __exchange_bindings.find(exchange_name);
-    if (it != __exchange_bindings.end()) it->second.erase(queue_name);
+    std::unique_lock<std::mutex> admin(__admin_mtx);
+    {
+        std::unique_lock<std::shared_mutex> lock(__topology_mtx);
+        auto it = __exchange_bindings.find(exchange_name);
+        if (it == __exchange_bindings.end() || !it->second.erase(queue_name)) return;
+    }
+    if (durable_binding(exchange_name, queue_name)) __binding_mapper.remove(exchange_name, queue_name);
 }
 
 msg_queue_binding_map virtual_host::exchange_bindings(const std::string& exchange_name)
 {
+    std::shared_lock<std::shared_mutex> lock(__topology_mtx);
     auto it = __exchange_bindings.find(exchange_name);
     return (it == __exchange_bindings.end()) ? msg_queue_binding_map{} : it->second;
 }
@@ -134,41 +312,71 @@ msg_queue_binding_map virtual_host::exchange_bindings(const std::string& exchang
 // -----------------------------------------------------------------------------
 bool virtual_host::basic_publish(const std::string& queue_name,
     BasicProperties*   bp,
-    const std::string& body)
+    const std::string& body,
+    bool*              full,
+    durable_span*      span)
+{
+return publish_queue(queue_name, bp, body, nullptr, full, span);
+}
+
+bool virtual_host::basic_publish(const std::string& queue_name,
+    BasicProperties*   bp,
+    const shared_body& body,
+    bool*              full,
+    durable_span*      span)
+{
+return publish_queue(queue_name, bp, *body, &body, full, span);
+}
+
+// share 非空时（*share 即 body）队列只引用这份消息体
+bool virtual_host::publish_queue(const std::string& queue_name,
+    BasicProperties*   bp,
+    const std::string& body,
+    const shared_body* share,
+    bool*              full,
+    durable_span*      span)
 {
 // 1) 队列必须存在
-auto it = __queue_messages.find(queue_name);
-if (it == __queue_messages.end())
+auto hq = find_queue(queue_name);
+if (!hq)
 {
 LOG(ERROR) << "publish failed: queue [" << queue_name << "] not exist";
 return false;
 }
+if (!hq.store->ready())
+{
+LOG(WARNING) << "publish rejected: queue [" << queue_name << "] is recovering";
+return false;
+}
 
 // 2) routing_key 规则（直连交换机 "")：
 //    · 为空        ⇒ 视为 queue_name
 //    · 不为空且不等 ⇒ 视为路由不匹配，直接返回 false
 if (!bp) bp = new BasicProperties;          // 避免空指针
+bp->clear_deliver_at();                     // 延迟投递字段只在暂存队列内部使用
+bp->clear_delay_exchange();
 if (bp->routing_key().empty())
 bp->set_routing_key(queue_name);
 else if (bp->routing_key() != queue_name)   // ★ 这一行是关键
 return false;
 
-// 3) 是否持久化
-bool durable = false;
-if (auto qinfo = __queue_mgr.select_queue(queue_name))
-durable = qinfo->durable;
-
-// 4) 入队
-return it->second->insert(bp, body, durable);
+// 3) 入队（是否持久化由声明时定下）；超出长度上限时按 x-overflow 挤出队首或拒收，产生的死信随即转投
+const auto& qm = hq.store;
+bool ok = share ? qm->insert(bp, *share, hq.durable, full, span)
+              : qm->insert(bp, body, hq.durable, full, span);
+if (qm->dead_letters()) dead_letter(qm);
+return ok;
 }
 
 
 bool virtual_host::publish_ex(const std::string& exchange_name,
     const std::string& routing_key,
     BasicProperties*   bp,
-    const std::string& body)
+    const std::string& body,
+    uint64_t           delay_ms,
+    durable_span*      span)
 {
-auto ex = __exchange_mgr.select_exchange(exchange_name);
+auto ex = select_exchange(exchange_name);
 if (!ex)
 {
 LOG(ERROR) << "publish failed: exchange [" << exchange_name << "] not exist";
@@ -179,59 +387,341 @@ return false;
 BasicProperties local_bp;
 if (!bp) bp = &local_bp;
 if (bp->routing_key().empty()) bp->set_routing_key(routing_key);
+bp->clear_deliver_at();
+bp->clear_delay_exchange();
 
-bool delivered = false;
-for (auto& [qname, bind] : exchange_bindings(exchange_name))
+// 延迟投递：路由推迟到到期时，按那时的绑定决定目标队列
+if (delay_ms > 0)
+return park(exchange_name, *bp, body, delay_ms, span);
+return route(ex, bp, body, nullptr, nullptr, nullptr, span);
+}
+
+
+bool virtual_host::publish_ex(const std::string& exchange_name,
+    BasicProperties*           bp,
+    std::string&&              body,
+    std::vector<std::string>&  queues,
+    bool*                      unroutable,
+    durable_span*              span)
+{
+auto ex = select_exchange(exchange_name);
+if (!ex)
+{
+LOG(ERROR) << "publish failed: exchange [" << exchange_name << "] not exist";
+return false;
+}
+
+BasicProperties local_bp;
+if (!bp) bp = &local_bp;
+bp->clear_deliver_at();
+bp->clear_delay_exchange();
+return route(ex, bp, body, &queues, &body, unroutable, span);
+}
+
+
+// queues 非空时回填实际入队的队列名；owned 非空时（即 body 本身）消息体直接接管不再拷贝。
+// 多个目标队列时消息体只存一份（shared_body），各队列只各自多一个描述。
+// 任一目标队列因长度上限拒收（reject-publish）即返回 false，发布方收到否定确认
+bool virtual_host::route(const exchange::ptr& ex, BasicProperties* bp, const std::string& body,
+    std::vector<std::string>* queues, std::string* owned, bool* unroutable, durable_span* span)
+{
+// 先在拓扑读锁下选出目标队列（入队时已不持锁）：任一目标仍在恢复则整体拒绝，避免只投递到部分队列
+std::vector<std::pair<std::string, hosted_queue>> targets;
+{
+std::shared_lock<std::shared_mutex> lock(__topology_mtx);
+auto bit = __exchange_bindings.find(ex->name);
+if (bit != __exchange_bindings.end())
+for (auto& [qname, bind] : bit->second)
 {
 if (!router::match_route(ex->type, bp->routing_key(), bind->binding_key))
 continue;
 
-bool durable = false;
-if (auto qinfo = __queue_mgr.select_queue(qname))
-durable = qinfo->durable;
-
 auto qit = __queue_messages.find(qname);
-if (qit != __queue_messages.end())
-delivered |= qit->second->insert(bp, body, durable);
+if (qit == __queue_messages.end())
+continue;
+if (!qit->second.store->ready())
+{
+LOG(WARNING) << "publish rejected: queue [" << qname << "] is recovering";
+return false;
 }
-return delivered;
+targets.emplace_back(qname, qit->second);
 }
+}
+
+if (unroutable) *unroutable = targets.empty();
 
+shared_body share;
+if (targets.size() > 1)
+share = std::make_shared<std::string>(owned ? std::move(*owned) : body);
 
-message_ptr virtual_host::basic_consume(const std::string& queue_name)
+bool delivered = false;
+bool refused   = false;
+for (auto& [qname, hq] : targets)
 {
-    auto it = __queue_messages.find(queue_name);
-    if (it == __queue_messages.end()) {
+const auto& qm = hq.store;
+bool full = false;
+bool ok = share ? qm->insert(bp, share, hq.durable, &full, span)
+        : owned ? qm->insert(bp, std::move(*owned), hq.durable, &full, span)
+        : qm->insert(bp, body, hq.durable, &full, span);
+if (ok && queues) queues->push_back(qname);
+if (qm->dead_letters()) dead_letter(qm);
+delivered |= ok;
+refused   |= full;
+}
+return delivered && !refused;
+}
+
+
+// 暂存一条延迟消息：截止时间与原交换机写进属性，持久化消息随暂存队列落盘
+bool virtual_host::park(const std::string& exchange_name, const BasicProperties& bp,
+    const std::string& body, uint64_t delay_ms, durable_span* span)
+{
+if (!__delayed->ready())
+{
+LOG(WARNING) << "delayed publish rejected: delayed store is recovering";
+return false;
+}
+BasicProperties parked(bp);
+parked.set_deliver_at(timer_wheel::now() + static_cast<int64_t>(std::min<uint64_t>(delay_ms, INT64_MAX / 2)));
+parked.set_delay_exchange(exchange_name);
+return __delayed->insert(&parked, body, true, nullptr, span);
+}
+
+
+message_ptr virtual_host::basic_consume(const std::string& queue_name, shared_body* share)
+{
+    auto msg = std::make_shared<Message>();
+    return basic_consume(queue_name, *msg, share) ? msg : nullptr;
+}
+
+bool virtual_host::basic_consume(const std::string& queue_name, Message& out, shared_body* share)
+{
+    auto hq = find_queue(queue_name);
+    if (!hq) {
         LOG(ERROR) << "consume failed: queue [" << queue_name << "] not exist";
-        return {};
+        return false;
+    }
+    const auto& qm = hq.store;
+    if (!qm->ready()) {
+        LOG(WARNING) << "consume rejected: queue [" << queue_name << "] is recovering";
+        return false;
     }
 
-    auto msg = it->second->front();
-    if (msg)             // ★ 自动确认（符合测试用例预期）
-        it->second->remove(msg->payload().properties().id());
-    return msg;
+    bool got = qm->pop_front(out, share);   // ★ 自动确认（符合测试用例预期）
+    if (qm->dead_letters()) dead_letter(qm);   // 出队时跳过的过期队首
+    return got;
 }
 
-void virtual_host::basic_ack(const std::string& queue_name, const std::string& msg_id)
+bool virtual_host::basic_ack(const std::string& queue_name, const std::string& msg_id)
 {
-    auto it = __queue_messages.find(queue_name);
-    if (it == __queue_messages.end()) {
+    // 空 id 在 queue_message::remove 里表示删队首，确认请求绝不能走到那里
+    if (msg_id.empty()) {
+        LOG(WARNING) << "ack rejected: empty message id on queue [" << queue_name << "]";
+        return false;
+    }
+    auto hq = find_queue(queue_name);
+    if (!hq) {
         LOG(ERROR) << "ack failed: queue [" << queue_name << "] not exist";
-        return;
+        return false;
     }
-    it->second->remove(msg_id);
+    if (!hq.store->ready()) {
+        LOG(WARNING) << "ack rejected: queue [" << queue_name << "] is recovering";
+        return false;
+    }
+    return hq.store->remove(msg_id);
+}
+
+message_ptr virtual_host::basic_get(const std::string& queue_name, uint64_t& inflight,
+                                    shared_body* share)
+{
+    auto msg = std::make_shared<Message>();
+    return basic_get(queue_name, inflight, *msg, share) ? msg : nullptr;
+}
+
+bool virtual_host::basic_get(const std::string& queue_name, uint64_t& inflight, Message& out,
+                             shared_body* share)
+{
+    auto hq = find_queue(queue_name);
+    if (!hq) {
+        LOG(ERROR) << "get failed: queue [" << queue_name << "] not exist";
+        return false;
+    }
+    const auto& qm = hq.store;
+    if (!qm->ready()) {
+        LOG(WARNING) << "get rejected: queue [" << queue_name << "] is recovering";
+        return false;
+    }
+    bool got = qm->deliver(inflight, out, share);
+    if (qm->dead_letters()) dead_letter(qm);
+    return got;
+}
+
+bool virtual_host::basic_ack_inflight(const std::string& queue_name, uint64_t inflight)
+{
+    auto hq = find_queue(queue_name);
+    return hq && hq.store->ack(inflight);
+}
+
+bool virtual_host::basic_reject(const std::string& queue_name, uint64_t inflight, bool requeue)
+{
+    auto hq = find_queue(queue_name);
+    if (!hq) return false;
+    const auto& qm = hq.store;
+    if (requeue) return qm->requeue(inflight);
+    if (!qm->reject(inflight)) return false;
+    if (qm->dead_letters()) dead_letter(qm);
+    return true;
+}
+
+void virtual_host::when_durable(const durable_span& span, const group_commit::callback& cb)
+{
+    __committer->when_durable(span, cb);
 }
 
 std::string virtual_host::basic_query()
 {
-    for (auto& [qname, qm] : __queue_messages) {
-        if (qm->getable_count() == 0) continue;
-        if (auto msg = qm->front()) {
-            qm->remove(msg->payload().properties().id());
+    std::vector<queue_message_ptr> stores;
+    {
+        std::shared_lock<std::shared_mutex> lock(__topology_mtx);
+        for (const auto& [qname, hq] : __queue_messages) stores.push_back(hq.store);
+    }
+    for (const auto& qm : stores) {
+        if (!qm->ready() || qm->getable_count() == 0) continue;
+        auto msg = qm->pop_front();
+        if (qm->dead_letters()) dead_letter(qm);
+        if (msg) {
+            if (msg->payload().properties().content_encoding() == ContentEncoding::ZLIB) {
+                std::string plain;
+                if (zlib_decompress(msg->payload().body(), plain)) return plain;
+            }
             return msg->payload().body();
         }
     }
     return {};
 }
 
+// -----------------------------------------------------------------------------
+// 时间轮：到期项按队列归并，每个队列加一次锁；暂存队列里到期的是延迟消息；
+// 配置了死信交换机的队列，过期消息随即转投
+// -----------------------------------------------------------------------------
+size_t virtual_host::expire_tick()
+{
+    int64_t now = timer_wheel::now();
+    auto    due = __timers->advance(now);
+    if (due.empty()) return 0;
+
+    std::unordered_map<queue_message_ptr, std::vector<msg_pos>> by_queue;
+    for (const auto& t : due) {
+        if (auto qm = t.queue.lock()) by_queue[qm].push_back(t.pos);   // 队列已删除则忽略
+    }
+    size_t n = 0;
+    for (const auto& [qm, positions] : by_queue) {
+        if (qm == __delayed) {
+            n += release_delayed(positions, now);
+            continue;
+        }
+        n += qm->expire(positions, now);
+        if (qm->dead_letters()) dead_letter(qm);
+    }
+    return n;
+}
+
+// 到期的延迟消息按原交换机的当前绑定路由；路由出的持久化写入落盘后才在暂存队列中确认
+size_t virtual_host::release_delayed(const std::vector<msg_pos>& positions, int64_t now)
+{
+    // 目标队列可能还在恢复、会拒绝写入：下一格再试
+    if (!recovered()) {
+        __delayed->defer(positions, now, now + 1);
+        return 0;
+    }
+
+    auto due = __delayed->take_due(positions, now);
+    durable_span span;                           // 只等这几条转投自己的写入
+    std::vector<uint64_t> inflight;
+    inflight.reserve(due.size());
+    for (auto& [token, msg] : due) {
+        inflight.push_back(token);
+        BasicProperties* bp = msg->mutable_payload()->mutable_properties();
+        std::string exchange_name = bp->delay_exchange();
+        bp->clear_deliver_at();
+        bp->clear_delay_exchange();
+        bp->clear_expire_at();                   // 入队时按目标队列的 TTL 重新计算
+        if (!republish(exchange_name, bp, std::move(*msg->mutable_payload()->mutable_body()), &span))
+            LOG(WARNING) << "delayed message dropped: exchange [" << exchange_name << "] unroutable";
+    }
+    // 弱引用：回调挂在 committer 上，强引用会形成 committer -> 暂存队列 -> committer 的环
+    __committer->when_durable(span, [store = std::weak_ptr<queue_message>(__delayed),
+                                     inflight = std::move(inflight)](bool ok) {
+        if (!ok) return;                    // 转投的持久化消息没落盘：暂存记录保留，重启后重新投递
+        if (auto qm = store.lock()) {
+            for (uint64_t t : inflight) qm->ack(t);
+        }
+    });
+    return due.size();
+}
+
+// broker 内部转投（延迟到期 / 死信）：与 publish_ex 同一条路由路径，消息体由调用方交出不再拷贝；
+// 目标队列没有发布方通道替它派发消费任务，入队后逐个回调
+bool virtual_host::republish(const std::string& exchange_name, BasicProperties* bp, std::string&& body,
+                             durable_span* span)
+{
+    auto ex = select_exchange(exchange_name);
+    if (!ex) return false;
+    std::vector<std::string> queues;
+    bool ok = route(ex, bp, body, &queues, &body, nullptr, span);
+    if (__on_ready) {
+        for (const auto& q : queues) __on_ready(q);
+    }
+    return ok;
+}
+
+// 取走队列攒下的死信（过期 / 拒绝），记下死因后经 x-dead-letter-exchange 重新路由。
+// 由产生死信的调用（expire_tick / basic_consume / basic_get / basic_reject）在队列锁外同步完成；
+// 原队列中的记录已删除而新队列的写入走 group commit，崩溃时与 AMQP 经典队列一样至多一次
+void virtual_host::dead_letter(const queue_message_ptr& qm)
+{
+    static metric& m_dead    = metrics::instance().get("dlx.dead_lettered");
+    static metric& m_dropped = metrics::instance().get("dlx.dropped");
+
+    auto dead = qm->take_dead();
+    if (dead.empty()) return;
+    size_t routed = 0;
+    for (auto& msg : dead) {
+        BasicProperties* bp = msg->mutable_payload()->mutable_properties();
+        if (bp->death_count() >= MAX_DEAD_LETTER_HOPS) {
+            LOG(WARNING) << "dead letter dropped: message [" << bp->id() << "] exceeded "
+                         << MAX_DEAD_LETTER_HOPS << " hops (dead-letter cycle?)";
+            m_dropped.observe(1);
+            continue;
+        }
+        bp->set_death_count(bp->death_count() + 1);
+        bp->set_death_queue(qm->name());
+        bp->clear_expiration();                  // 与 AMQP 一致：死信不再带原消息的 TTL
+        bp->clear_expire_at();
+        if (!qm->dead_letter_routing_key().empty())
+            bp->set_routing_key(qm->dead_letter_routing_key());
+
+        if (republish(qm->dead_letter_exchange(), bp, std::move(*msg->mutable_payload()->mutable_body())))
+            ++routed;
+        else
+            m_dropped.observe(1);
+    }
+    if (routed) m_dead.observe(routed);
+}
+
+size_t virtual_host::delayed_count()
+{
+    return __delayed->getable_count();
+}
+
+void virtual_host::set_ready_callback(const ready_callback& cb)
+{
+    __on_ready = cb;
+}
+
+void virtual_host::notify_ready(const std::string& queue_name)
+{
+    if (__on_ready) __on_ready(queue_name);
+}
+
 } 
@@ -1,13 +1,23 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
 
 #include "exchange.hpp"
 #include "queue.hpp"
 #include "binding.hpp"
+#include "group_commit.hpp"
+#include "compactor.hpp"
+#include "checkpointer.hpp"
+#include "timer_wheel.hpp"
+#include "../common/thread_pool.hpp"
 #include "../common/message.hpp"
 #include "../common/protocol.pb.h"  // ExchangeType
 #include "../common/msg.pb.h"       // BasicProperties, Message
@@ -17,16 +27,52 @@ namespace hz_mq {
 class queue_message;                       // 前向声明：单队列持久化 / 运行时消息存储
 using queue_message_ptr = std::shared_ptr<queue_message>;
 
+// 延迟投递暂存队列：AMQP 保留的 amq. 前缀，不会与用户队列重名
+inline constexpr const char* DELAYED_STORE = "amq.delayed";
+
+// 同一条消息最多被死信转投的次数：超过即丢弃，防止死信交换机成环时无限循环
+inline constexpr uint32_t MAX_DEAD_LETTER_HOPS = 16;
+
+// ---------- 拓扑中的一个队列：消息存储 + 声明时定下的持久化标志 ----------
+// 发布路径从这里取 durable，不再经过 msg_queue_manager 的全局锁
+struct hosted_queue {
+    queue_message_ptr store;
+    bool              durable{false};
+
+    explicit operator bool() const { return static_cast<bool>(store); }
+};
+
+// ---------- 存储相关参数 ----------
+struct virtual_host_options {
+    group_commit::options commit;
+    compactor::options    compact;
+    checkpointer::options checkpoint;
+    timer_wheel::options  expiry;
+    uint64_t              segment_bytes{segment_log::DEFAULT_SEGMENT_BYTES};   // 队列段文件大小
+};
+
 // ==============================================================
 // virtual_host : Broker 核心状态（exchanges / queues / bindings）
+//
+// 并发：发布在 IO 线程、消费在线程池，可以同时进入。
+//   · 拓扑（交换机 / 队列 / 绑定三张表）读多写少，由读写锁 __topology_mtx 保护；
+//     读路径持读锁查出目标队列的共享指针后立即释放，之后只与该队列自己的锁打交道，
+//     不同队列上的发布 / 消费互不阻塞
+//   · 声明、删除、绑定等管理操作由 __admin_mtx 串行（含元数据落盘与段文件恢复），
+//     只在改表的一瞬间持写锁，不会因慢 IO 卡住消息路径
+//   · 锁序：__admin_mtx → __topology_mtx → queue_message 内部锁；持拓扑锁时不进入队列
 // ==============================================================
 class virtual_host {
 public:
-    using ptr = std::shared_ptr<virtual_host>;
+    using ptr            = std::shared_ptr<virtual_host>;
+    using options        = virtual_host_options;
+    using ready_callback = std::function<void(const std::string& queue_name)>;
 
     virtual_host(const std::string& name,
                  const std::string& base_dir,
-                 const std::string& meta_db_path);
+                 const std::string& meta_db_path,
+                 const options& opts = options());
+    ~virtual_host();
 
     // ------------------- Exchange -------------------
     bool declare_exchange(const std::string& exchange_name, ExchangeType type,
@@ -57,30 +103,117 @@ public:
         BasicProperties* bp,
         const std::string& body);   
     // ------------------- Message --------------------
+    // full 非空时回填：队列因 x-max-length / x-max-length-bytes 拒收（reject-publish）；
+    // span 非空时回填本次发布自己的持久化追加序号（没有持久化写入则为空），交给 when_durable
     bool basic_publish(const std::string& queue_name,
         BasicProperties*   bp,
-        const std::string& body);
+        const std::string& body,
+        bool*              full = nullptr,
+        durable_span*      span = nullptr);
 
+    // 扇出到多个队列时共享同一份消息体：每个队列只多一个描述，不再逐队列拷贝
+    bool basic_publish(const std::string& queue_name,
+        BasicProperties*   bp,
+        const shared_body& body,
+        bool*              full = nullptr,
+        durable_span*      span = nullptr);
+
+    // delay_ms > 0：先暂存，到期后再按当时的绑定路由（持久化消息的暂存同样落盘）
     bool publish_ex(const std::string& exchange_name,
         const std::string& routing_key,
          BasicProperties*   bp,
-        const std::string& body);
-    message_ptr basic_consume(const std::string& queue_name);
-    void basic_ack(const std::string& queue_name, const std::string& msg_id);
+        const std::string& body,
+        uint64_t           delay_ms = 0,
+        durable_span*      span = nullptr);
+
+    // 网络发布路径（channel::basic_publish）：消息体由调用方交出，多个目标队列共享一份；
+    // queues 回填实际入队的队列名（调用方据此派发消费），unroutable 回填是否没有匹配任何绑定
+    bool publish_ex(const std::string& exchange_name,
+        BasicProperties*           bp,
+        std::string&&              body,
+        std::vector<std::string>&  queues,
+        bool*                      unroutable = nullptr,
+        durable_span*              span = nullptr);
+    // share 非空时，扇出共享的消息体只交出引用（返回的 Message 不带消息体），由调用方从 *share 读取
+    message_ptr basic_consume(const std::string& queue_name, shared_body* share = nullptr);
+    // 填进调用方给出的 Message（可在 Arena 上），队列不存在或为空返回 false
+    bool basic_consume(const std::string& queue_name, Message& out, shared_body* share = nullptr);
+    bool basic_ack(const std::string& queue_name, const std::string& msg_id);   // 空 id / 无此消息返回 false
+
+    // 手动确认：队首移入该队列的 unacked 集合（不再就绪、也不会丢失），inflight 回填凭据
+    message_ptr basic_get(const std::string& queue_name, uint64_t& inflight,
+                          shared_body* share = nullptr);
+    bool basic_get(const std::string& queue_name, uint64_t& inflight, Message& out,
+                   shared_body* share = nullptr);
+    bool basic_ack_inflight(const std::string& queue_name, uint64_t inflight);
+    bool basic_reject(const std::string& queue_name, uint64_t inflight, bool requeue);
 
     std::string basic_query();  // 简化的 pull 查询
 
+    // ------------------- Expiry ---------------------
+    // 推进时间轮：丢弃（或死信转投）过期消息、路由到期的延迟消息，返回处理条数；
+    // 由 Broker 事件循环按 tick 周期调用
+    size_t expire_tick();
+    size_t delayed_count();                                   // 暂存中的延迟消息数
+
+    // 延迟消息 / 死信由 broker 内部转投入队后回调（没有发布方通道替它派发消费任务）；启动时设置一次
+    void set_ready_callback(const ready_callback& cb);
+    void notify_ready(const std::string& queue_name);         // 消息退回队列等场合手动触发派发
+
+    // ------------------- Recovery -------------------
+    // 构造函数只把持久化队列的恢复任务派发到线程池；恢复完成前该队列上的读写被拒绝
+    bool queue_ready(const std::string& queue_name);
+    void wait_recovered();                                    // 阻塞到所有队列恢复完成
+
+    // ------------------- Group commit ---------------
+    // 发布时回填的 span 落盘后回调（提交线程中执行）；只等这次发布自己的写入，
+    // 不受其他连接并发的持久化发布影响
+    void when_durable(const durable_span& span, const group_commit::callback& cb);
+
 private:
     std::string                                   __name;
     std::string                                   __base_dir;
+    uint64_t                                      __segment_bytes;
+    group_commit::ptr                             __committer;
+    compactor::ptr                                __compactor;
+    checkpointer::ptr                             __checkpointer;
+    timer_wheel::ptr                              __timers;           // 所有队列共用的过期时间轮
 
     exchange_manager                              __exchange_mgr;
     msg_queue_manager                             __queue_mgr;
+    binding_mapper                                __binding_mapper;   // 持久化绑定
 
+    std::mutex                                    __admin_mtx;        // 串行化拓扑变更
+    std::shared_mutex                             __topology_mtx;     // 保护下面三张表
+    std::unordered_map<std::string, exchange::ptr>         __exchanges;         // 交换机表的只读镜像
     std::unordered_map<std::string, msg_queue_binding_map> __exchange_bindings; // exchange -> (queue -> binding)
-    std::unordered_map<std::string, queue_message_ptr>     __queue_messages;    // queue -> message storage
+    std::unordered_map<std::string, hosted_queue>          __queue_messages;    // queue -> message storage
+    queue_message_ptr                             __delayed;          // 延迟投递暂存（DELAYED_STORE）
+    ready_callback                                __on_ready;
+
+    std::mutex                                    __recovery_mtx;
+    std::condition_variable                       __recovery_cv;
+    size_t                                        __recovering{0};    // 尚未恢复完成的队列数
+    thread_pool::ptr                              __recovery_pool;    // 最后析构：先等恢复任务结束
 
     static std::string generate_id();  // 若调用方需要自行生成 msg_id
+    hosted_queue find_queue(const std::string& queue_name);   // 读锁下查表，拷出共享指针
+    void add_binding(const std::string& exchange_name, const std::string& queue_name,
+                     const std::string& binding_key);         // 需持有 __admin_mtx
+    bool durable_binding(const std::string& exchange_name, const std::string& queue_name);
+    void start_recovery();
+    bool recovered();
+    bool publish_queue(const std::string& queue_name, BasicProperties* bp, const std::string& body,
+                       const shared_body* share, bool* full, durable_span* span);
+    bool route(const exchange::ptr& ex, BasicProperties* bp, const std::string& body,
+               std::vector<std::string>* queues, std::string* owned = nullptr,
+               bool* unroutable = nullptr, durable_span* span = nullptr);
+    bool republish(const std::string& exchange_name, BasicProperties* bp, std::string&& body,
+                   durable_span* span = nullptr);
+    void dead_letter(const queue_message_ptr& qm);
+    bool park(const std::string& exchange_name, const BasicProperties& bp,
+              const std::string& body, uint64_t delay_ms, durable_span* span);
+    size_t release_delayed(const std::vector<msg_pos>& positions, int64_t now);
 };
 
 } 
\ No newline at end of file
@@ -0,0 +1,185 @@
+/********************************************************************
+*  test_concurrency.cpp —— virtual_host 多线程访问：拓扑读写锁 + 队列自身的锁
+*  （make TSAN=1 mq_test 在 ThreadSanitizer 下运行）
+********************************************************************/
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "../server/virtual_host.hpp"
+#include "../server/queue_message.hpp"
+
+using namespace hz_mq;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class ConcurrencyFixture : public ::testing::Test {
+protected:
+    void SetUp()    override { fs::remove_all(dir); }
+    void TearDown() override { fs::remove_all(dir); }
+
+    virtual_host::ptr open_host()
+    {
+        return std::make_shared<virtual_host>("conc", dir, dir + "/meta.db");
+    }
+
+    // 启动 n 个线程执行 fn(i)，全部结束后返回
+    template <typename F>
+    static void run_threads(size_t n, F&& fn)
+    {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < n; ++i) threads.emplace_back([&fn, i] { fn(i); });
+        for (auto& t : threads) t.join();
+    }
+
+    const std::string dir = "./testdata_concurrency";
+};
+
+constexpr size_t THREADS = 4;
+constexpr size_t PER_THREAD = 2000;
+
+} // namespace
+
+/* ---------- C1 每个线程各自一个队列：发布与消费并行，条数不丢不多 ---------- */
+TEST_F(ConcurrencyFixture, DistinctQueuesInParallel)
+{
+    auto vh = open_host();
+    for (size_t i = 0; i < THREADS; ++i)
+        ASSERT_TRUE(vh->declare_queue("q" + std::to_string(i), false, false, false, {}));
+
+    std::atomic<size_t> consumed{0};
+    std::atomic<size_t> producers{THREADS};
+    run_threads(THREADS * 2, [&](size_t i) {
+        const std::string q = "q" + std::to_string(i % THREADS);
+        if (i < THREADS) {                                  // 发布方
+            for (size_t n = 0; n < PER_THREAD; ++n) {
+                BasicProperties bp;
+                EXPECT_TRUE(vh->basic_publish(q, &bp, "body"));
+            }
+            --producers;
+            return;
+        }
+        for (;;) {                                          // 消费方：发布方都结束且队列取空才退出
+            bool done = producers.load() == 0;
+            if (vh->basic_consume(q)) { ++consumed; continue; }
+            if (done) break;
+            std::this_thread::yield();
+        }
+    });
+    EXPECT_EQ(consumed.load(), THREADS * PER_THREAD);
+}
+
+/* ---------- C2 多个发布方与手动确认的消费方共用一个队列：每条恰好投递一次 ---------- */
+TEST_F(ConcurrencyFixture, SharedQueueDeliversEachOnce)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("shared", false, false, false, {}));
+
+    std::mutex             mtx;
+    std::set<std::string>  seen;
+    std::atomic<size_t>    producers{THREADS};
+    std::atomic<size_t>    duplicates{0};
+    run_threads(THREADS * 2, [&](size_t i) {
+        if (i < THREADS) {
+            for (size_t n = 0; n < PER_THREAD; ++n) {
+                BasicProperties bp;
+                bp.set_id(std::to_string(i) + "-" + std::to_string(n));
+                EXPECT_TRUE(vh->basic_publish("shared", &bp, "S"));
+            }
+            --producers;
+            return;
+        }
+        for (;;) {
+            bool     done     = producers.load() == 0;
+            uint64_t inflight = 0;
+            auto m = vh->basic_get("shared", inflight);
+            if (!m) {
+                if (done) break;
+                std::this_thread::yield();
+                continue;
+            }
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                if (!seen.insert(m->payload().properties().id()).second) ++duplicates;
+            }
+            EXPECT_TRUE(vh->basic_ack_inflight("shared", inflight));
+        }
+    });
+    EXPECT_EQ(seen.size(), THREADS * PER_THREAD);
+    EXPECT_EQ(duplicates.load(), 0u);
+}
+
+/* ---------- C3 发布经交换机路由的同时反复声明 / 绑定 / 解绑 / 删除队列 ---------- */
+TEST_F(ConcurrencyFixture, TopologyChurnDuringRouting)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_exchange("fan", ExchangeType::FANOUT, false, false, {}));
+    ASSERT_TRUE(vh->declare_queue("stable", false, false, false, {}));
+    ASSERT_TRUE(vh->bind("fan", "stable", ""));
+
+    // 发布方各发固定条数；管理线程一直变更拓扑直到发布结束。stable 始终绑定，每条都应进入 stable
+    std::atomic<size_t> producers{THREADS};
+    std::atomic<size_t> routed{0}, consumed{0};
+    std::thread admin([&] {
+        for (int round = 0; producers.load() > 0; ++round) {
+            const std::string q = "churn" + std::to_string(round % 8);
+            vh->declare_queue(q, false, false, false, {});
+            vh->bind("fan", q, "");
+            vh->basic_consume(q);
+            if (round % 2) vh->unbind("fan", q);
+            else vh->delete_queue(q);
+        }
+    });
+    run_threads(THREADS, [&](size_t) {
+        for (size_t n = 0; n < PER_THREAD / 4; ++n) {
+            if (vh->publish_ex("fan", "", nullptr, "F")) ++routed;
+            if (vh->basic_consume("stable")) ++consumed;
+            vh->exchange_bindings("fan");
+        }
+        --producers;
+    });
+    admin.join();
+
+    size_t left = 0;
+    while (vh->basic_consume("stable")) ++left;
+    EXPECT_EQ(routed.load(), THREADS * PER_THREAD / 4);
+    EXPECT_EQ(consumed.load() + left, routed.load());
+}
+
+/* ---------- C4 发布方已查到队列时队列被删除：之后的持久化写入被拒绝，不会重建段文件 ---------- */
+TEST_F(ConcurrencyFixture, DestroyedQueueRefusesWrites)
+{
+    auto qm = std::make_shared<queue_message>(dir, "gone");
+    BasicProperties bp;
+    bp.set_delivery_mode(DeliveryMode::DURABLE);
+    ASSERT_TRUE(qm->insert(&bp, "before", true));
+    EXPECT_TRUE(fs::exists(dir + "/gone"));
+
+    qm->destroy();
+    EXPECT_FALSE(qm->insert(&bp, "after", true));
+    EXPECT_FALSE(qm->insert(&bp, "after", false));
+    EXPECT_FALSE(fs::exists(dir + "/gone"));
+    EXPECT_EQ(qm->getable_count(), 0u);
+
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("dq", true, false, false, {}));
+    std::atomic<bool> stop{false};
+    std::thread publisher([&] {
+        while (!stop.load()) {
+            BasicProperties p;
+            p.set_delivery_mode(DeliveryMode::DURABLE);
+            vh->basic_publish("dq", &p, "D");
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    vh->delete_queue("dq");
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    stop = true;
+    publisher.join();
+    EXPECT_FALSE(vh->queue_ready("dq"));
+    EXPECT_FALSE(fs::exists(dir + "/dq"));
+}
@@ -0,0 +1,438 @@
+/********************************************************************
+*  test_crash.cpp —— 存储层崩溃一致性：file_io 故障注入 + 模拟掉电
+*
+*  crash_io 接管所有文件写操作，记录每个 inode 上尚未 fdatasync 的写（连同写前内容）。
+*  第 crash_at 次操作时“崩溃”：写只落下随机前缀、fdatasync / rename 不生效，
+*  此后所有写都被丢弃。拆掉 virtual_host 后 power_loss() 对每个文件
+*  保留未同步写的随机前缀（下一条可能写一半），其余按写前内容回滚，再重新打开校验：
+*    · 已确认（when_durable 回调）且未被消费的持久化消息必须恢复，且只出现一次
+*    · 任何消息都不能重复，同一队列内保持发布顺序
+*  open / unlink / ftruncate 等目录项与元数据操作视为立即持久。
+********************************************************************/
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstdlib>
+#include <future>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include "../server/virtual_host.hpp"
+#include "../server/queue_message.hpp"
+#include "../common/file_io.hpp"
+
+using namespace hz_mq;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class crash_io : public file_io {
+public:
+    // match 非空时只有路径包含 match 的操作参与计数（用于瞄准压缩等特定阶段）
+    crash_io(uint64_t crash_at, uint64_t seed, std::string match = {})
+        : __crash_at(crash_at), __rng(seed), __match(std::move(match)) {}
+
+    ~crash_io() override
+    {
+        for (const auto& [_, f] : __files) ::close(f.fd);
+    }
+
+    ssize_t pwrite(int fd, const void* buf, size_t len, off_t pos) override
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        if (__crashed) return static_cast<ssize_t>(len);
+        size_t n = tick(fd_path(fd)) ? tear(len) : len;
+        record(fd, static_cast<const char*>(buf), n, pos);
+        if (n < len) return static_cast<ssize_t>(len);               // 进程已“死”，返回值无所谓
+        return ::pwrite(fd, buf, len, pos);
+    }
+
+    ssize_t write(int fd, const void* buf, size_t len) override
+    {
+        struct stat st {};
+        ::fstat(fd, &st);
+        return pwrite(fd, buf, len, st.st_size);      // 只用于 O_APPEND 文件
+    }
+
+    int fdatasync(int fd) override
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        if (__crashed || tick(fd_path(fd))) return 0;
+        auto it = __files.find(key_of(fd));
+        if (it != __files.end()) it->second.unsynced.clear();
+        return 0;                                     // 写入已由本类追踪，无需真正刷盘
+    }
+
+    int ftruncate(int fd, off_t len) override
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        if (__crashed || tick(fd_path(fd))) return 0;
+        return ::ftruncate(fd, len);
+    }
+
+    int rename(const char* from, const char* to) override
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        if (__crashed || tick(from)) return 0;
+        return ::rename(from, to);
+    }
+
+    bool crashed()
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        return __crashed;
+    }
+
+    uint64_t ops()
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        return __ops;
+    }
+
+    // 掉电：每个文件保留未同步写的随机前缀，下一条写随机长度，其余回滚
+    void power_loss()
+    {
+        std::unique_lock<std::mutex> lock(__mtx);
+        __crashed = true;
+        for (auto& [_, f] : __files) {
+            auto& w = f.unsynced;
+            size_t keep = std::uniform_int_distribution<size_t>(0, w.size())(__rng);
+            for (size_t i = w.size(); i-- > keep; ) {
+                ::pwrite(f.fd, w[i].pre.data(), w[i].pre.size(), w[i].pos);
+                if (w[i].old_size < w[i].pos + static_cast<off_t>(w[i].len))
+                    ::ftruncate(f.fd, std::max(w[i].old_size, w[i].pos + static_cast<off_t>(w[i].pre.size())));
+            }
+            if (keep < w.size()) {
+                size_t n = tear(w[keep].data.size());
+                ::pwrite(f.fd, w[keep].data.data(), n, w[keep].pos);
+            }
+            w.clear();
+        }
+    }
+
+private:
+    struct pending_write {
+        off_t       pos;
+        size_t      len;
+        off_t       old_size;      // 写之前的文件长度
+        std::string pre;           // 写之前 [pos, min(pos + len, old_size)) 的内容
+        std::string data;
+    };
+    struct tracked_file {
+        int                        fd;          // dup 出来的，文件被 rename 后仍能回滚
+        std::vector<pending_write> unsynced;
+    };
+
+    static std::pair<dev_t, ino_t> key_of(int fd)
+    {
+        struct stat st {};
+        ::fstat(fd, &st);
+        return {st.st_dev, st.st_ino};
+    }
+
+    static std::string fd_path(int fd)
+    {
+        std::error_code ec;
+        return fs::read_symlink("/proc/self/fd/" + std::to_string(fd), ec).string();
+    }
+
+    // 计数一次操作；到点即崩溃
+    bool tick(const std::string& path)
+    {
+        if (!__match.empty() && path.find(__match) == std::string::npos) return false;
+        if (++__ops != __crash_at) return false;
+        __crashed = true;
+        return true;
+    }
+
+    size_t tear(size_t len)
+    {
+        return len ? std::uniform_int_distribution<size_t>(0, len - 1)(__rng) : 0;
+    }
+
+    void record(int fd, const char* buf, size_t len, off_t pos)
+    {
+        auto key = key_of(fd);
+        auto it  = __files.find(key);
+        if (it == __files.end()) it = __files.emplace(key, tracked_file{::dup(fd), {}}).first;
+
+        struct stat st {};
+        ::fstat(fd, &st);
+        pending_write w{pos, len, st.st_size, {}, std::string(buf, len)};
+        if (pos < st.st_size) {
+            w.pre.resize(std::min<size_t>(len, static_cast<size_t>(st.st_size - pos)));
+            ssize_t n = ::pread(fd, w.pre.data(), w.pre.size(), pos);
+            w.pre.resize(n > 0 ? static_cast<size_t>(n) : 0);
+        }
+        it->second.unsynced.push_back(std::move(w));
+    }
+
+    std::mutex                                        __mtx;
+    uint64_t                                          __crash_at;
+    uint64_t                                          __ops{0};
+    bool                                              __crashed{false};
+    std::mt19937_64                                   __rng;
+    std::string                                       __match;
+    std::map<std::pair<dev_t, ino_t>, tracked_file>   __files;
+};
+
+// ---------- 工作负载：两个持久化队列交替发布，穿插消费，后台压缩 / 检查点频繁运行 ----------
+struct workload_result {
+    std::set<std::string> confirmed;     // 已回调确认落盘
+    std::set<std::string> consumed;      // 崩溃前已被消费（可能因确认标志未落盘而重新出现）
+};
+
+// fdatasync 返回 EIO（armed 期间）；fail_writes 期间 pwrite 也返回 EIO；其余直通
+class failing_sync_io : public file_io {
+public:
+    ssize_t pwrite(int fd, const void* buf, size_t len, off_t pos) override
+    {
+        if (fail_writes.load()) {
+            errno = EIO;
+            return -1;
+        }
+        return ::pwrite(fd, buf, len, pos);
+    }
+
+    int fdatasync(int fd) override
+    {
+        if (armed.load()) {
+            errno = EIO;
+            return -1;
+        }
+        return ::fdatasync(fd);
+    }
+
+    std::atomic<bool> armed{false};
+    std::atomic<bool> fail_writes{false};
+};
+
+const std::string CRASH_DIR = "./testdata_crash";
+const char*       QUEUES[]  = {"cq0", "cq1"};
+
+virtual_host::options crash_host_options()
+{
+    virtual_host::options opts;
+    opts.commit.window             = std::chrono::microseconds(200);
+    opts.compact.interval          = std::chrono::milliseconds(2);
+    opts.compact.garbage_ratio     = 0.2;
+    opts.compact.max_bytes_per_sec = 0;
+    opts.checkpoint.interval       = std::chrono::milliseconds(5);
+    opts.segment_bytes             = 4096;
+    return opts;
+}
+
+workload_result run_workload(crash_io& io, int messages)
+{
+    workload_result r;
+    std::mutex mtx;
+
+    auto vh = std::make_shared<virtual_host>("crash", CRASH_DIR, CRASH_DIR + "/meta.db",
+                                             crash_host_options());
+    for (const char* q : QUEUES) vh->declare_queue(q, true, false, false, {});
+
+    for (int i = 0; i < messages && !io.crashed(); ++i) {
+        const std::string qname = QUEUES[i % 2];
+        BasicProperties bp;
+        bp.set_id(qname + "-" + std::to_string(100000 + i));
+        bp.set_delivery_mode(DeliveryMode::DURABLE);
+        durable_span span;
+        if (!vh->basic_publish(qname, &bp, std::string(80 + i % 50, 'a' + i % 26), nullptr, &span))
+            continue;
+
+        vh->when_durable(span, [&, id = bp.id()](bool ok) {
+            if (!ok || io.crashed()) return;
+            std::unique_lock<std::mutex> lock(mtx);
+            r.confirmed.insert(id);
+        });
+        if (i % 3 == 2) {
+            if (auto m = vh->basic_consume(qname)) {
+                std::unique_lock<std::mutex> lock(mtx);
+                r.consumed.insert(m->payload().properties().id());
+            }
+        }
+        if (i % 16 == 15) std::this_thread::sleep_for(std::chrono::microseconds(300));
+    }
+    vh.reset();                      // 崩溃后的析构写入一律被丢弃
+    return r;
+}
+
+// 重新打开，核对已确认消息既不丢失也不重复
+void verify_recovered(const workload_result& r, const std::string& context)
+{
+    auto vh = std::make_shared<virtual_host>("crash", CRASH_DIR, CRASH_DIR + "/meta.db",
+                                             crash_host_options());
+    vh->wait_recovered();
+
+    std::set<std::string> seen;
+    for (const char* q : QUEUES) {
+        std::string last;
+        while (auto m = vh->basic_consume(q)) {
+            const std::string& id = m->payload().properties().id();
+            EXPECT_TRUE(seen.insert(id).second) << context << ": duplicated " << id;
+            EXPECT_LT(last, id) << context << ": out of order in " << q;
+            last = id;
+        }
+    }
+    for (const auto& id : r.confirmed) {
+        if (r.consumed.count(id)) continue;
+        EXPECT_TRUE(seen.count(id)) << context << ": lost confirmed message " << id;
+    }
+}
+
+int crash_rounds()
+{
+    const char* v = std::getenv("MQ_CRASH_ROUNDS");
+    return v ? std::atoi(v) : 20;
+}
+
+} // namespace
+
+/* ---------- C1 任意位置崩溃：已确认的持久化消息不丢不重 ---------- */
+TEST(CrashConsistency, RandomCrashPoints)
+{
+    const int messages = 300;
+
+    // 先完整跑一遍，得到操作总数作为崩溃点的取值范围
+    uint64_t total_ops;
+    {
+        fs::remove_all(CRASH_DIR);
+        crash_io io(UINT64_MAX, 0);
+        set_file_io(&io);
+        run_workload(io, messages);
+        set_file_io(nullptr);
+        total_ops = io.ops();
+    }
+    ASSERT_GT(total_ops, 0u);
+
+    std::mt19937_64 rng(20250101);
+    for (int round = 0; round < crash_rounds(); ++round) {
+        fs::remove_all(CRASH_DIR);
+        uint64_t crash_at = rng() % total_ops + 1;
+        uint64_t seed     = rng();
+
+        crash_io io(crash_at, seed);
+        set_file_io(&io);
+        auto r = run_workload(io, messages);
+        io.power_loss();
+        set_file_io(nullptr);
+
+        verify_recovered(r, "round " + std::to_string(round) + " crash_at " + std::to_string(crash_at));
+        if (HasFailure()) break;
+    }
+    fs::remove_all(CRASH_DIR);
+}
+
+/* ---------- C2 压缩过程中崩溃：拷贝、fdatasync、rename 任一步 ---------- */
+TEST(CrashConsistency, CrashDuringCompaction)
+{
+    std::mt19937_64 rng(7);
+    for (int round = 0; round < crash_rounds(); ++round) {
+        fs::remove_all(CRASH_DIR);
+        crash_io io(rng() % 6 + 1, rng(), ".compact");
+        set_file_io(&io);
+        auto r = run_workload(io, 400);
+        io.power_loss();
+        set_file_io(nullptr);
+
+        verify_recovered(r, "compaction round " + std::to_string(round));
+        if (HasFailure()) break;
+    }
+    fs::remove_all(CRASH_DIR);
+}
+
+/* ---------- C3 fdatasync 失败：该批的 when_durable 回调收到 false，恢复后的批照常确认 ---------- */
+TEST(CrashConsistency, FailedSyncNotConfirmed)
+{
+    fs::remove_all(CRASH_DIR);
+    failing_sync_io io;
+    set_file_io(&io);
+    {
+        auto vh = std::make_shared<virtual_host>("crash", CRASH_DIR, CRASH_DIR + "/meta.db",
+                                                 crash_host_options());
+        ASSERT_TRUE(vh->declare_queue("sq", true, false, false, {}));
+
+        auto publish = [&](const std::string& id, durable_span& span) {
+            BasicProperties bp;
+            bp.set_id(id);
+            bp.set_delivery_mode(DeliveryMode::DURABLE);
+            EXPECT_TRUE(vh->basic_publish("sq", &bp, "payload-" + id, nullptr, &span));
+            EXPECT_FALSE(span.empty());
+            auto done = std::make_shared<std::promise<bool>>();
+            vh->when_durable(span, [done](bool ok) { done->set_value(ok); });
+            return done->get_future().get();
+        };
+
+        durable_span lost, kept;
+        io.armed = true;
+        EXPECT_FALSE(publish("lost", lost));
+        io.armed = false;
+        EXPECT_TRUE(publish("kept", kept));
+
+        auto query = [&](const durable_span& span) {
+            std::promise<bool> done;
+            vh->when_durable(span, [&done](bool ok) { done.set_value(ok); });
+            return done.get_future().get();
+        };
+        EXPECT_FALSE(query(lost));                   // 已提交的失败批次：事后查询仍是 false
+        EXPECT_TRUE(query(kept));
+        EXPECT_FALSE(query(durable_span{lost.first, kept.last}));   // 跨批区间含失败批
+        EXPECT_TRUE(query(durable_span{}));          // 没有持久化写入：立即成功
+    }
+    set_file_io(nullptr);
+    fs::remove_all(CRASH_DIR);
+}
+
+/* ---------- C4 批提交失败：这批持久化消息从队列摘除，下一批原位重写，段内不留空洞 ---------- */
+TEST(CrashConsistency, FailedBatchDroppedAndRewritten)
+{
+    fs::remove_all(CRASH_DIR);
+    failing_sync_io io;
+    set_file_io(&io);
+    {
+        group_commit::options opts;
+        opts.window = std::chrono::microseconds(200);
+        auto gc = std::make_shared<group_commit>(opts);
+        auto qm = std::make_shared<queue_message>(CRASH_DIR, "fq", gc);
+
+        auto put = [&](const std::string& id) {
+            BasicProperties bp;
+            bp.set_id(id);
+            bp.set_delivery_mode(DeliveryMode::DURABLE);
+            EXPECT_TRUE(qm->insert(&bp, "payload-" + id, true));
+            return gc->sync();
+        };
+        EXPECT_TRUE(put("before"));
+        io.armed = true;
+        EXPECT_FALSE(put("lost1"));                  // 写入成功、fdatasync 失败
+        io.fail_writes = true;
+        EXPECT_FALSE(put("lost2"));                  // 上一批失败的数据随这批重写，写入即失败
+        io.fail_writes = false;
+        io.armed = false;
+        EXPECT_TRUE(put("after"));
+
+        // 发布方收到失败会重发：失败批次的消息不再留在队列里
+        EXPECT_EQ(qm->getable_count(), 2u);
+        EXPECT_FALSE(qm->remove("lost1"));
+        EXPECT_FALSE(qm->remove("lost2"));
+    }
+    set_file_io(nullptr);
+
+    // 重启：失败区间已按无效记录重写，其后成功落盘的消息不会被当作残缺尾部截掉
+    auto qm = std::make_shared<queue_message>(CRASH_DIR, "fq");
+    EXPECT_EQ(qm->recovery(), 2u);
+    Message m;
+    ASSERT_TRUE(qm->pop_front(m));
+    EXPECT_EQ(m.payload().properties().id(), "before");
+    ASSERT_TRUE(qm->pop_front(m));
+    EXPECT_EQ(m.payload().properties().id(), "after");
+    EXPECT_FALSE(qm->pop_front(m));
+    qm->destroy();
+    fs::remove_all(CRASH_DIR);
+}
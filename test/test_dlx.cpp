@@ -0,0 +1,167 @@
+/********************************************************************
+*  test_dlx.cpp —— 死信交换机：x-dead-letter-exchange / x-dead-letter-routing-key
+********************************************************************/
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <thread>
+#include "../server/virtual_host.hpp"
+#include "../server/queue_message.hpp"
+
+using namespace hz_mq;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class DlxFixture : public ::testing::Test {
+protected:
+    void SetUp()    override { fs::remove_all(dir); }
+    void TearDown() override { fs::remove_all(dir); }
+
+    virtual_host::ptr open_host()
+    {
+        return std::make_shared<virtual_host>("dlx", dir, dir + "/meta.db");
+    }
+
+    // 死信交换机 dlx（direct）+ 死信队列 dlq，绑定键 dead
+    static void declare_dlq(const virtual_host::ptr& vh)
+    {
+        ASSERT_TRUE(vh->declare_exchange("dlx", ExchangeType::DIRECT, false, false, {}));
+        ASSERT_TRUE(vh->declare_queue("dlq", false, false, false, {}));
+        ASSERT_TRUE(vh->bind("dlx", "dlq", "dead"));
+    }
+
+    static void sleep_ms(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+    const std::string dir = "./testdata_dlx";
+};
+
+BasicProperties props(const std::string& id, uint64_t expiration = 0)
+{
+    BasicProperties bp;
+    bp.set_id(id);
+    bp.set_expiration(expiration);
+    return bp;
+}
+
+} // namespace
+
+/* ---------- D1 reject(不退回)：经死信交换机改用 x-dead-letter-routing-key 投递，并回调 ---------- */
+TEST_F(DlxFixture, RejectedRoutedWithReason)
+{
+    auto vh = open_host();
+    std::vector<std::string> ready;
+    vh->set_ready_callback([&](const std::string& q) { ready.push_back(q); });
+    declare_dlq(vh);
+    ASSERT_TRUE(vh->declare_queue("work", false, false, false,
+                                  {{DEAD_LETTER_EXCHANGE_ARG, "dlx"},
+                                   {DEAD_LETTER_ROUTING_KEY_ARG, "dead"}}));
+    ASSERT_TRUE(vh->declare_queue("plain", false, false, false, {}));
+
+    auto a = props("a"), b = props("b");
+    ASSERT_TRUE(vh->basic_publish("work", &a, "A"));
+    ASSERT_TRUE(vh->basic_publish("plain", &b, "B"));
+
+    uint64_t inflight = 0;
+    ASSERT_TRUE(vh->basic_get("work", inflight));
+    EXPECT_TRUE(vh->basic_reject("work", inflight, false));
+    EXPECT_FALSE(vh->basic_reject("work", inflight, false));        // 凭据只能用一次
+    ASSERT_EQ(ready, std::vector<std::string>{"dlq"});
+
+    auto m = vh->basic_consume("dlq");
+    ASSERT_TRUE(m);
+    const auto& p = m->payload().properties();
+    EXPECT_EQ(p.id(), "a");
+    EXPECT_EQ(m->payload().body(), "A");
+    EXPECT_EQ(p.routing_key(), "dead");
+    EXPECT_EQ(p.death_reason(), DEATH_REJECTED);
+    EXPECT_EQ(p.death_queue(), "work");
+    EXPECT_EQ(p.death_count(), 1u);
+
+    // 未配置死信交换机：照旧直接丢弃
+    ASSERT_TRUE(vh->basic_get("plain", inflight));
+    EXPECT_TRUE(vh->basic_reject("plain", inflight, false));
+    EXPECT_FALSE(vh->basic_consume("plain"));
+    EXPECT_EQ(ready.size(), 1u);
+}
+
+/* ---------- D2 过期：时间轮删除的与出队时跳过的队首都转投，死信不再带原 TTL ---------- */
+TEST_F(DlxFixture, ExpiredRoutedAndTtlCleared)
+{
+    auto vh = open_host();
+    declare_dlq(vh);
+    // 没有死信路由键：沿用原 routing_key，因此用 dead 发布到 work
+    ASSERT_TRUE(vh->declare_exchange("in", ExchangeType::DIRECT, false, false, {}));
+    ASSERT_TRUE(vh->declare_queue("work", false, false, false,
+                                  {{DEAD_LETTER_EXCHANGE_ARG, "dlx"}}));
+    ASSERT_TRUE(vh->bind("in", "work", "dead"));
+
+    auto wheel = props("wheel", 10), head = props("head", 30), keep = props("keep");
+    for (auto* bp : {&wheel, &head, &keep}) ASSERT_TRUE(vh->publish_ex("in", "dead", bp, bp->id()));
+
+    sleep_ms(20);
+    EXPECT_EQ(vh->expire_tick(), 1u);                       // wheel：时间轮到期
+    sleep_ms(20);
+    auto m = vh->basic_consume("work");                     // head：出队时才发现过期
+    ASSERT_TRUE(m);
+    EXPECT_EQ(m->payload().properties().id(), "keep");
+
+    for (const char* id : {"wheel", "head"}) {
+        auto d = vh->basic_consume("dlq");
+        ASSERT_TRUE(d);
+        const auto& p = d->payload().properties();
+        EXPECT_EQ(p.id(), id);
+        EXPECT_EQ(d->payload().body(), id);
+        EXPECT_EQ(p.death_reason(), DEATH_EXPIRED);
+        EXPECT_EQ(p.expiration(), 0u);
+        EXPECT_EQ(p.expire_at(), 0);
+    }
+    EXPECT_FALSE(vh->basic_consume("dlq"));
+    EXPECT_EQ(vh->expire_tick(), 0u);                       // head 的定时器已失效
+}
+
+/* ---------- D3 lazy 队列：换出到段文件的消息体过期时读回，完整转投 ---------- */
+TEST_F(DlxFixture, LazyExpiredBodiesFetched)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("dlq", false, false, false, {}));
+    ASSERT_TRUE(vh->declare_queue("lazy", false, false, false,
+                                  {{QUEUE_MODE_ARG, QUEUE_MODE_LAZY},
+                                   {MESSAGE_TTL_ARG, "10"},
+                                   {DEAD_LETTER_EXCHANGE_ARG, ""},
+                                   {DEAD_LETTER_ROUTING_KEY_ARG, "dlq"}}));
+
+    const size_t n = queue_message::LAZY_WINDOW + 100;
+    for (size_t i = 0; i < n; ++i) {
+        auto bp = props("m" + std::to_string(i));
+        ASSERT_TRUE(vh->basic_publish("lazy", &bp, "body-" + std::to_string(i)));
+    }
+    sleep_ms(30);
+    EXPECT_EQ(vh->expire_tick(), n);
+    EXPECT_FALSE(vh->basic_consume("lazy"));
+    for (size_t i = 0; i < n; ++i) {
+        auto m = vh->basic_consume("dlq");
+        ASSERT_TRUE(m) << i;
+        EXPECT_EQ(m->payload().body(), "body-" + std::to_string(i));
+    }
+}
+
+/* ---------- D4 死信回到自身（成环）：转投 MAX_DEAD_LETTER_HOPS 次后丢弃 ---------- */
+TEST_F(DlxFixture, CycleBoundedByHops)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("loop", false, false, false,
+                                  {{MESSAGE_TTL_ARG, "1"}, {DEAD_LETTER_EXCHANGE_ARG, ""}}));
+    auto bp = props("spin");
+    ASSERT_TRUE(vh->basic_publish("loop", &bp, "S"));
+
+    size_t expired = 0;
+    for (int i = 0; i < 200 && expired <= MAX_DEAD_LETTER_HOPS; ++i) {
+        sleep_ms(12);
+        expired += vh->expire_tick();
+    }
+    EXPECT_EQ(expired, MAX_DEAD_LETTER_HOPS + 1u);
+    sleep_ms(12);
+    EXPECT_EQ(vh->expire_tick(), 0u);
+    EXPECT_FALSE(vh->basic_consume("loop"));
+}
@@ -0,0 +1,233 @@
+/********************************************************************
+*  test_ingress.cpp —— mpsc_ring 与 x-ingress-ring（无锁入队环）
+********************************************************************/
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+#include "../server/mpsc_ring.hpp"
+#include "../server/queue_message.hpp"
+
+using namespace hz_mq;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class IngressFixture : public ::testing::Test {
+protected:
+    void SetUp()    override { fs::remove_all(dir); }
+    void TearDown() override { fs::remove_all(dir); }
+
+    const std::string dir = "./testdata_ingress";
+};
+
+BasicProperties props(const std::string& id, uint32_t priority = 0)
+{
+    BasicProperties bp;
+    bp.set_id(id);
+    bp.set_priority(priority);
+    return bp;
+}
+
+std::vector<std::string> drain_ids(queue_message& qm)
+{
+    std::vector<std::string> ids;
+    while (auto m = qm.pop_front()) ids.push_back(m->payload().properties().id());
+    return ids;
+}
+
+} // namespace
+
+/* ---------- I1 单线程：容量取整为 2 的幂，满了拒绝，按序取出，绕圈后照常使用 ---------- */
+TEST(MpscRing, OrderFullAndWraparound)
+{
+    mpsc_ring<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 4u);
+
+    int next = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.try_push([&](int& v) { v = next++; }));
+        EXPECT_FALSE(ring.try_push([](int&) { FAIL() << "full ring must not call fill"; }));
+        EXPECT_EQ(ring.size(), 4u);
+
+        std::vector<int> got;
+        EXPECT_EQ(ring.drain([&](int& v) { got.push_back(v); }), 4u);
+        EXPECT_EQ(got, (std::vector<int>{next - 4, next - 3, next - 2, next - 1}));
+        EXPECT_EQ(ring.size(), 0u);
+    }
+}
+
+/* ---------- I2 多生产者并发写、消费者并发取：不丢不重，同一生产者内保持顺序 ---------- */
+TEST(MpscRing, ConcurrentProducersKeepPerProducerOrder)
+{
+    constexpr uint64_t PRODUCERS = 4, PER = 20000;
+    mpsc_ring<uint64_t> ring(64);
+    std::atomic<uint64_t> running{PRODUCERS};
+
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (uint64_t i = 0; i < PER; ++i)
+                while (!ring.try_push([&](uint64_t& v) { v = p * PER + i; })) std::this_thread::yield();
+            --running;
+        });
+    }
+    std::vector<uint64_t> last(PRODUCERS, UINT64_MAX);
+    uint64_t total = 0, misordered = 0;
+    auto take = [&](uint64_t& v) {
+        uint64_t p = v / PER, i = v % PER;
+        if (last[p] != UINT64_MAX && i != last[p] + 1) ++misordered;
+        if (last[p] == UINT64_MAX && i != 0) ++misordered;
+        last[p] = i;
+        ++total;
+    };
+    while (running.load() > 0) {
+        if (!ring.drain(take)) std::this_thread::yield();
+    }
+    for (auto& t : producers) t.join();
+    ring.drain(take);
+
+    EXPECT_EQ(total, PRODUCERS * PER);
+    EXPECT_EQ(misordered, 0u);
+}
+
+/* ---------- I3 队列开启 ingress：环满退回加锁路径仍保持发布顺序；持久化消息绕过环 ---------- */
+TEST_F(IngressFixture, FifoAcrossRingAndLockedPath)
+{
+    queue_message qm(dir, "ing", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                     {{INGRESS_RING_ARG, "4"}});
+    std::vector<std::string> want;
+    for (int i = 0; i < 10; ++i) {                            // 前 4 条进环，第 5 条起环满走加锁路径
+        auto bp = props("m" + std::to_string(i));
+        ASSERT_TRUE(qm.insert(&bp, "body", false));
+        want.push_back(bp.id());
+    }
+    EXPECT_EQ(qm.getable_count(), 10u);
+    EXPECT_EQ(qm.front()->payload().body(), "body");
+    EXPECT_EQ(drain_ids(qm), want);
+
+    auto anon = BasicProperties();                            // 无 id：写入环时补发
+    ASSERT_TRUE(qm.insert(&anon, "x", false));
+    auto m = qm.pop_front();
+    ASSERT_TRUE(m);
+    EXPECT_FALSE(m->payload().properties().id().empty());
+
+    queue_message durable(dir, "ingd", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                          {{INGRESS_RING_ARG, "4"}});
+    auto d = props("d");
+    d.set_delivery_mode(DeliveryMode::DURABLE);
+    ASSERT_TRUE(durable.insert(&d, "persisted", true));
+    EXPECT_TRUE(fs::exists(dir + "/ingd"));                   // 同步落盘，没有经过环
+}
+
+/* ---------- I4 并入时处理长度上限与优先级；reject-publish 队列不走环，仍同步拒收 ---------- */
+TEST_F(IngressFixture, LimitsAppliedWhenDrained)
+{
+    queue_message capped(dir, "cap", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                         {{INGRESS_RING_ARG, "16"}, {MAX_LENGTH_ARG, "3"}, {MAX_PRIORITY_ARG, "9"}});
+    auto lo0 = props("lo0", 1), lo1 = props("lo1", 1), hi = props("hi", 9), lo2 = props("lo2", 1);
+    for (auto* bp : {&lo0, &lo1, &hi, &lo2}) ASSERT_TRUE(capped.insert(bp, "p", false));
+    EXPECT_EQ(drain_ids(capped), (std::vector<std::string>{"hi", "lo1", "lo2"}));
+
+    queue_message strict(dir, "rej", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                         {{INGRESS_RING_ARG, "16"}, {MAX_LENGTH_ARG, "1"},
+                          {OVERFLOW_ARG, OVERFLOW_REJECT_PUBLISH}});
+    auto a = props("a"), b = props("b");
+    bool full = false;
+    ASSERT_TRUE(strict.insert(&a, "A", false, &full));
+    EXPECT_FALSE(strict.insert(&b, "B", false, &full));
+    EXPECT_TRUE(full);
+}
+
+/* ---------- I5 多个发布线程无锁写入、一个消费线程出队：条数一致，单个发布方内有序 ---------- */
+TEST_F(IngressFixture, ConcurrentPublishersOneConsumer)
+{
+    constexpr size_t PRODUCERS = 4, PER = 5000;
+    queue_message qm(dir, "mp", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                     {{INGRESS_RING_ARG, "256"}});
+    std::atomic<size_t> running{PRODUCERS};
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (size_t i = 0; i < PER; ++i) {
+                auto bp = props(std::to_string(p) + ":" + std::to_string(i));
+                EXPECT_TRUE(qm.insert(&bp, "c", false));
+            }
+            --running;
+        });
+    }
+    std::vector<long> last(PRODUCERS, -1);
+    size_t got = 0, misordered = 0;
+    for (;;) {
+        bool done = running.load() == 0;
+        auto m = qm.pop_front();
+        if (!m) {
+            if (done) break;
+            std::this_thread::yield();
+            continue;
+        }
+        const std::string& id = m->payload().properties().id();
+        size_t colon = id.find(':');
+        size_t p = std::stoul(id.substr(0, colon));
+        long   i = std::stol(id.substr(colon + 1));
+        if (i != last[p] + 1) ++misordered;
+        last[p] = i;
+        ++got;
+    }
+    for (auto& t : producers) t.join();
+    EXPECT_EQ(got, PRODUCERS * PER);
+    EXPECT_EQ(misordered, 0u);
+    EXPECT_EQ(qm.getable_count(), 0u);
+}
+
+/* ---------- I6 drain 不等还在写入的槽位，也不越过它：发布之后下一次 drain 按序取出 ---------- */
+TEST(MpscRing, DrainStopsAtUnpublishedSlot)
+{
+    mpsc_ring<int> ring(8);
+    std::atomic<bool> claimed{false}, release{false};
+    std::thread slow([&] {
+        ring.try_push([&](int& v) {
+            claimed = true;
+            while (!release) std::this_thread::yield();
+            v = 1;
+        });
+    });
+    while (!claimed) std::this_thread::yield();
+    EXPECT_TRUE(ring.try_push([](int& v) { v = 2; }));      // 后占位的先发布
+
+    std::vector<int> got;
+    auto take = [&](int& v) { got.push_back(v); };
+    EXPECT_EQ(ring.drain(take), 0u);
+    EXPECT_EQ(ring.size(), 2u);
+    release = true;
+    ring.wait_published();
+    slow.join();
+    EXPECT_EQ(ring.drain(take), 2u);
+    EXPECT_EQ(got, (std::vector<int>{1, 2}));
+}
+
+/* ---------- I7 删除队列与无锁发布并发：destroy() 返回后环里不再有新写入 ---------- */
+TEST_F(IngressFixture, DestroyFencesInflightPushes)
+{
+    auto qm = std::make_shared<queue_message>(dir, "gone", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                                              queue_message::args{{INGRESS_RING_ARG, "64"}});
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&] {
+            while (!stop) {
+                auto bp = props("x");
+                qm->insert(&bp, "b", false);
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    qm->destroy();
+    EXPECT_EQ(qm->getable_count(), 0u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    stop = true;
+    for (auto& t : producers) t.join();
+    EXPECT_EQ(qm->getable_count(), 0u);
+    EXPECT_FALSE(qm->pop_front());
+}
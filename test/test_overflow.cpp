@@ -0,0 +1,152 @@
+/********************************************************************
+*  test_overflow.cpp —— 队列长度上限：x-max-length / x-max-length-bytes + x-overflow
+********************************************************************/
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "../server/virtual_host.hpp"
+#include "../server/queue_message.hpp"
+
+using namespace hz_mq;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class OverflowFixture : public ::testing::Test {
+protected:
+    void SetUp()    override { fs::remove_all(dir); }
+    void TearDown() override { fs::remove_all(dir); }
+
+    virtual_host::ptr open_host()
+    {
+        return std::make_shared<virtual_host>("ovf", dir, dir + "/meta.db");
+    }
+
+    const std::string dir = "./testdata_overflow";
+};
+
+BasicProperties props(const std::string& id, uint32_t priority = 0)
+{
+    BasicProperties bp;
+    bp.set_id(id);
+    bp.set_priority(priority);
+    return bp;
+}
+
+} // namespace
+
+/* ---------- O1 drop-head：条数 / 字节超限时挤出最旧的；字节计数随投递、退回、确认变化 ---------- */
+TEST_F(OverflowFixture, DropHeadByCountAndBytes)
+{
+    queue_message byc(dir, "byc", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, {{MAX_LENGTH_ARG, "3"}});
+    for (int i = 0; i < 5; ++i) {
+        auto bp = props("c" + std::to_string(i));
+        ASSERT_TRUE(byc.insert(&bp, "xx", false));
+    }
+    EXPECT_EQ(byc.getable_count(), 3u);
+    EXPECT_EQ(byc.front()->payload().properties().id(), "c2");
+
+    queue_message byb(dir, "byb", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                      {{MAX_LENGTH_BYTES_ARG, "10"}});
+    for (int i = 0; i < 4; ++i) {
+        auto bp = props("b" + std::to_string(i));
+        ASSERT_TRUE(byb.insert(&bp, "1234", false));
+    }
+    EXPECT_EQ(byb.getable_count(), 2u);
+    EXPECT_EQ(byb.getable_bytes(), 8u);
+
+    uint64_t inflight = 0;
+    auto m = byb.deliver(inflight);                        // 未确认的不计入上限
+    ASSERT_TRUE(m);
+    EXPECT_EQ(m->payload().properties().id(), "b2");
+    EXPECT_EQ(byb.getable_bytes(), 4u);
+    auto extra = props("b4");
+    ASSERT_TRUE(byb.insert(&extra, "1234", false));
+    EXPECT_EQ(byb.getable_count(), 2u);
+    EXPECT_TRUE(byb.requeue(inflight));                    // 退回允许暂时超出
+    EXPECT_EQ(byb.getable_bytes(), 12u);
+    byb.pop_front();
+    EXPECT_EQ(byb.getable_bytes(), 8u);
+
+    auto huge = props("huge");                             // 单条就超出字节上限：清空也放不下
+    EXPECT_FALSE(byb.insert(&huge, std::string(11, 'h'), false));
+    EXPECT_EQ(byb.getable_count(), 0u);
+    EXPECT_EQ(byb.getable_bytes(), 0u);
+}
+
+/* ---------- O2 优先级队列：drop-head 先挤出最低优先级层最旧的消息 ---------- */
+TEST_F(OverflowFixture, DropHeadEvictsLowestPriority)
+{
+    queue_message qm(dir, "pq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                     {{MAX_PRIORITY_ARG, "9"}, {MAX_LENGTH_ARG, "3"}});
+    auto hi = props("hi", 9), lo0 = props("lo0", 1), lo1 = props("lo1", 1), mid = props("mid", 5);
+    for (auto* bp : {&hi, &lo0, &lo1, &mid}) ASSERT_TRUE(qm.insert(bp, "p", false));
+
+    std::vector<std::string> order;
+    while (auto m = qm.pop_front()) order.push_back(m->payload().properties().id());
+    EXPECT_EQ(order, (std::vector<std::string>{"hi", "mid", "lo1"}));
+}
+
+/* ---------- O3 reject-publish：队满时发布失败并回填 full，消费后恢复；扇出中任一队满即否定 ---------- */
+TEST_F(OverflowFixture, RejectPublishGivesBackpressure)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("rq", false, false, false,
+                                  {{MAX_LENGTH_ARG, "2"}, {OVERFLOW_ARG, OVERFLOW_REJECT_PUBLISH}}));
+    for (const char* id : {"r0", "r1"}) {
+        auto bp = props(id);
+        ASSERT_TRUE(vh->basic_publish("rq", &bp, "R"));
+    }
+    bool full = false;
+    auto r2 = props("r2");
+    EXPECT_FALSE(vh->basic_publish("rq", &r2, "R", &full));
+    EXPECT_TRUE(full);
+
+    auto m = vh->basic_consume("rq");
+    ASSERT_TRUE(m);
+    EXPECT_EQ(m->payload().properties().id(), "r0");       // 已入队的消息不受影响
+    full = false;
+    auto r3 = props("r3");
+    EXPECT_TRUE(vh->basic_publish("rq", &r3, "R", &full));
+    EXPECT_FALSE(full);
+
+    ASSERT_TRUE(vh->declare_queue("open", false, false, false, {}));
+    ASSERT_TRUE(vh->declare_exchange("fan", ExchangeType::FANOUT, false, false, {}));
+    ASSERT_TRUE(vh->bind("fan", "rq", ""));
+    ASSERT_TRUE(vh->bind("fan", "open", ""));
+    EXPECT_FALSE(vh->publish_ex("fan", "", nullptr, "F"));
+    EXPECT_TRUE(vh->basic_consume("open"));                 // 未满的队列照常入队
+}
+
+/* ---------- O4 超长的死信：drop-head 挤出的与 reject-publish-dlx 拒收的都以 maxlen 转投 ---------- */
+TEST_F(OverflowFixture, OverflowDeadLettered)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("dlq", false, false, false, {}));
+    ASSERT_TRUE(vh->declare_queue("head", false, false, false,
+                                  {{MAX_LENGTH_ARG, "1"},
+                                   {DEAD_LETTER_EXCHANGE_ARG, ""},
+                                   {DEAD_LETTER_ROUTING_KEY_ARG, "dlq"}}));
+    ASSERT_TRUE(vh->declare_queue("rej", false, false, false,
+                                  {{MAX_LENGTH_ARG, "1"},
+                                   {OVERFLOW_ARG, OVERFLOW_REJECT_PUBLISH_DLX},
+                                   {DEAD_LETTER_EXCHANGE_ARG, ""},
+                                   {DEAD_LETTER_ROUTING_KEY_ARG, "dlq"}}));
+
+    auto h0 = props("h0"), h1 = props("h1"), j0 = props("j0"), j1 = props("j1");
+    ASSERT_TRUE(vh->basic_publish("head", &h0, "H0"));
+    ASSERT_TRUE(vh->basic_publish("head", &h1, "H1"));     // 挤出 h0
+    ASSERT_TRUE(vh->basic_publish("rej", &j0, "J0"));
+    EXPECT_FALSE(vh->basic_publish("rej", &j1, "J1"));     // 拒收 j1
+
+    for (auto [id, body] : {std::pair{"h0", "H0"}, std::pair{"j1", "J1"}}) {
+        auto m = vh->basic_consume("dlq");
+        ASSERT_TRUE(m);
+        EXPECT_EQ(m->payload().properties().id(), id);
+        EXPECT_EQ(m->payload().body(), body);
+        EXPECT_EQ(m->payload().properties().death_reason(), DEATH_MAXLEN);
+    }
+    EXPECT_FALSE(vh->basic_consume("dlq"));
+    EXPECT_EQ(vh->basic_consume("head")->payload().properties().id(), "h1");
+    EXPECT_EQ(vh->basic_consume("rej")->payload().properties().id(), "j0");
+}
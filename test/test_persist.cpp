@@ -0,0 +1,1070 @@
+/********************************************************************
+*  test_persist.cpp —— 功能 4：消息持久化（段日志 / 恢复）测试
+********************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../server/queue_message.hpp"
+#include "../server/segment_log.hpp"
+#include "../server/virtual_host.hpp"
+#include "../server/storage_io.hpp"
+#include "../common/meta_store.hpp"
+#include "../common/compress.hpp"
+#include "../common/crc32c.hpp"
+#include "../common/metrics.hpp"
+#include "../common/file_io.hpp"
+
+using namespace hz_mq;
+
+namespace fs = std::filesystem;
+
+class PersistFixture : public ::testing::Test {
+protected:
+    void SetUp()    override { fs::remove_all(dir); }
+    void TearDown() override { fs::remove_all(dir); }
+
+    static BasicProperties durable_props(const std::string& id)
+    {
+        BasicProperties bp;
+        bp.set_id(id);
+        bp.set_routing_key("pq");
+        bp.set_delivery_mode(DeliveryMode::DURABLE);
+        return bp;
+    }
+
+    const std::string dir = "./testdata_persist";
+};
+
+/* ---------- P1 持久化消息重启后恢复，顺序不变 ---------- */
+TEST_F(PersistFixture, RecoverInOrder)
+{
+    {
+        queue_message qm(dir, "pq");
+        for (int i = 0; i < 3; ++i) {
+            auto bp = durable_props("m" + std::to_string(i));
+            ASSERT_TRUE(qm.insert(&bp, "body" + std::to_string(i), true));
+        }
+    }
+
+    queue_message qm(dir, "pq");
+    qm.recovery();
+    ASSERT_EQ(qm.getable_count(), 3u);
+    EXPECT_EQ(qm.front()->payload().body(), "body0");
+    EXPECT_EQ(qm.front()->payload().properties().id(), "m0");
+}
+
+/* ---------- P2 已删除(ack)的消息不再恢复 ---------- */
+TEST_F(PersistFixture, RemovedNotRecovered)
+{
+    {
+        queue_message qm(dir, "pq");
+        auto b1 = durable_props("a"); qm.insert(&b1, "A", true);
+        auto b2 = durable_props("b"); qm.insert(&b2, "B", true);
+        qm.remove("a");
+    }
+
+    queue_message qm(dir, "pq");
+    qm.recovery();
+    ASSERT_EQ(qm.getable_count(), 1u);
+    EXPECT_EQ(qm.front()->payload().body(), "B");
+}
+
+/* ---------- P3 非持久化消息 / 非持久队列不落盘 ---------- */
+TEST_F(PersistFixture, TransientNotPersisted)
+{
+    {
+        queue_message qm(dir, "pq");
+        BasicProperties bp; bp.set_routing_key("pq");          // UNDURABLE
+        qm.insert(&bp, "transient", true);
+        auto db = durable_props("x");
+        qm.insert(&db, "queue-not-durable", false);
+    }
+    queue_message qm(dir, "pq");
+    qm.recovery();
+    EXPECT_EQ(qm.getable_count(), 0u);
+}
+
+/* ---------- P4 段滚动 + offset/length 回填 + 残缺尾记录截断 ---------- */
+TEST_F(PersistFixture, SegmentRollAndTornTail)
+{
+    {
+        segment_log log(dir + "/seg", 256);
+        ASSERT_TRUE(log.open());
+        for (int i = 0; i < 20; ++i) {
+            Message m;
+            m.mutable_payload()->set_body(std::string(40, 'a' + i));
+            ASSERT_TRUE(log.append(m));
+            EXPECT_GT(m.length(), 0u);
+            Message back; back.set_offset(m.offset()); back.set_length(m.length());
+            ASSERT_TRUE(log.read(back));
+            EXPECT_EQ(back.payload().body(), m.payload().body());
+        }
+        EXPECT_GT(log.segment_count(), 1u);
+    }
+
+    // 模拟写到一半崩溃：在最后一个段尾部追加半条记录
+    std::string last;
+    for (const auto& e : fs::directory_iterator(dir + "/seg"))
+        if (last.empty() || e.path().string() > last) last = e.path().string();
+    auto good_size = fs::file_size(last);
+    {
+        FILE* f = std::fopen(last.c_str(), "ab");
+        const char torn[5] = {100, 0, 0, 0, 1};
+        std::fwrite(torn, 1, sizeof torn, f);
+        std::fclose(f);
+    }
+
+    segment_log log(dir + "/seg", 256);
+    ASSERT_TRUE(log.open());
+    EXPECT_EQ(log.recover().size(), 20u);
+    EXPECT_EQ(fs::file_size(last), good_size);
+}
+
+/* ---------- P5 group commit：批量落盘后回调，重启可恢复 ---------- */
+TEST_F(PersistFixture, GroupCommitBatch)
+{
+    group_commit::options opts;
+    opts.window = std::chrono::milliseconds(20);
+    auto gc = std::make_shared<group_commit>(opts);
+
+    std::atomic<int> acked{0};
+    {
+        queue_message qm(dir, "pq", gc);
+        for (int i = 0; i < 50; ++i) {
+            auto bp = durable_props("g" + std::to_string(i));
+            ASSERT_TRUE(qm.insert(&bp, "G", true));
+            gc->when_durable(gc->submitted(), [&acked](bool ok) { if (ok) ++acked; });
+        }
+        EXPECT_TRUE(gc->sync());
+        EXPECT_EQ(acked.load(), 50);
+    }
+
+    queue_message qm(dir, "pq");
+    qm.recovery();
+    EXPECT_EQ(qm.getable_count(), 50u);
+    EXPECT_GE(metrics::instance().get("group_commit.batch_appends").max(), 2u);
+}
+
+/* ---------- P6 压缩：整段删除 / 重写后 offset 修正，重启结果一致 ---------- */
+TEST_F(PersistFixture, CompactSegments)
+{
+    auto total = [&] {
+        uint64_t n = 0;
+        for (const auto& e : fs::directory_iterator(dir + "/pq")) n += e.file_size();
+        return n;
+    };
+
+    {
+        queue_message qm(dir, "pq", nullptr, 512);
+        for (int i = 0; i < 60; ++i) {
+            auto bp = durable_props("c" + std::to_string(i));
+            ASSERT_TRUE(qm.insert(&bp, std::string(30, 'x'), true));
+        }
+        for (int i = 0; i < 40; ++i) qm.remove("");       // 前段全部确认
+        for (int i = 41; i < 60; i += 2) qm.remove("c" + std::to_string(i));
+
+        uint64_t before = total();
+        uint64_t reclaimed = qm.compact(0.3, nullptr);
+        EXPECT_GT(reclaimed, 0u);
+        EXPECT_EQ(total(), before - reclaimed);
+
+        // 被搬移的消息仍能按新 offset 正确删除
+        qm.remove("c42");
+        EXPECT_EQ(qm.getable_count(), 9u);
+    }
+
+    queue_message qm(dir, "pq");
+    qm.recovery();
+    ASSERT_EQ(qm.getable_count(), 9u);
+    EXPECT_EQ(qm.front()->payload().properties().id(), "c40");
+}
+
+/* ---------- P7 元数据：交换机 / 队列 / 绑定重启后恢复 ---------- */
+TEST_F(PersistFixture, TopologyRecovered)
+{
+    const std::string db = dir + "/meta.db";
+    {
+        virtual_host vh("vh", dir, db);
+        ASSERT_TRUE(vh.declare_exchange("ex_d", ExchangeType::TOPIC, true, false, {{"k", "v"}}));
+        ASSERT_TRUE(vh.declare_exchange("ex_t", ExchangeType::DIRECT, false, false, {}));
+        ASSERT_TRUE(vh.declare_queue("q_d", true, false, false, {}));
+        ASSERT_TRUE(vh.declare_queue("q_t", false, false, false, {}));
+        ASSERT_TRUE(vh.bind("ex_d", "q_d", "a.#"));
+        ASSERT_TRUE(vh.bind("ex_d", "q_t", "b.#"));      // 非持久队列：不落盘
+    }
+
+    virtual_host vh("vh", dir, db);
+    auto ex = vh.select_exchange("ex_d");
+    ASSERT_TRUE(ex);
+    EXPECT_EQ(ex->type, ExchangeType::TOPIC);
+    EXPECT_TRUE(ex->durable);
+    EXPECT_EQ(ex->args.at("k"), "v");
+    EXPECT_FALSE(vh.select_exchange("ex_t"));
+
+    EXPECT_TRUE(vh.exists_queue("q_d"));
+    EXPECT_FALSE(vh.exists_queue("q_t"));
+
+    auto binds = vh.exchange_bindings("ex_d");
+    ASSERT_EQ(binds.size(), 1u);
+    EXPECT_EQ(binds.at("q_d")->binding_key, "a.#");
+    EXPECT_EQ(vh.exchange_bindings("").count("q_d"), 1u);
+}
+
+/* ---------- P8 元数据：删除落盘，快照 + WAL 一致 ---------- */
+TEST_F(PersistFixture, MetaStoreCheckpoint)
+{
+    const std::string db = dir + "/meta.db";
+    {
+        auto store = meta_store::open(db);
+        for (int i = 0; i < 100; ++i)
+            store->put(meta_kind::QUEUE, "q" + std::to_string(i), "1|0|0|");
+        store->checkpoint();                                 // 前 100 条进快照
+        store->erase(meta_kind::QUEUE, "q0");                // 之后的操作只在 WAL
+        store->put(meta_kind::EXCHANGE, "e", "0|1|0|");
+    }
+    EXPECT_TRUE(fs::exists(db));
+
+    auto store = meta_store::open(db);
+    auto queues = store->all(meta_kind::QUEUE);
+    EXPECT_EQ(queues.size(), 99u);
+    EXPECT_FALSE(queues.count("q0"));
+    EXPECT_EQ(store->all(meta_kind::EXCHANGE).size(), 1u);
+}
+
+/* ---------- P9 多队列并行恢复，恢复完成前拒绝读写 ---------- */
+TEST_F(PersistFixture, ParallelRecovery)
+{
+    const std::string db = dir + "/meta.db";
+    const int queues = 8, per_queue = 50;
+    {
+        virtual_host vh("vh", dir, db);
+        for (int q = 0; q < queues; ++q) {
+            std::string qname = "rq" + std::to_string(q);
+            ASSERT_TRUE(vh.declare_queue(qname, true, false, false, {}));
+            for (int i = 0; i < per_queue; ++i) {
+                auto bp = durable_props(qname + "-" + std::to_string(i));
+                bp.set_routing_key(qname);
+                ASSERT_TRUE(vh.basic_publish(qname, &bp, std::to_string(i)));
+            }
+        }
+    }
+
+    virtual_host vh("vh", dir, db);
+    vh.wait_recovered();
+    for (int q = 0; q < queues; ++q) {
+        std::string qname = "rq" + std::to_string(q);
+        ASSERT_TRUE(vh.queue_ready(qname));
+        for (int i = 0; i < per_queue; ++i) {
+            auto msg = vh.basic_consume(qname);
+            ASSERT_TRUE(msg);
+            EXPECT_EQ(msg->payload().body(), std::to_string(i));
+        }
+        EXPECT_FALSE(vh.basic_consume(qname));
+    }
+}
+
+TEST_F(PersistFixture, RecoveringQueueNotReady)
+{
+    queue_message qm(dir, "pq");
+    qm.mark_recovering();
+    EXPECT_FALSE(qm.ready());
+    qm.recovery();
+    EXPECT_TRUE(qm.ready());
+}
+
+/* ---------- P10 lazy 队列：只有队首窗口常驻内存，消费时顺序换入 ---------- */
+TEST_F(PersistFixture, LazyQueueBoundedResidency)
+{
+    const size_t total = queue_message::LAZY_WINDOW * 8;
+    queue_message qm(dir, "lq", nullptr, 64 << 10, {{QUEUE_MODE_ARG, QUEUE_MODE_LAZY}});
+    ASSERT_TRUE(qm.lazy());
+
+    for (size_t i = 0; i < total; ++i) {
+        BasicProperties bp;                                  // 非持久：RECORD_TRANSIENT
+        bp.set_id("l" + std::to_string(i));
+        ASSERT_TRUE(qm.insert(&bp, std::string(100, 'a' + i % 26), false));
+    }
+    EXPECT_EQ(qm.getable_count(), total);
+    EXPECT_EQ(qm.resident_count(), queue_message::LAZY_WINDOW);
+
+    for (size_t i = 0; i < total; ++i) {
+        auto msg = qm.front();
+        ASSERT_TRUE(msg);
+        ASSERT_EQ(msg->payload().properties().id(), "l" + std::to_string(i));
+        ASSERT_EQ(msg->payload().body(), std::string(100, 'a' + i % 26));
+        qm.remove(msg->payload().properties().id());
+        ASSERT_LE(qm.resident_count(), queue_message::LAZY_WINDOW);
+    }
+    EXPECT_EQ(qm.getable_count(), 0u);
+}
+
+/* ---------- P11 lazy 队列重启：持久消息恢复，换出的非持久消息丢弃 ---------- */
+TEST_F(PersistFixture, LazyQueueRecovery)
+{
+    const queue_message::args lazy{{QUEUE_MODE_ARG, QUEUE_MODE_LAZY}};
+    const size_t total = queue_message::LAZY_WINDOW * 2;
+    {
+        queue_message qm(dir, "lq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, lazy);
+        for (size_t i = 0; i < total; ++i) {
+            auto bp = durable_props("d" + std::to_string(i));
+            ASSERT_TRUE(qm.insert(&bp, "D" + std::to_string(i), true));
+            BasicProperties tp;  tp.set_id("t" + std::to_string(i));
+            ASSERT_TRUE(qm.insert(&tp, "T", true));
+        }
+    }
+
+    queue_message qm(dir, "lq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, lazy);
+    qm.recovery();
+    ASSERT_EQ(qm.getable_count(), total);
+    EXPECT_EQ(qm.resident_count(), queue_message::LAZY_WINDOW);
+    for (size_t i = 0; i < total; ++i) {
+        auto msg = qm.front();
+        ASSERT_TRUE(msg);
+        ASSERT_EQ(msg->payload().body(), "D" + std::to_string(i));
+        qm.remove("");
+    }
+}
+
+/* ---------- P12 x-compression：大消息体压缩存储，读回 / 恢复后可解压 ---------- */
+TEST_F(PersistFixture, CompressedStorage)
+{
+    std::string json;
+    for (int i = 0; json.size() < 50000; ++i)
+        json += "{\"id\":" + std::to_string(i) + ",\"name\":\"sensor\",\"ok\":true},";
+
+    const queue_message::args zargs{{COMPRESSION_ARG, COMPRESSION_ZLIB}};
+    uint64_t plain_bytes = 0, packed_bytes = 0;
+    {
+        queue_message plain(dir, "plain");
+        queue_message packed(dir, "packed", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, zargs);
+        for (int i = 0; i < 10; ++i) {
+            auto bp = durable_props("c" + std::to_string(i));
+            ASSERT_TRUE(plain.insert(&bp, json, true));
+            ASSERT_TRUE(packed.insert(&bp, json, true));
+            auto small = durable_props("s" + std::to_string(i));
+            ASSERT_TRUE(packed.insert(&small, "tiny", true));    // 低于阈值不压缩
+        }
+        plain_bytes  = fs::file_size(dir + "/plain/00000000000000000000.mqd");
+        packed_bytes = fs::file_size(dir + "/packed/00000000000000000000.mqd");
+    }
+    EXPECT_LT(packed_bytes * 5, plain_bytes);
+
+    queue_message qm(dir, "packed", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, zargs);
+    qm.recovery();
+    ASSERT_EQ(qm.getable_count(), 20u);
+
+    auto big = qm.front();
+    ASSERT_EQ(big->payload().properties().content_encoding(), ContentEncoding::ZLIB);
+    std::string plain;
+    ASSERT_TRUE(zlib_decompress(big->payload().body(), plain));
+    EXPECT_EQ(plain, json);
+    qm.remove("");
+
+    auto small = qm.front();
+    EXPECT_EQ(small->payload().properties().content_encoding(), ContentEncoding::IDENTITY);
+    EXPECT_EQ(small->payload().body(), "tiny");
+}
+
+/* ---------- P14 CRC32C：标准向量，硬件与软件实现一致 ---------- */
+TEST(Crc32c, KnownVectorAndPortableMatch)
+{
+    EXPECT_EQ(crc32c("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(crc32c_portable("123456789", 9), 0xE3069283u);
+
+    std::string buf(40000, '\0');
+    for (size_t i = 0; i < buf.size(); ++i) buf[i] = static_cast<char>(i * 131 + 7);
+    for (size_t len : {0u, 1u, 7u, 255u, 256u, 1000u, 8192u, 30000u})
+        for (size_t off : {0u, 1u, 3u})
+            EXPECT_EQ(crc32c(buf.data() + off, len), crc32c_portable(buf.data() + off, len))
+                << "len=" << len << " off=" << off;
+
+    // 分段续算
+    EXPECT_EQ(crc32c(buf.data() + 100, 900, crc32c(buf.data(), 100)), crc32c(buf.data(), 1000));
+}
+
+/* ---------- P15 记录校验：中间坏记录跳过，尾部坏记录截断 ---------- */
+TEST_F(PersistFixture, ChecksumDetectsCorruption)
+{
+    std::vector<uint64_t> offsets;
+    {
+        segment_log log(dir + "/seg");
+        ASSERT_TRUE(log.open());
+        for (int i = 0; i < 5; ++i) {
+            Message m;
+            m.mutable_payload()->set_body(std::string(64, 'a' + i));
+            ASSERT_TRUE(log.append(m));
+            EXPECT_EQ(m.payload().valid().size(), 8u);
+            offsets.push_back(m.offset());
+        }
+    }
+    std::string file;
+    for (const auto& e : fs::directory_iterator(dir + "/seg")) file = e.path().string();
+    auto flip = [&](uint64_t off) {
+        FILE* f = std::fopen(file.c_str(), "r+b");
+        std::fseek(f, static_cast<long>(off + sizeof(record_header) + 20), SEEK_SET);
+        int c = std::fgetc(f);
+        std::fseek(f, -1, SEEK_CUR);
+        std::fputc(c ^ 0x40, f);
+        std::fclose(f);
+    };
+    flip(offsets[1]);                       // 中间记录
+    flip(offsets[4]);                       // 最后一条
+    auto size = fs::file_size(file);
+
+    {
+        segment_log log(dir + "/seg");
+        ASSERT_TRUE(log.open());
+        auto msgs = log.recover();
+        ASSERT_EQ(msgs.size(), 3u);
+        EXPECT_EQ(msgs[0]->payload().body()[0], 'a');
+        EXPECT_EQ(msgs[1]->payload().body()[0], 'c');
+        EXPECT_EQ(msgs[2]->payload().body()[0], 'd');
+        EXPECT_EQ(fs::file_size(file), offsets[4]);
+        EXPECT_LT(fs::file_size(file), size);
+    }
+
+    // 坏记录已落盘置无效，再次恢复结果不变
+    segment_log log(dir + "/seg");
+    ASSERT_TRUE(log.open());
+    EXPECT_EQ(log.recover().size(), 3u);
+
+    // 换入路径同样校验
+    Message bad; bad.set_offset(offsets[1]);
+    bad.set_length(offsets[2] - offsets[1] - sizeof(record_header));
+    EXPECT_FALSE(log.read(bad));
+}
+
+/* ---------- P16 storage_io：io_uring 与 pwrite 后端写入结果一致 ---------- */
+TEST_F(PersistFixture, StorageIoBackends)
+{
+    fs::create_directories(dir);
+    std::string big(3 << 20, '\0');                     // 超过注册缓冲总量，需要分多轮
+    for (size_t i = 0; i < big.size(); ++i) big[i] = static_cast<char>(i * 7 + i / 4096);
+    std::string small = "small-record";
+
+    for (bool uring : {true, false}) {
+        auto io = storage_io::create(uring);
+        std::string a = dir + "/a" + std::to_string(uring), b = dir + "/b" + std::to_string(uring);
+        int fa = ::open(a.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        int fb = ::open(b.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        ASSERT_GE(fa, 0);
+        ASSERT_GE(fb, 0);
+
+        io_batch batch;
+        batch.writes.push_back({fa, 0, big.data(), 1 << 20});
+        batch.writes.push_back({fb, 5, small.data(), small.size()});
+        batch.writes.push_back({fa, 1 << 20, big.data() + (1 << 20), big.size() - (1 << 20)});
+        batch.syncs = {fa, fb};
+        EXPECT_TRUE(io->submit(batch)) << io->name();
+        ::close(fa);
+        ::close(fb);
+
+        std::ifstream ia(a, std::ios::binary), ib(b, std::ios::binary);
+        std::string ra((std::istreambuf_iterator<char>(ia)), std::istreambuf_iterator<char>());
+        std::string rb((std::istreambuf_iterator<char>(ib)), std::istreambuf_iterator<char>());
+        EXPECT_TRUE(ra == big) << io->name();
+        EXPECT_EQ(rb.substr(5), small) << io->name();
+    }
+}
+
+/* ---------- P17 提交中的记录仍可读，期间的确认在写完后落盘 ---------- */
+TEST_F(PersistFixture, ReadAndAckDuringCommit)
+{
+    auto log = std::make_shared<segment_log>(dir + "/seg", segment_log::DEFAULT_SEGMENT_BYTES, true);
+    ASSERT_TRUE(log->open());
+    Message m1, m2;
+    m1.mutable_payload()->set_body("one");
+    m2.mutable_payload()->set_body("two");
+    ASSERT_TRUE(log->append(m1));
+
+    io_batch batch;
+    EXPECT_GT(log->prepare_commit(batch), 0u);
+    ASSERT_TRUE(log->append(m2));                        // 进入新缓冲
+
+    Message r1; r1.set_offset(m1.offset()); r1.set_length(m1.length());
+    Message r2; r2.set_offset(m2.offset()); r2.set_length(m2.length());
+    ASSERT_TRUE(log->read(r1));
+    ASSERT_TRUE(log->read(r2));
+    EXPECT_EQ(r1.payload().body(), "one");
+    EXPECT_EQ(r2.payload().body(), "two");
+    EXPECT_TRUE(log->invalidate(m1));
+
+    EXPECT_TRUE(storage_io::create(true)->submit(batch));
+    log->finish_commit();
+    log->commit();
+
+    segment_log again(dir + "/seg");
+    ASSERT_TRUE(again.open());
+    auto msgs = again.recover();
+    ASSERT_EQ(msgs.size(), 1u);
+    EXPECT_EQ(msgs[0]->payload().body(), "two");
+}
+
+/* ---------- P18 保留策略：超出 x-retention-bytes 时整段删除最旧的段 ---------- */
+TEST_F(PersistFixture, RetentionBySize)
+{
+    auto dir_bytes = [&] {
+        uint64_t total = 0;
+        for (const auto& e : fs::directory_iterator(dir + "/pq")) total += fs::file_size(e.path());
+        return total;
+    };
+
+    {
+        queue_message qm(dir, "pq", nullptr, 1024, {{RETENTION_BYTES_ARG, "4096"}});
+        for (int i = 0; i < 100; ++i) {
+            auto bp = durable_props("s" + std::to_string(i));
+            ASSERT_TRUE(qm.insert(&bp, std::string(100, 'x'), true));
+        }
+        size_t dropped = qm.apply_retention();
+        EXPECT_GT(dropped, 0u);
+        EXPECT_EQ(qm.getable_count(), 100u - dropped);
+        EXPECT_LE(dir_bytes(), 4096u);
+        EXPECT_EQ(qm.front()->payload().properties().id(), "s" + std::to_string(dropped));
+        EXPECT_EQ(qm.apply_retention(), 0u);               // 已在限额内
+    }
+
+    queue_message qm(dir, "pq");
+    qm.recovery();
+    EXPECT_LT(qm.getable_count(), 100u);
+    EXPECT_EQ(qm.front()->payload().properties().id().front(), 's');
+}
+
+/* ---------- P19 保留策略：x-message-ttl 过期的段被删除，慢队列的当前段先封存 ---------- */
+TEST_F(PersistFixture, RetentionByTtl)
+{
+    queue_message qm(dir, "pq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                     {{MESSAGE_TTL_ARG, "50"}});
+    for (int i = 0; i < 10; ++i) {
+        auto bp = durable_props("t" + std::to_string(i));
+        ASSERT_TRUE(qm.insert(&bp, "old", true));
+    }
+    EXPECT_EQ(qm.apply_retention(), 0u);                   // 尚未过期
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+
+    auto bp = durable_props("fresh");
+    ASSERT_TRUE(qm.insert(&bp, "new", true));
+    EXPECT_EQ(qm.apply_retention(), 0u);                   // 当前段含新消息：只封存
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    auto bp2 = durable_props("fresh2");
+    ASSERT_TRUE(qm.insert(&bp2, "new", true));
+    EXPECT_EQ(qm.apply_retention(), 11u);                  // 封存段整体过期
+    EXPECT_EQ(qm.getable_count(), 1u);
+    EXPECT_EQ(qm.front()->payload().properties().id(), "fresh2");
+}
+
+/* ---------- P20 检查点：快照内的记录只核对记录头，之后的确认与追加照常恢复 ---------- */
+TEST_F(PersistFixture, CheckpointRecovery)
+{
+    auto& restored = metrics::instance().get("checkpoint.restored_records");
+    for (bool lazy : {false, true}) {
+        fs::remove_all(dir);
+        queue_message::args qargs;
+        if (lazy) qargs[QUEUE_MODE_ARG] = QUEUE_MODE_LAZY;
+        {
+            queue_message qm(dir, "pq", nullptr, 1024, qargs);
+            for (int i = 0; i < 50; ++i) {
+                auto bp = durable_props("c" + std::to_string(i));
+                ASSERT_TRUE(qm.insert(&bp, "body" + std::to_string(i), true));
+            }
+            for (int i = 0; i < 10; ++i) qm.remove("");            // 快照前确认
+            ASSERT_TRUE(qm.checkpoint());
+            for (int i = 0; i < 5; ++i) qm.remove("");             // 快照后确认
+            for (int i = 50; i < 55; ++i) {                         // 快照后追加
+                auto bp = durable_props("c" + std::to_string(i));
+                ASSERT_TRUE(qm.insert(&bp, "body" + std::to_string(i), true));
+            }
+        }
+
+        uint64_t before = restored.sum();
+        queue_message qm(dir, "pq", nullptr, 1024, qargs);
+        EXPECT_EQ(qm.recovery(), 40u);
+        EXPECT_EQ(restored.sum() - before, 35u) << "lazy=" << lazy;
+        for (int i = 15; i < 55; ++i) {
+            auto m = qm.front();
+            ASSERT_TRUE(m);
+            EXPECT_EQ(m->payload().properties().id(), "c" + std::to_string(i));
+            qm.remove(m->payload().properties().id());
+        }
+    }
+}
+
+/* ---------- P21 检查点：段被压缩重写后旧快照作废，退回全量扫描 ---------- */
+TEST_F(PersistFixture, CheckpointInvalidatedByCompaction)
+{
+    {
+        queue_message qm(dir, "pq", nullptr, 1024);
+        for (int i = 0; i < 40; ++i) {
+            auto bp = durable_props("k" + std::to_string(i));
+            ASSERT_TRUE(qm.insert(&bp, std::string(60, 'k'), true));
+        }
+        for (int i = 0; i < 40; i += 2) qm.remove("k" + std::to_string(i));
+        ASSERT_TRUE(qm.checkpoint());
+        EXPECT_GT(qm.compact(0.3, nullptr), 0u);
+        EXPECT_FALSE(fs::exists(dir + "/pq/checkpoint"));
+    }
+
+    queue_message qm(dir, "pq");
+    EXPECT_EQ(qm.recovery(), 20u);
+    EXPECT_EQ(qm.front()->payload().properties().id(), "k1");
+}
+
+/* ---------- P22 就绪列表环形数组：回绕 / 扩容 / 中间空位，持久与内存消息混排顺序不变 ---------- */
+TEST_F(PersistFixture, RingStoreOrderAcrossWrapAndGrow)
+{
+    std::vector<std::string> expect;
+    {
+        queue_message qm(dir, "pq");
+        int next = 0;
+        auto push = [&](int n) {
+            for (int i = 0; i < n; ++i, ++next) {
+                auto bp = durable_props("r" + std::to_string(next));
+                bp.set_delivery_mode(next % 2 ? DeliveryMode::DURABLE : DeliveryMode::UNDURABLE);
+                ASSERT_TRUE(qm.insert(&bp, "body" + std::to_string(next), true));
+                expect.push_back(bp.id());
+            }
+        };
+        auto ack = [&](const std::string& id) {
+            qm.remove(id);
+            expect.erase(std::find(expect.begin(), expect.end(), id));
+        };
+
+        push(50);                                       // 初始 64 槽
+        for (int i = 0; i < 40; ++i) {                  // 队首推进，之后的入队回绕
+            auto m = qm.pop_front();
+            ASSERT_TRUE(m);
+            EXPECT_EQ(m->payload().properties().id(), expect.front());
+            EXPECT_EQ(m->payload().body(), "body" + expect.front().substr(1));
+            expect.erase(expect.begin());
+        }
+        push(40);
+        for (int i = 60; i < 90; i += 3) ack("r" + std::to_string(i));   // 中间留空位
+        push(200);                                      // 带空位扩容
+        ack(expect.front());                            // 队首被删，越过后续空位
+        EXPECT_EQ(qm.getable_count(), expect.size());
+        EXPECT_EQ(qm.front()->payload().properties().id(), expect.front());
+    }
+
+    // 重启后只剩持久化消息，顺序与内存中一致
+    queue_message qm(dir, "pq");
+    qm.recovery();
+    std::vector<std::string> durable;
+    for (const auto& id : expect)
+        if (std::stoi(id.substr(1)) % 2) durable.push_back(id);
+    ASSERT_EQ(qm.getable_count(), durable.size());
+    for (const auto& id : durable) EXPECT_EQ(qm.pop_front()->payload().properties().id(), id);
+    EXPECT_FALSE(qm.pop_front());
+}
+
+/* ---------- P23 未确认的持久化消息：不在就绪列表，重启（含检查点）后重新就绪 ---------- */
+TEST_F(PersistFixture, UnackedSurvivesRestart)
+{
+    {
+        queue_message qm(dir, "pq");
+        for (int i = 0; i < 5; ++i) {
+            auto bp = durable_props("u" + std::to_string(i));
+            ASSERT_TRUE(qm.insert(&bp, "U", true));
+        }
+        uint64_t t0 = 0, t1 = 0, t2 = 0;
+        ASSERT_TRUE(qm.deliver(t0));
+        ASSERT_TRUE(qm.deliver(t1));
+        ASSERT_TRUE(qm.deliver(t2));
+        EXPECT_EQ(qm.getable_count(), 2u);
+        EXPECT_EQ(qm.unacked_count(), 3u);
+        EXPECT_TRUE(qm.ack(t1));                    // u1 确认；u0 / u2 仍未确认
+        ASSERT_TRUE(qm.checkpoint());
+    }
+
+    queue_message qm(dir, "pq");
+    EXPECT_EQ(qm.recovery(), 4u);
+    for (const char* id : {"u0", "u2", "u3", "u4"})
+        EXPECT_EQ(qm.pop_front()->payload().properties().id(), id);
+}
+
+/* ---------- P24 优先级队列：高优先级先出、同级 FIFO、超上限按最高，退回与重启不乱序 ---------- */
+TEST_F(PersistFixture, PriorityBucketsOrder)
+{
+    const queue_message::args qargs = {{MAX_PRIORITY_ARG, "5"}};
+    auto push = [](queue_message& qm, const std::string& id, uint32_t prio) {
+        auto bp = durable_props(id);
+        bp.set_priority(prio);
+        ASSERT_TRUE(qm.insert(&bp, "B" + id, true));
+    };
+    {
+        queue_message qm(dir, "pq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, qargs);
+        EXPECT_EQ(qm.max_priority(), 5u);
+        push(qm, "a0", 0);
+        push(qm, "c0", 3);
+        push(qm, "a1", 0);
+        push(qm, "top", 9);                          // 超过 x-max-priority ⇒ 按 5
+        push(qm, "c1", 3);
+        EXPECT_EQ(qm.front()->payload().properties().id(), "top");
+
+        auto m = qm.pop_front();
+        EXPECT_EQ(m->payload().body(), "Btop");
+        uint64_t t = 0;
+        ASSERT_EQ(qm.deliver(t)->payload().properties().id(), "c0");
+        push(qm, "c2", 3);
+        EXPECT_TRUE(qm.requeue(t));                  // 回到优先级 3 的队首
+        qm.remove("a0");
+        ASSERT_TRUE(qm.checkpoint());
+        push(qm, "b0", 1);                           // 检查点之后的日志尾部
+    }
+
+    queue_message qm(dir, "pq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES, qargs);
+    EXPECT_EQ(qm.recovery(), 5u);
+    for (const char* id : {"c0", "c1", "c2", "b0", "a1"})
+        EXPECT_EQ(qm.pop_front()->payload().properties().id(), id);
+    EXPECT_FALSE(qm.pop_front());
+
+    // 普通队列忽略 priority
+    queue_message plain(dir, "plain");
+    push(plain, "p0", 0);
+    push(plain, "p1", 7);
+    EXPECT_EQ(plain.max_priority(), 0u);
+    EXPECT_EQ(plain.pop_front()->payload().properties().id(), "p0");
+}
+
+/* ---------- P25 lazy 优先级队列：换出状态下插队的高优先级消息出队时读回消息体 ---------- */
+TEST_F(PersistFixture, LazyPriorityFetchesBody)
+{
+    queue_message qm(dir, "lq", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                     {{QUEUE_MODE_ARG, QUEUE_MODE_LAZY}, {MAX_PRIORITY_ARG, "2"}});
+    const std::size_t n = queue_message::LAZY_WINDOW + 50;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto bp = durable_props("l" + std::to_string(i));
+        ASSERT_TRUE(qm.insert(&bp, "low", false));
+    }
+    auto bp = durable_props("hi");
+    bp.set_priority(2);
+    ASSERT_TRUE(qm.insert(&bp, "urgent", false));
+    EXPECT_EQ(qm.resident_count(), queue_message::LAZY_WINDOW);
+
+    EXPECT_EQ(qm.front()->payload().body(), "urgent");
+    auto m = qm.pop_front();
+    EXPECT_EQ(m->payload().properties().id(), "hi");
+    EXPECT_EQ(m->payload().body(), "urgent");
+    for (std::size_t i = 0; i < n; ++i) {
+        m = qm.pop_front();
+        ASSERT_TRUE(m);
+        EXPECT_EQ(m->payload().properties().id(), "l" + std::to_string(i));
+        EXPECT_EQ(m->payload().body(), "low");
+    }
+}
+
+/* ---------- P26 扇出：各队列引用同一份消息体；最后一个出队的直接接管，不再拷贝 ---------- */
+TEST_F(PersistFixture, FanoutSharesOneBody)
+{
+    auto vh = std::make_shared<virtual_host>("fan", dir, dir + "/meta.db");
+    ASSERT_TRUE(vh->declare_exchange("fan", ExchangeType::FANOUT, false, false, {}));
+    for (const char* q : {"f0", "f1", "f2"}) {
+        ASSERT_TRUE(vh->declare_queue(q, false, false, false, {}));
+        ASSERT_TRUE(vh->bind("fan", q, ""));
+    }
+    const std::string body(64 * 1024, 'b');
+    ASSERT_TRUE(vh->publish_ex("fan", "", nullptr, body));
+
+    shared_body s0, s1;
+    auto m0 = vh->basic_consume("f0", &s0);
+    uint64_t inflight = 0;
+    auto m1 = vh->basic_get("f1", inflight, &s1);
+    ASSERT_TRUE(m0 && m1 && s0 && s1);
+    EXPECT_EQ(s0.get(), s1.get());                         // 同一块缓冲
+    EXPECT_TRUE(m0->payload().body().empty());             // 只交出引用
+    EXPECT_EQ(*s0, body);
+
+    const char* buf = s0->data();
+    s0.reset();
+    s1.reset();
+    EXPECT_TRUE(vh->basic_ack_inflight("f1", inflight));   // unacked 里的引用随确认释放
+    auto m2 = vh->basic_consume("f2");                     // 不要引用：最后一个持有者接管
+    ASSERT_TRUE(m2);
+    EXPECT_EQ(m2->payload().body(), body);
+    EXPECT_EQ(m2->payload().body().data(), buf);
+}
+
+/* ---------- P27 持久化扇出：共享消息体直接写入各队列段日志，重启后校验通过并完整恢复 ---------- */
+TEST_F(PersistFixture, DurableFanoutRecovers)
+{
+    {
+        auto vh = std::make_shared<virtual_host>("fan", dir, dir + "/meta.db");
+        ASSERT_TRUE(vh->declare_exchange("fan", ExchangeType::FANOUT, true, false, {}));
+        for (const char* q : {"d0", "d1"}) {
+            ASSERT_TRUE(vh->declare_queue(q, true, false, false, {}));
+            ASSERT_TRUE(vh->bind("fan", q, ""));
+        }
+        for (int i = 0; i < 3; ++i) {
+            auto bp = durable_props("f" + std::to_string(i));
+            bp.clear_routing_key();
+            ASSERT_TRUE(vh->publish_ex("fan", "", &bp, "fan-body-" + std::to_string(i)));
+        }
+    }
+
+    auto vh = std::make_shared<virtual_host>("fan", dir, dir + "/meta.db");
+    vh->wait_recovered();
+    for (const char* q : {"d0", "d1"}) {
+        for (int i = 0; i < 3; ++i) {
+            auto m = vh->basic_consume(q);
+            ASSERT_TRUE(m) << q << " " << i;
+            EXPECT_EQ(m->payload().properties().id(), "f" + std::to_string(i));
+            EXPECT_EQ(m->payload().body(), "fan-body-" + std::to_string(i));
+        }
+        EXPECT_FALSE(vh->basic_consume(q));
+    }
+}
+
+/* ---------- P28 队列名即目录名：越出数据目录的名字声明失败，删除时不会波及目录外 ---------- */
+TEST_F(PersistFixture, UnsafeQueueNamesRejected)
+{
+    const std::string outside = "./testdata_persist_outside";
+    fs::remove_all(outside);
+    fs::create_directories(outside + "/keep");
+
+    {
+        virtual_host vh("vh", dir, dir + "/meta.db");
+        const std::vector<std::string> unsafe = {"", ".", "..", "../testdata_persist_outside", "a/b",
+                                                 std::string("x\0y", 3), DELAYED_STORE};
+        for (const auto& name : unsafe) {
+            EXPECT_FALSE(vh.declare_queue(name, true, false, false, {})) << name;
+            EXPECT_FALSE(vh.exists_queue(name)) << name;
+            vh.delete_queue(name);
+        }
+        EXPECT_TRUE(vh.declare_queue("..q.", true, false, false, {}));   // 只是含点号，合法
+    }
+    EXPECT_TRUE(fs::exists(outside + "/keep"));
+    EXPECT_TRUE(fs::exists(dir + "/" + DELAYED_STORE));
+
+    virtual_host vh("vh", dir, dir + "/meta.db");
+    EXPECT_TRUE(vh.exists_queue("..q."));
+    fs::remove_all(outside);
+}
+
+/* ---------- P29 元数据 WAL 写失败：截掉写了一半的记录，整批留待重试；期间的消息确认为失败 ---------- */
+namespace {
+class torn_write_io : public file_io {
+public:
+    ssize_t write(int fd, const void* buf, size_t len) override
+    {
+        if (!armed.load()) return ::write(fd, buf, len);
+        ::write(fd, buf, len / 2);                       // 写下一半后报错
+        errno = EIO;
+        return -1;
+    }
+
+    std::atomic<bool> armed{false};
+};
+}
+
+TEST_F(PersistFixture, MetaWalFailureRetried)
+{
+    const std::string db = dir + "/meta.db";
+    torn_write_io io;
+    {
+        auto store = meta_store::open(db);
+        store->put(meta_kind::QUEUE, "before", "1|0|0|");
+        ASSERT_TRUE(store->flush());
+
+        set_file_io(&io);
+        io.armed = true;
+        store->put(meta_kind::QUEUE, "lost?", "1|0|0|");
+        store->put(meta_kind::BINDING, "ex\nlost?", "k");
+        EXPECT_FALSE(store->flush());
+
+        auto gc = std::make_shared<group_commit>();      // 元数据没落盘：同批消息不能确认
+        gc->set_pre_commit([&store] { return store->flush(); });
+        queue_message qm(dir, "pq", gc);
+        auto bp = durable_props("m");
+        ASSERT_TRUE(qm.insert(&bp, "body", true));
+        EXPECT_FALSE(gc->sync());
+
+        io.armed = false;
+        store->erase(meta_kind::QUEUE, "before");         // 排在失败的那批之后
+        EXPECT_TRUE(store->flush());
+        auto bp2 = durable_props("m2");
+        ASSERT_TRUE(qm.insert(&bp2, "body", true));
+        EXPECT_TRUE(gc->sync());
+        set_file_io(nullptr);
+    }
+
+    auto store  = meta_store::open(db);
+    auto queues = store->all(meta_kind::QUEUE);
+    EXPECT_EQ(queues.size(), 1u);
+    EXPECT_TRUE(queues.count("lost?"));
+    EXPECT_EQ(store->all(meta_kind::BINDING).size(), 1u);
+}
+
+/* ---------- P30 网络发布路径：一次发到扇出 / 主题交换机，每个绑定队列各一条，消息体只有一份 ---------- */
+TEST_F(PersistFixture, ChannelPublishFansOut)
+{
+    auto vh = std::make_shared<virtual_host>("fan", dir, dir + "/meta.db");
+    ASSERT_TRUE(vh->declare_exchange("fan", ExchangeType::FANOUT, false, false, {}));
+    ASSERT_TRUE(vh->declare_exchange("top", ExchangeType::TOPIC, false, false, {}));
+    const std::vector<std::string> names = {"c0", "c1", "c2", "c3"};
+    for (const auto& q : names) {
+        ASSERT_TRUE(vh->declare_queue(q, false, false, false, {}));
+        ASSERT_TRUE(vh->bind("fan", q, ""));
+    }
+    ASSERT_TRUE(vh->bind("top", "c0", "a.*"));
+    ASSERT_TRUE(vh->bind("top", "c1", "a.#"));
+
+    BasicProperties bp;                                      // 路由键为空：不得被改写成某个队列名
+    std::vector<std::string> queues;
+    ASSERT_TRUE(vh->publish_ex("fan", &bp, std::string(4096, 'n'), queues));
+    EXPECT_TRUE(bp.routing_key().empty());
+    std::sort(queues.begin(), queues.end());
+    EXPECT_EQ(queues, names);
+
+    std::vector<shared_body> shares(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        ASSERT_TRUE(vh->basic_consume(names[i], &shares[i])) << names[i];
+        ASSERT_TRUE(shares[i]);
+        EXPECT_EQ(shares[i].get(), shares[0].get());         // 各队列引用同一份消息体
+        EXPECT_FALSE(vh->basic_consume(names[i]));           // 每个队列恰好一条
+    }
+    EXPECT_EQ(*shares[0], std::string(4096, 'n'));
+
+    BasicProperties tp;
+    tp.set_routing_key("a.b");
+    queues.clear();
+    ASSERT_TRUE(vh->publish_ex("top", &tp, "T", queues));
+    std::sort(queues.begin(), queues.end());
+    EXPECT_EQ(queues, (std::vector<std::string>{"c0", "c1"}));
+
+    bool unroutable = false;                                 // 没有匹配的绑定：不入队，标记出来
+    tp.set_routing_key("zzz");
+    queues.clear();
+    EXPECT_FALSE(vh->publish_ex("top", &tp, "T", queues, &unroutable));
+    EXPECT_TRUE(unroutable);
+    EXPECT_TRUE(queues.empty());
+}
+
+/* ---------- P31 valid 字段本身损坏（tag 字节）也算校验失败，不会跳过校验 ---------- */
+TEST_F(PersistFixture, MalformedChecksumFieldRejected)
+{
+    std::vector<uint64_t> offsets;
+    {
+        segment_log log(dir + "/seg");
+        ASSERT_TRUE(log.open());
+        for (int i = 0; i < 3; ++i) {
+            Message m;
+            m.mutable_payload()->set_body(std::string(64, 'a' + i));
+            ASSERT_TRUE(log.append(m));
+            offsets.push_back(m.offset());
+        }
+    }
+    std::string file;
+    for (const auto& e : fs::directory_iterator(dir + "/seg")) file = e.path().string();
+    {
+        // 中间记录末尾 10 字节是 valid 字段：| tag | len | 8 位十六进制 |
+        FILE* f = std::fopen(file.c_str(), "r+b");
+        std::fseek(f, static_cast<long>(offsets[2] - 10), SEEK_SET);
+        std::fputc(0x7f, f);
+        std::fclose(f);
+    }
+
+    auto& errors = metrics::instance().get("segment.crc_errors");
+    uint64_t before = errors.count();
+
+    segment_log log(dir + "/seg");
+    ASSERT_TRUE(log.open());
+    auto msgs = log.recover();
+    ASSERT_EQ(msgs.size(), 2u);
+    EXPECT_EQ(msgs[0]->payload().body()[0], 'a');
+    EXPECT_EQ(msgs[1]->payload().body()[0], 'c');
+    EXPECT_GT(errors.count(), before);
+
+    Message bad; bad.set_offset(offsets[1]);
+    bad.set_length(offsets[2] - offsets[1] - sizeof(record_header));
+    EXPECT_FALSE(log.read(bad));
+}
+
+/* ---------- P32 按 id 确认：空 id / 不存在的 id 返回失败，不会删掉未投递的队首 ---------- */
+TEST_F(PersistFixture, LegacyAckNeverPopsHead)
+{
+    auto vh = std::make_shared<virtual_host>("ack", dir, dir + "/meta.db");
+    ASSERT_TRUE(vh->declare_queue("q", false, false, false, {}));
+    for (const char* id : {"m1", "m2"}) {
+        BasicProperties bp;
+        bp.set_id(id);
+        bp.set_routing_key("q");
+        ASSERT_TRUE(vh->basic_publish("q", &bp, id));
+    }
+
+    EXPECT_FALSE(vh->basic_ack("q", ""));
+    EXPECT_FALSE(vh->basic_ack("q", "stale"));
+    EXPECT_TRUE(vh->basic_ack("q", "m2"));
+    EXPECT_FALSE(vh->basic_ack("q", "m2"));
+
+    auto head = vh->basic_consume("q");
+    ASSERT_TRUE(head);
+    EXPECT_EQ(head->payload().properties().id(), "m1");
+    EXPECT_FALSE(vh->basic_consume("q"));
+}
+
+/* ---------- P33 发布确认只等本次发布自己的持久化追加，与其他发布的写入无关 ---------- */
+TEST_F(PersistFixture, PublishSpanCoversOwnAppendsOnly)
+{
+    auto vh = std::make_shared<virtual_host>("span", dir, dir + "/meta.db");
+    ASSERT_TRUE(vh->declare_queue("d", true, false, false, {}));
+    ASSERT_TRUE(vh->declare_queue("t", false, false, false, {}));
+    ASSERT_TRUE(vh->declare_exchange("both", ExchangeType::FANOUT, false, false, {}));
+    ASSERT_TRUE(vh->bind("both", "d", ""));
+    ASSERT_TRUE(vh->bind("both", "t", ""));
+
+    auto durable_props = [] {
+        BasicProperties bp;
+        bp.set_delivery_mode(DeliveryMode::DURABLE);
+        return bp;
+    };
+
+    durable_span other;                                   // 另一个发布方的持久化写入
+    BasicProperties bp = durable_props();
+    ASSERT_TRUE(vh->basic_publish("d", &bp, "x", nullptr, &other));
+    EXPECT_FALSE(other.empty());
+
+    durable_span transient;                               // 非持久队列：没有要等的写入
+    bp = durable_props();
+    ASSERT_TRUE(vh->basic_publish("t", &bp, "y", nullptr, &transient));
+    EXPECT_TRUE(transient.empty());
+
+    durable_span fan;                                     // 扇出：只含写入 d 的那一条
+    std::vector<std::string> queues;
+    bp = durable_props();
+    ASSERT_TRUE(vh->publish_ex("both", &bp, std::string("z"), queues, nullptr, &fan));
+    EXPECT_EQ(queues.size(), 2u);
+    EXPECT_EQ(fan.first, fan.last);
+    EXPECT_GT(fan.first, other.last);
+
+    std::promise<bool> done;
+    vh->when_durable(fan, [&done](bool ok) { done.set_value(ok); });
+    EXPECT_TRUE(done.get_future().get());
+}
+
+/* ---------- P34 保留策略不删含未确认消息的段：确认之后才整段删除 ---------- */
+TEST_F(PersistFixture, RetentionKeepsUnackedSegments)
+{
+    queue_message qm(dir, "pq", nullptr, 1024, {{RETENTION_BYTES_ARG, "4096"}});
+    for (int i = 0; i < 100; ++i) {
+        auto bp = durable_props("u" + std::to_string(i));
+        ASSERT_TRUE(qm.insert(&bp, std::string(100, 'x'), true));
+    }
+    uint64_t inflight = 0;
+    auto held = qm.deliver(inflight);
+    ASSERT_TRUE(held);
+    EXPECT_EQ(held->payload().properties().id(), "u0");
+
+    EXPECT_EQ(qm.apply_retention(), 0u);                   // 最旧的段里有未确认的 u0
+    EXPECT_EQ(qm.getable_count(), 99u);
+    ASSERT_TRUE(qm.requeue(inflight));                     // 退回仍能找到段里的记录
+
+    ASSERT_TRUE(qm.deliver(inflight));
+    ASSERT_TRUE(qm.ack(inflight));
+    size_t dropped = qm.apply_retention();
+    EXPECT_GT(dropped, 0u);
+    EXPECT_EQ(qm.getable_count(), 99u - dropped);
+}
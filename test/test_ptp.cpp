@@ -216,4 +216,28 @@ TEST(ThreadPool, GracefulDestruct)
             pool.push([&]{ counter.fetch_add(1,std::memory_order_relaxed); });
     }   // 作用域结束触发析构，必须把 20 个任务都跑完
     EXPECT_EQ(counter.load(), 20);
-}
\ No newline at end of file
+}
+/* ---------- E4 queue_message 按 id 删除中间消息 / 自动补 id ---------- */
+TEST(QueueMessage, RemoveByIdKeepsOrder)
+{
+    queue_message qm(".", "q");
+    for (const char* id : {"a", "b", "c"}) {
+        BasicProperties bp;  bp.set_id(id);
+        ASSERT_TRUE(qm.insert(&bp, id, false));
+    }
+    BasicProperties anon;                 // 无 id：入队时补发
+    ASSERT_TRUE(qm.insert(&anon, "d", false));
+
+    qm.remove("b");
+    EXPECT_EQ(qm.getable_count(), 3u);
+    EXPECT_EQ(qm.front()->payload().body(), "a");
+    qm.remove("a");
+    EXPECT_EQ(qm.front()->payload().body(), "c");
+    qm.remove("c");
+
+    auto last = qm.front();
+    ASSERT_NE(last, nullptr);
+    EXPECT_FALSE(last->payload().properties().id().empty());
+    qm.remove(last->payload().properties().id());
+    EXPECT_EQ(qm.getable_count(), 0u);
+}
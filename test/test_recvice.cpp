@@ -4,6 +4,12 @@
 #include <gtest/gtest.h>
 #include "../server/virtual_host.hpp"
 #include "../server/consumer.hpp"
+#include "../server/consume_frame.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <muduo/net/Buffer.h>
+#include <zlib.h>
 
 using namespace hz_mq;
 
@@ -141,3 +147,74 @@ TEST_F(ReceiveFixture, PullThenPushSequence)       /* 模式切换序列 */
 
     EXPECT_EQ(got,"second");
 }
+
+/* ------------------------------------------------------------------
+ *  手动确认：未确认的消息不在就绪列表，ack 后删除，reject 可退回队首
+ * ----------------------------------------------------------------*/
+TEST_F(ReceiveFixture, ManualAckUnackedSet)
+{
+    pub("a"); pub("b"); pub("c");
+
+    uint64_t t1 = 0, t2 = 0;
+    auto m1 = host->basic_get("q1", t1);
+    auto m2 = host->basic_get("q1", t2);
+    ASSERT_NE(m1, nullptr); ASSERT_NE(m2, nullptr);
+    EXPECT_EQ(m1->payload().body(), "a");
+    EXPECT_EQ(m2->payload().body(), "b");
+    EXPECT_NE(t1, t2);
+
+    EXPECT_TRUE(host->basic_ack_inflight("q1", t2));
+    EXPECT_FALSE(host->basic_ack_inflight("q1", t2));          // 重复确认
+    EXPECT_TRUE(host->basic_reject("q1", t1, true));            // 退回队首
+
+    auto r = host->basic_consume("q1");
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->payload().body(), "a");
+    EXPECT_EQ(host->basic_consume("q1")->payload().body(), "c");
+    EXPECT_EQ(host->basic_consume("q1"), nullptr);
+
+    pub("d");
+    uint64_t t3 = 0;
+    ASSERT_NE(host->basic_get("q1", t3), nullptr);
+    EXPECT_TRUE(host->basic_reject("q1", t3, false));           // 丢弃
+    EXPECT_EQ(host->basic_consume("q1"), nullptr);
+}
+
+/* ------------------------------------------------------------------
+ *  投递帧：直接编码的帧与 ProtobufCodec 格式一致
+ * ----------------------------------------------------------------*/
+TEST(ConsumeFrame, MatchesCodecFormat)
+{
+    basicConsumeResponse head;
+    head.set_cid("c1");
+    head.set_consumer_tag("tag");
+    head.set_delivery_tag(42);
+    head.mutable_properties()->set_id("m1");
+    const std::string body(100000, 'z');
+
+    muduo::net::Buffer buf;
+    encode_consume_frame(&buf, head, body.data(), body.size());
+
+    auto rd32 = [&](size_t off) {
+        int32_t v; std::memcpy(&v, buf.peek() + off, 4); return static_cast<int32_t>(ntohl(v));
+    };
+    const size_t total = buf.readableBytes();
+    ASSERT_EQ(static_cast<size_t>(rd32(0)), total - 4);
+
+    int32_t name_len = rd32(4);
+    EXPECT_STREQ(buf.peek() + 8, head.GetTypeName().c_str());
+
+    const char* pb     = buf.peek() + 8 + name_len;
+    const size_t pb_len = total - 8 - name_len - 4;
+    basicConsumeResponse got;
+    ASSERT_TRUE(got.ParseFromArray(pb, static_cast<int>(pb_len)));
+    EXPECT_EQ(got.cid(), "c1");
+    EXPECT_EQ(got.consumer_tag(), "tag");
+    EXPECT_EQ(got.delivery_tag(), 42u);
+    EXPECT_EQ(got.properties().id(), "m1");
+    EXPECT_EQ(got.body(), body);
+
+    uLong check = ::adler32(1, reinterpret_cast<const Bytef*>(buf.peek() + 4),
+                            static_cast<uInt>(total - 8));
+    EXPECT_EQ(rd32(total - 4), static_cast<int32_t>(check));
+}
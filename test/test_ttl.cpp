@@ -0,0 +1,302 @@
+/********************************************************************
+*  test_ttl.cpp —— 消息过期与延迟投递：分层时间轮 + x-message-ttl / expiration / delay_ms
+********************************************************************/
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include "../server/timer_wheel.hpp"
+#include "../server/virtual_host.hpp"
+#include "../server/queue_message.hpp"
+
+using namespace hz_mq;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class TtlFixture : public ::testing::Test {
+protected:
+    void SetUp()    override { fs::remove_all(dir); }
+    void TearDown() override { fs::remove_all(dir); }
+
+    virtual_host::ptr open_host()
+    {
+        return std::make_shared<virtual_host>("ttl", dir, dir + "/meta.db");
+    }
+
+    static void sleep_ms(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+    const std::string dir = "./testdata_ttl";
+};
+
+BasicProperties props(const std::string& id, uint64_t expiration = 0,
+                      DeliveryMode mode = DeliveryMode::UNDURABLE)
+{
+    BasicProperties bp;
+    bp.set_id(id);
+    bp.set_expiration(expiration);
+    bp.set_delivery_mode(mode);
+    return bp;
+}
+
+} // namespace
+
+/* ---------- T1 时间轮：各层跨度的定时器都在截止 tick 到期，不早也不晚 ---------- */
+TEST(TimerWheel, FiresExactlyAtDeadlineAcrossLevels)
+{
+    const int64_t start = 1000000;
+    timer_wheel tw(timer_wheel::options{std::chrono::milliseconds(1)}, start);
+
+    std::mt19937_64 rng(3);
+    std::vector<int64_t> deadlines = {start - 5, start, start + 1, start + 255, start + 256,
+                                      start + 65535, start + 65536, start + 65537,
+                                      start + (1 << 24) + 17};
+    for (int i = 0; i < 2000; ++i) deadlines.push_back(start + 1 + static_cast<int64_t>(rng() % 300000));
+    for (size_t i = 0; i < deadlines.size(); ++i)
+        tw.schedule({}, msg_pos{0, i}, deadlines[i]);
+    EXPECT_EQ(tw.pending(), deadlines.size());
+
+    // 随机步长推进：每个定时器在 now >= deadline 的第一次 advance 交出
+    std::vector<bool> fired(deadlines.size(), false);
+    int64_t now = start;
+    size_t  seen = 0;
+    while (seen < deadlines.size()) {
+        now += (rng() % 4 == 0) ? static_cast<int64_t>(rng() % 5000) : 1;
+        if (seen + 1 == deadlines.size()) now = std::max(now, deadlines[8]);
+        for (const auto& t : tw.advance(now)) {
+            ASSERT_FALSE(fired[t.pos.seq]);
+            fired[t.pos.seq] = true;
+            ++seen;
+            EXPECT_LE(t.deadline, now);
+        }
+        for (size_t i = 0; i < deadlines.size(); ++i)
+            ASSERT_TRUE(fired[i] || deadlines[i] > now) << "late timer " << i;
+    }
+    EXPECT_EQ(tw.pending(), 0u);
+}
+
+/* ---------- T2 x-message-ttl 与 expiration 取较小者；中间的过期消息由时间轮删除 ---------- */
+TEST_F(TtlFixture, QueueAndMessageTtl)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("tq", false, false, false, {{MESSAGE_TTL_ARG, "60"}}));
+
+    auto keep  = props("keep", 0);
+    auto quick = props("quick", 10);            // 排在中间，比队列 TTL 先过期
+    auto slow  = props("slow", 100000);          // 受队列 TTL 约束
+    ASSERT_TRUE(vh->basic_publish("tq", &keep, "k"));
+    ASSERT_TRUE(vh->basic_publish("tq", &quick, "q"));
+    ASSERT_TRUE(vh->basic_publish("tq", &slow, "s"));
+
+    sleep_ms(30);
+    EXPECT_EQ(vh->expire_tick(), 1u);
+    auto m = vh->basic_consume("tq");
+    ASSERT_TRUE(m);
+    EXPECT_EQ(m->payload().properties().id(), "keep");
+
+    sleep_ms(50);
+    EXPECT_EQ(vh->expire_tick(), 1u);
+    EXPECT_FALSE(vh->basic_consume("tq"));
+
+    // 普通队列只看消息自带的 expiration
+    ASSERT_TRUE(vh->declare_queue("plain", false, false, false, {}));
+    auto forever = props("forever");
+    ASSERT_TRUE(vh->basic_publish("plain", &forever, "f"));
+    sleep_ms(70);
+    EXPECT_EQ(vh->expire_tick(), 0u);
+    EXPECT_TRUE(vh->basic_consume("plain"));
+}
+
+/* ---------- T3 时间轮还没走到时，出队也会跳过已过期的队首 ---------- */
+TEST_F(TtlFixture, ExpiredHeadSkippedOnConsume)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("hq", false, false, false, {}));
+    auto a = props("a", 1), b = props("b");
+    ASSERT_TRUE(vh->basic_publish("hq", &a, "A"));
+    ASSERT_TRUE(vh->basic_publish("hq", &b, "B"));
+    sleep_ms(5);
+    auto m = vh->basic_consume("hq");
+    ASSERT_TRUE(m);
+    EXPECT_EQ(m->payload().properties().id(), "b");
+    EXPECT_EQ(vh->expire_tick(), 0u);             // 定时器指向的消息已不在
+}
+
+/* ---------- T4 未确认的消息不过期；退回队列后按原截止时间过期 ---------- */
+TEST_F(TtlFixture, UnackedNotExpiredUntilRequeued)
+{
+    auto vh = open_host();
+    ASSERT_TRUE(vh->declare_queue("uq", false, false, false, {}));
+    auto a = props("a", 20);
+    ASSERT_TRUE(vh->basic_publish("uq", &a, "A"));
+
+    uint64_t inflight = 0;
+    ASSERT_TRUE(vh->basic_get("uq", inflight));
+    sleep_ms(30);
+    EXPECT_EQ(vh->expire_tick(), 0u);
+    EXPECT_TRUE(vh->basic_reject("uq", inflight, true));
+    EXPECT_EQ(vh->expire_tick(), 1u);
+    EXPECT_FALSE(vh->basic_consume("uq"));
+}
+
+/* ---------- T5 持久化消息的截止时间随记录落盘，重启后照常过期 ---------- */
+TEST_F(TtlFixture, DeadlineSurvivesRestart)
+{
+    {
+        auto vh = open_host();
+        ASSERT_TRUE(vh->declare_queue("dq", true, false, false, {{MESSAGE_TTL_ARG, "40"}}));
+        for (const char* id : {"d0", "d1"}) {
+            auto bp = props(id, 0, DeliveryMode::DURABLE);
+            ASSERT_TRUE(vh->basic_publish("dq", &bp, "D"));
+        }
+    }
+
+    auto vh = open_host();
+    vh->wait_recovered();
+    ASSERT_TRUE(vh->queue_ready("dq"));
+    sleep_ms(50);
+    EXPECT_EQ(vh->expire_tick(), 2u);
+    EXPECT_FALSE(vh->basic_consume("dq"));
+}
+
+/* ---------- T6 延迟投递：到期前不入队，到期时按当时的绑定路由并回调 ---------- */
+TEST_F(TtlFixture, DelayedPublishRoutedWhenDue)
+{
+    auto vh = open_host();
+    std::vector<std::string> ready;
+    vh->set_ready_callback([&](const std::string& q) { ready.push_back(q); });
+    ASSERT_TRUE(vh->declare_exchange("retry", ExchangeType::DIRECT, false, false, {}));
+    ASSERT_TRUE(vh->declare_queue("work", false, false, false, {}));
+
+    auto bp = props("later", 0);
+    bp.set_routing_key("job");
+    ASSERT_TRUE(vh->publish_ex("retry", "job", &bp, "payload", 40));
+    EXPECT_EQ(vh->delayed_count(), 1u);
+    ASSERT_TRUE(vh->bind("retry", "work", "job"));        // 暂存之后才建立的绑定同样生效
+
+    EXPECT_EQ(vh->expire_tick(), 0u);
+    EXPECT_FALSE(vh->basic_consume("work"));
+    sleep_ms(50);
+    EXPECT_EQ(vh->expire_tick(), 1u);
+    EXPECT_EQ(vh->delayed_count(), 0u);
+    ASSERT_EQ(ready, std::vector<std::string>{"work"});
+
+    auto m = vh->basic_consume("work");
+    ASSERT_TRUE(m);
+    EXPECT_EQ(m->payload().properties().id(), "later");
+    EXPECT_EQ(m->payload().body(), "payload");
+    EXPECT_EQ(m->payload().properties().deliver_at(), 0);
+    EXPECT_TRUE(m->payload().properties().delay_exchange().empty());
+}
+
+/* ---------- T7 持久化的延迟消息：暂存随重启恢复，到期只投递一次 ---------- */
+TEST_F(TtlFixture, DurableDelayedSurvivesRestart)
+{
+    {
+        auto vh = open_host();
+        ASSERT_TRUE(vh->declare_queue("dw", true, false, false, {}));
+        auto bp = props("d", 0, DeliveryMode::DURABLE);
+        ASSERT_TRUE(vh->publish_ex("", "dw", &bp, "D", 40));
+        auto transient = props("t", 0);
+        ASSERT_TRUE(vh->publish_ex("", "dw", &transient, "T", 40));
+        EXPECT_EQ(vh->delayed_count(), 2u);
+    }
+    {
+        auto vh = open_host();
+        vh->wait_recovered();
+        EXPECT_EQ(vh->delayed_count(), 1u);                   // 非持久的暂存随进程消失
+        EXPECT_FALSE(vh->basic_consume("dw"));
+        sleep_ms(50);
+        EXPECT_EQ(vh->expire_tick(), 1u);
+    }
+
+    auto vh = open_host();
+    vh->wait_recovered();
+    EXPECT_EQ(vh->delayed_count(), 0u);
+    auto m = vh->basic_consume("dw");
+    ASSERT_TRUE(m);
+    EXPECT_EQ(m->payload().properties().id(), "d");
+    EXPECT_FALSE(vh->basic_consume("dw"));
+}
+
+/* ---------- T8 时间轮取消：取消的定时器不再交出，旧句柄在节点复用后失效 ---------- */
+TEST(TimerWheel, CancelRemovesTimer)
+{
+    const int64_t start = 1000000;
+    timer_wheel tw(timer_wheel::options{std::chrono::milliseconds(1)}, start);
+
+    std::vector<timer_wheel::handle> handles;
+    for (uint64_t i = 0; i < 1000; ++i)                      // 跨第 0~2 层，另有已到期的
+        handles.push_back(tw.schedule({}, msg_pos{0, i}, start - 1 + static_cast<int64_t>(i * 97)));
+    for (uint64_t i = 0; i < handles.size(); i += 2) tw.cancel(handles[i]);
+    EXPECT_EQ(tw.pending(), 500u);
+    tw.cancel(handles[0]);                                   // 重复取消：忽略
+    EXPECT_EQ(tw.pending(), 500u);
+
+    auto reused = tw.schedule({}, msg_pos{0, 5000}, start + 10);   // 复用刚归还的节点
+    tw.cancel(handles[2]);                                   // 旧句柄不能误删新定时器
+    EXPECT_EQ(tw.pending(), 501u);
+    tw.cancel(reused);
+
+    std::vector<uint64_t> fired;
+    for (const auto& t : tw.advance(start + 1000 * 97)) fired.push_back(t.pos.seq);
+    ASSERT_EQ(fired.size(), 500u);
+    for (size_t i = 0; i < fired.size(); ++i) EXPECT_EQ(fired[i], 2 * i + 1);   // 按截止时间先后
+    EXPECT_EQ(tw.pending(), 0u);
+    tw.cancel(handles[1]);                                   // 已交出的句柄：忽略
+    EXPECT_EQ(tw.pending(), 0u);
+}
+
+/* ---------- T9 长 TTL 的消息被消费 / 确认 / 删除后不再占着时间轮 ---------- */
+TEST_F(TtlFixture, ConsumedMessagesReleaseTimers)
+{
+    auto tw = std::make_shared<timer_wheel>();
+    auto qm = std::make_shared<queue_message>(dir, "long", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                                              queue_message::args{{MESSAGE_TTL_ARG, "3600000"}}, tw);
+    for (int i = 0; i < 300; ++i) {
+        auto bp = props("m" + std::to_string(i));
+        ASSERT_TRUE(qm->insert(&bp, "x", false));
+    }
+    EXPECT_EQ(tw->pending(), 300u);
+
+    for (int i = 0; i < 100; ++i) ASSERT_TRUE(qm->pop_front());     // 自动确认
+    EXPECT_EQ(tw->pending(), 200u);
+
+    uint64_t inflight = 0;                                   // 投递后不过期；退回重新登记
+    ASSERT_TRUE(qm->deliver(inflight));
+    EXPECT_EQ(tw->pending(), 199u);
+    ASSERT_TRUE(qm->requeue(inflight));
+    EXPECT_EQ(tw->pending(), 200u);
+    ASSERT_TRUE(qm->deliver(inflight));
+    ASSERT_TRUE(qm->ack(inflight));
+    EXPECT_EQ(tw->pending(), 199u);
+
+    qm->remove("m150");                                      // 按 id 删除
+    EXPECT_EQ(tw->pending(), 198u);
+    qm->destroy();
+    EXPECT_EQ(tw->pending(), 0u);
+}
+
+/* ---------- T10 推迟的到期项仍登记在槽位里：消息离开时定时器随之取消 ---------- */
+TEST_F(TtlFixture, DeferredTimerReleasedWithMessage)
+{
+    auto tw = std::make_shared<timer_wheel>();
+    auto qm = std::make_shared<queue_message>(dir, "later", nullptr, segment_log::DEFAULT_SEGMENT_BYTES,
+                                              queue_message::args{{MESSAGE_TTL_ARG, "10"}}, tw);
+    auto bp = props("m");
+    ASSERT_TRUE(qm->insert(&bp, "x", false));
+    sleep_ms(20);
+
+    int64_t now = timer_wheel::now();
+    std::vector<msg_pos> due;
+    for (const auto& t : tw->advance(now)) due.push_back(t.pos);
+    ASSERT_EQ(due.size(), 1u);
+    EXPECT_EQ(tw->pending(), 0u);
+
+    qm->defer(due, now, now + 3600000);
+    qm->defer(due, now, now + 3600000);                     // 重复推迟不会留下旧定时器
+    EXPECT_EQ(tw->pending(), 1u);
+    qm->remove("m");
+    EXPECT_EQ(tw->pending(), 0u);
+}